@@ -10,6 +10,7 @@
 #include "net/cookie_monster_delegate_qt.h"
 
 #include <QByteArray>
+#include <QMetaObject>
 #include <QUrl>
 
 namespace {
@@ -19,6 +20,11 @@ inline GURL toGurl(const QUrl &url)
     return GURL(url.toString().toStdString());
 }
 
+inline QByteArray cookieKey(const QNetworkCookie &cookie)
+{
+    return cookie.name() + ';' + cookie.domain().toUtf8() + ';' + cookie.path().toUtf8();
+}
+
 } // namespace
 
 QT_BEGIN_NAMESPACE
@@ -30,6 +36,8 @@ QWebEngineCookieStorePrivate::QWebEngineCookieStorePrivate(QWebEngineCookieStore
     , m_deleteSessionCookiesPending(false)
     , m_deleteAllCookiesPending(false)
     , m_getAllCookiesPending(false)
+    , m_batchChanges(false)
+    , m_batchFlushPending(false)
     , delegate(nullptr)
 {}
 
@@ -56,6 +64,10 @@ void QWebEngineCookieStorePrivate::processPendingUserCookies()
     if (bool(filterCallback))
         delegate->setHasFilter(true);
 
+    for (const CookieQueryData &queryData : std::as_const(m_pendingQueries))
+        delegate->getCookies(queryData.query, queryData.callback);
+    m_pendingQueries.clear();
+
     if (m_pendingUserCookies.isEmpty())
         return;
 
@@ -75,6 +87,11 @@ void QWebEngineCookieStorePrivate::rejectPendingUserCookies()
     m_deleteAllCookiesPending = false;
     m_deleteSessionCookiesPending = false;
     m_pendingUserCookies.clear();
+    for (const CookieQueryData &queryData : std::as_const(m_pendingQueries)) {
+        if (queryData.callback)
+            queryData.callback({});
+    }
+    m_pendingQueries.clear();
 }
 
 void QWebEngineCookieStorePrivate::setCookie(const QNetworkCookie &cookie, const QUrl &origin)
@@ -97,6 +114,41 @@ void QWebEngineCookieStorePrivate::deleteCookie(const QNetworkCookie &cookie, co
     delegate->deleteCookie(cookie, url);
 }
 
+void QWebEngineCookieStorePrivate::setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin)
+{
+    if (!delegate || !delegate->hasCookieMonster()) {
+        m_pendingUserCookies.reserve(m_pendingUserCookies.size() + cookies.size());
+        for (const QNetworkCookie &cookie : cookies)
+            m_pendingUserCookies.append(CookieData{ false, cookie, origin });
+        return;
+    }
+
+    delegate->setCookies(cookies, origin);
+}
+
+void QWebEngineCookieStorePrivate::deleteCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin)
+{
+    if (!delegate || !delegate->hasCookieMonster()) {
+        m_pendingUserCookies.reserve(m_pendingUserCookies.size() + cookies.size());
+        for (const QNetworkCookie &cookie : cookies)
+            m_pendingUserCookies.append(CookieData{ true, cookie, origin });
+        return;
+    }
+
+    delegate->deleteCookies(cookies, origin);
+}
+
+void QWebEngineCookieStorePrivate::getCookies(const QWebEngineCookieStore::CookieQuery &query,
+                                              const std::function<void(const QList<QNetworkCookie> &)> &callback)
+{
+    if (!delegate || !delegate->hasCookieMonster()) {
+        m_pendingQueries.append(CookieQueryData{ query, callback });
+        return;
+    }
+
+    delegate->getCookies(query, callback);
+}
+
 void QWebEngineCookieStorePrivate::deleteSessionCookies()
 {
     if (!delegate || !delegate->hasCookieMonster()) {
@@ -131,10 +183,40 @@ void QWebEngineCookieStorePrivate::getAllCookies()
 
 void QWebEngineCookieStorePrivate::onCookieChanged(const QNetworkCookie &cookie, bool removed)
 {
-    if (removed)
-        Q_EMIT q_ptr->cookieRemoved(cookie);
-    else
-        Q_EMIT q_ptr->cookieAdded(cookie);
+    if (!m_batchChanges) {
+        if (removed)
+            Q_EMIT q_ptr->cookieRemoved(cookie);
+        else
+            Q_EMIT q_ptr->cookieAdded(cookie);
+        return;
+    }
+
+    // Removals are reported before additions, so a cookie that is added and then removed
+    // within one batch must not be reported as added.
+    const QByteArray key = cookieKey(cookie);
+    if (removed) {
+        m_batchedAdded.remove(key);
+        m_batchedRemoved.append(cookie);
+    } else {
+        m_batchedAdded.insert(key, cookie);
+    }
+
+    if (!m_batchFlushPending) {
+        m_batchFlushPending = true;
+        QMetaObject::invokeMethod(q_ptr, [this]() { flushBatchedChanges(); }, Qt::QueuedConnection);
+    }
+}
+
+void QWebEngineCookieStorePrivate::flushBatchedChanges()
+{
+    m_batchFlushPending = false;
+    if (m_batchedAdded.isEmpty() && m_batchedRemoved.isEmpty())
+        return;
+
+    const QList<QNetworkCookie> added = m_batchedAdded.values();
+    const QList<QNetworkCookie> removed = std::exchange(m_batchedRemoved, {});
+    m_batchedAdded.clear();
+    Q_EMIT q_ptr->cookiesChanged(added, removed);
 }
 
 bool QWebEngineCookieStorePrivate::canAccessCookies(const QUrl &firstPartyUrl, const QUrl &url) const
@@ -182,6 +264,17 @@ bool QWebEngineCookieStorePrivate::canAccessCookies(const QUrl &firstPartyUrl, c
     This signal is emitted whenever a \a cookie is deleted from the cookie store.
 */
 
+/*!
+    \fn void QWebEngineCookieStore::cookiesChanged(const QList<QNetworkCookie> &added, const QList<QNetworkCookie> &removed)
+    \since 6.10
+
+    This signal is emitted once per event loop iteration with all cookies that were \a added to
+    or \a removed from the cookie store since the previous emission, if batched change
+    notifications are enabled. Removals should be applied before additions.
+
+    \sa setBatchedChangeNotificationsEnabled()
+*/
+
 /*!
     Creates a new QWebEngineCookieStore object with \a parent.
 */
@@ -244,6 +337,95 @@ void QWebEngineCookieStore::loadAllCookies()
     d_ptr->getAllCookies();
 }
 
+/*!
+    \since 6.10
+
+    Adds all \a cookies to the cookie store. This is equivalent to calling setCookie() for each
+    of the cookies with the same \a origin, but hands them to the network service in one go.
+
+    \note This operation is asynchronous.
+    \sa setCookie(), deleteCookies()
+*/
+
+void QWebEngineCookieStore::setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin)
+{
+    if (cookies.isEmpty())
+        return;
+    d_ptr->setCookies(cookies, origin);
+}
+
+/*!
+    \since 6.10
+
+    Deletes all \a cookies from the cookie store. This is equivalent to calling deleteCookie()
+    for each of the cookies with the same \a origin, but hands them to the network service
+    in one go.
+
+    \note This operation is asynchronous.
+    \sa deleteCookie(), setCookies()
+*/
+
+void QWebEngineCookieStore::deleteCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin)
+{
+    if (cookies.isEmpty())
+        return;
+    d_ptr->deleteCookies(cookies, origin);
+}
+
+/*!
+    \since 6.10
+
+    Looks up the cookies matching \a query and passes them to \a resultCallback in a single call.
+    Unlike loadAllCookies(), no cookieAdded() signals are emitted.
+
+    Empty fields of \a query match every cookie. A domain matches cookies set for that domain or
+    any of its subdomains, with or without a leading dot.
+
+    \note This operation is asynchronous. If the cookie store is destroyed before the result
+    is available, \a resultCallback is called with an empty list.
+    \sa QWebEngineCookieStore::CookieQuery
+*/
+
+void QWebEngineCookieStore::loadCookies(const CookieQuery &query,
+                                        const std::function<void(const QList<QNetworkCookie> &)> &resultCallback)
+{
+    d_ptr->getCookies(query, resultCallback);
+}
+
+/*!
+    \since 6.10
+
+    Sets whether changes to the cookie store are reported in batches through cookiesChanged()
+    to \a enabled. While enabled, cookieAdded() and cookieRemoved() are not emitted.
+
+    This is useful when many cookies change at once, for example after loadAllCookies() or
+    setCookies(), to avoid emitting a signal per cookie.
+
+    The default is \c false.
+*/
+
+void QWebEngineCookieStore::setBatchedChangeNotificationsEnabled(bool enabled)
+{
+    if (d_ptr->m_batchChanges == enabled)
+        return;
+    d_ptr->m_batchChanges = enabled;
+    if (!enabled)
+        d_ptr->flushBatchedChanges();
+}
+
+/*!
+    \since 6.10
+
+    Returns whether changes to the cookie store are reported in batches.
+
+    \sa setBatchedChangeNotificationsEnabled()
+*/
+
+bool QWebEngineCookieStore::batchedChangeNotificationsEnabled() const
+{
+    return d_ptr->m_batchChanges;
+}
+
 /*!
     Deletes all the session cookies in the cookie store. Session cookies do not have an
     expiration date assigned to them.
@@ -374,6 +556,39 @@ void QWebEngineCookieStore::setCookieFilter(std::function<bool(const FilterReque
     \sa firstPartyUrl, origin
 */
 
+/*!
+    \class QWebEngineCookieStore::CookieQuery
+    \inmodule QtWebEngineCore
+    \since 6.10
+
+    \brief The QWebEngineCookieStore::CookieQuery struct describes which cookies
+    QWebEngineCookieStore::loadCookies() returns.
+
+    \sa QWebEngineCookieStore::loadCookies()
+*/
+
+/*!
+    \variable QWebEngineCookieStore::CookieQuery::domain
+    \brief The domain the cookies belong to, including its subdomains.
+
+    If empty, cookies of all domains match.
+*/
+
+/*!
+    \variable QWebEngineCookieStore::CookieQuery::name
+    \brief The exact name of the cookies.
+
+    If empty, cookies of any name match.
+*/
+
+/*!
+    \variable QWebEngineCookieStore::CookieQuery::expiresBefore
+    \brief The time before which the cookies expire.
+
+    If invalid, cookies match regardless of their expiration date. Session cookies never match
+    a valid expiration time.
+*/
+
 QT_END_NAMESPACE
 
 #include "moc_qwebenginecookiestore.cpp"
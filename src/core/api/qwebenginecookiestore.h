@@ -7,6 +7,8 @@
 
 #include <QtWebEngineCore/qtwebenginecoreglobal.h>
 
+#include <QtCore/qdatetime.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qurl.h>
@@ -35,6 +37,11 @@ public:
         bool _reservedFlag;
         ushort _reservedType;
     };
+    struct CookieQuery {
+        QString domain;
+        QByteArray name;
+        QDateTime expiresBefore;
+    };
     virtual ~QWebEngineCookieStore();
 
     void setCookieFilter(const std::function<bool(const FilterRequest &)> &filterCallback);
@@ -45,9 +52,18 @@ public:
     void deleteAllCookies();
     void loadAllCookies();
 
+    void setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin = QUrl());
+    void deleteCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin = QUrl());
+    void loadCookies(const CookieQuery &query,
+                     const std::function<void(const QList<QNetworkCookie> &)> &resultCallback);
+
+    void setBatchedChangeNotificationsEnabled(bool enabled);
+    bool batchedChangeNotificationsEnabled() const;
+
 Q_SIGNALS:
     void cookieAdded(const QNetworkCookie &cookie);
     void cookieRemoved(const QNetworkCookie &cookie);
+    void cookiesChanged(const QList<QNetworkCookie> &added, const QList<QNetworkCookie> &removed);
 
 private:
     explicit QWebEngineCookieStore(QObject *parent = nullptr);
@@ -20,6 +20,7 @@
 
 #include "qwebenginecookiestore.h"
 
+#include <QHash>
 #include <QList>
 #include <QNetworkCookie>
 #include <QUrl>
@@ -39,15 +40,27 @@ class Q_WEBENGINECORE_EXPORT QWebEngineCookieStorePrivate
         QUrl origin;
     };
     friend class QTypeInfo<CookieData>;
+    struct CookieQueryData {
+        QWebEngineCookieStore::CookieQuery query;
+        std::function<void(const QList<QNetworkCookie> &)> callback;
+    };
     QWebEngineCookieStore *q_ptr;
 
 public:
     std::function<bool(const QWebEngineCookieStore::FilterRequest &)> filterCallback;
     QList<CookieData> m_pendingUserCookies;
+    QList<CookieQueryData> m_pendingQueries;
     bool m_deleteSessionCookiesPending;
     bool m_deleteAllCookiesPending;
     bool m_getAllCookiesPending;
 
+    // Changes collected while batched notifications are enabled, flushed once per
+    // event loop iteration through cookiesChanged().
+    bool m_batchChanges;
+    bool m_batchFlushPending;
+    QHash<QByteArray, QNetworkCookie> m_batchedAdded;
+    QList<QNetworkCookie> m_batchedRemoved;
+
     QtWebEngineCore::CookieMonsterDelegateQt *delegate;
 
     QWebEngineCookieStorePrivate(QWebEngineCookieStore *q);
@@ -56,6 +69,10 @@ public:
     void rejectPendingUserCookies();
     void setCookie(const QNetworkCookie &cookie, const QUrl &origin);
     void deleteCookie(const QNetworkCookie &cookie, const QUrl &url);
+    void setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin);
+    void deleteCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin);
+    void getCookies(const QWebEngineCookieStore::CookieQuery &query,
+                    const std::function<void(const QList<QNetworkCookie> &)> &callback);
     void deleteSessionCookies();
     void deleteAllCookies();
     void getAllCookies();
@@ -63,6 +80,7 @@ public:
     bool canAccessCookies(const QUrl &firstPartyUrl, const QUrl &url) const;
 
     void onCookieChanged(const QNetworkCookie &cookie, bool removed);
+    void flushBatchedChanges();
 };
 
 Q_DECLARE_TYPEINFO(QWebEngineCookieStorePrivate::CookieData, Q_RELOCATABLE_TYPE);
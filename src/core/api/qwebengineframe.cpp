@@ -239,7 +239,7 @@ void QWebEngineFrame::printToPdf(const std::function<void(const QByteArray &)> &
     LOCK_ADAPTER(adapter, );
     std::function wrappedCallback = [callback](QSharedPointer<QByteArray> result) {
         if (callback)
-            callback(result ? *result : QByteArray());
+            callback(result ? QByteArray(result->constData(), result->size()) : QByteArray());
     };
     QPageLayout layout(QPageSize(QPageSize::A4), QPageLayout::Portrait, QMarginsF());
     adapter->adapterClient()->printToPdf(std::move(wrappedCallback), layout, QPageRanges(), m_id);
@@ -254,7 +254,8 @@ void QWebEngineFrame::printToPdf(const QJSValue &callback)
         wrappedCallback = [holdingObject, callback](QSharedPointer<QByteArray> result) {
             if (auto engine = qmlEngine(holdingObject)) {
                 QJSValueList args;
-                args.append(engine->toScriptValue(result ? *result : QByteArray()));
+                args.append(engine->toScriptValue(
+                        result ? QByteArray(result->constData(), result->size()) : QByteArray()));
                 callback.call(args);
             } else {
                 qWarning("No QML engine found to execute runJavaScript() callback");
@@ -0,0 +1,333 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+#include "qwebengineheadlessrenderer.h"
+#include "qwebengineheadlessrenderer_p.h"
+#include "qwebenginepage.h"
+#include "qwebenginepage_p.h"
+
+#include "render_widget_host_view_qt_delegate_headless.h"
+#include "web_contents_adapter.h"
+
+#include <QImage>
+#include <QRect>
+#if QT_CONFIG(sharedmemory)
+#include <QSharedMemory>
+#endif
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtWebEngineCore;
+
+#if QT_CONFIG(sharedmemory)
+static constexpr quint32 kRingMagic = 0x51574852; // "QWHR"
+static constexpr quint32 kRingVersion = 1;
+#endif
+
+QWebEngineHeadlessRendererPrivate::QWebEngineHeadlessRendererPrivate(QWebEngineHeadlessRenderer *q,
+                                                                     QWebEnginePage *page)
+    : q_ptr(q), page(page)
+{
+}
+
+QWebEngineHeadlessRendererPrivate::~QWebEngineHeadlessRendererPrivate()
+{
+    if (delegate)
+        delegate->setFrameCallback(nullptr);
+}
+
+void QWebEngineHeadlessRendererPrivate::attach(RenderWidgetHostViewQtDelegateHeadless *newDelegate)
+{
+    delegate = newDelegate;
+    delegate->setFrameCallback([this](const QImage &frame, const QRect &damageRect) {
+        deliverFrame(frame, damageRect);
+    });
+    delegate->setViewSize(size);
+    delegate->setFrameRate(frameRate);
+}
+
+void QWebEngineHeadlessRendererPrivate::deliverFrame(const QImage &frame, const QRect &damageRect)
+{
+    ++frameCount;
+#if QT_CONFIG(sharedmemory)
+    if (ring)
+        writeFrameToRing(frame, damageRect);
+#endif
+    if (frameCallback)
+        frameCallback(frame, damageRect);
+}
+
+#if QT_CONFIG(sharedmemory)
+void QWebEngineHeadlessRendererPrivate::writeFrameToRing(const QImage &frame, const QRect &damageRect)
+{
+    if (frame.width() > ringMaximumSize.width() || frame.height() > ringMaximumSize.height()) {
+        if (!warnedAboutRingSize) {
+            qWarning("QWebEngineHeadlessRenderer: Frames of %dx%d pixels do not fit into the "
+                     "shared memory ring and are skipped.", frame.width(), frame.height());
+            warnedAboutRingSize = true;
+        }
+        return;
+    }
+
+    using Header = QWebEngineHeadlessRenderer::SharedMemoryHeader;
+    using Frame = QWebEngineHeadlessRenderer::SharedMemoryFrame;
+    const qsizetype bytesPerLine = qsizetype(frame.width()) * 4;
+
+    ring->lock();
+    auto *data = static_cast<uchar *>(ring->data());
+    auto *header = reinterpret_cast<Header *>(data);
+    const quint64 frameNumber = header->frameCount + 1;
+    uchar *slot = data + sizeof(Header) + ((frameNumber - 1) % header->slotCount) * header->slotSize;
+    *reinterpret_cast<Frame *>(slot) = Frame{ frameNumber,
+                                              frame.width(),
+                                              frame.height(),
+                                              qint32(bytesPerLine),
+                                              qint32(frame.format()),
+                                              damageRect.x(),
+                                              damageRect.y(),
+                                              damageRect.width(),
+                                              damageRect.height() };
+    uchar *pixels = slot + sizeof(Frame);
+    for (int y = 0; y < frame.height(); ++y)
+        std::memcpy(pixels + y * bytesPerLine, frame.constScanLine(y), bytesPerLine);
+    header->frameCount = frameNumber;
+    ring->unlock();
+}
+#endif // QT_CONFIG(sharedmemory)
+
+/*!
+    \class QWebEngineHeadlessRenderer
+    \brief The QWebEngineHeadlessRenderer class renders a web engine page without a window.
+    \since 6.10
+
+    \inmodule QtWebEngineCore
+
+    A QWebEngineHeadlessRenderer takes over the rendering of a QWebEnginePage that is not
+    shown in a view. It takes the composited frames directly from the software compositor and
+    delivers them, together with the area that changed since the previous frame, to the
+    callback set with setFrameCallback() and, optionally, to a shared memory ring set up with
+    setSharedMemoryRing().
+
+    Frame production is paced by the renderer: with a positive frameRate, the page is asked
+    for at most that many frames per second, and with a frame rate of zero, the page only
+    renders when requestFrame() is called. A page only produces a frame when something changed,
+    so an idle page costs no rendering at all. This makes it possible to run many headless
+    pages in one process with predictable load.
+
+    The renderer has to be created before the page loads any content, and the page must not
+    be shown in a QWebEngineView. Frames are only delivered with software compositing, for
+    example when running with the \c{--disable-gpu} Chromium flag.
+
+    \code
+    QWebEnginePage page;
+    QWebEngineHeadlessRenderer renderer(&page);
+    renderer.setSize(QSize(1280, 720));
+    renderer.setFrameRate(10);
+    renderer.setFrameCallback([](const QImage &frame, const QRect &damageRect) {
+        encoder.addFrame(frame, damageRect);
+    });
+    page.load(QUrl("https://www.qt.io"));
+    \endcode
+*/
+
+/*!
+    \class QWebEngineHeadlessRenderer::SharedMemoryHeader
+    \inmodule QtWebEngineCore
+    \brief The header at the start of the shared memory ring.
+
+    \c magic is \c 0x51574852 and \c version is \c 1. The header is followed by \c slotCount
+    slots of \c slotSize bytes each. \c frameCount is the number of frames written so far;
+    frame number \c n is stored in slot \c{(n - 1) % slotCount}.
+
+    \sa QWebEngineHeadlessRenderer::setSharedMemoryRing()
+*/
+
+/*!
+    \class QWebEngineHeadlessRenderer::SharedMemoryFrame
+    \inmodule QtWebEngineCore
+    \brief The header at the start of every slot of the shared memory ring.
+
+    It describes the pixels following it: an image with the QImage::Format \c format, and the
+    given \c width, \c height and \c bytesPerLine. \c frameNumber matches the ring's frame
+    count after the frame was written, and the damage rectangle is the part of the image that
+    changed compared to the previous frame.
+
+    \sa QWebEngineHeadlessRenderer::setSharedMemoryRing()
+*/
+
+/*!
+    Constructs a headless renderer for \a page, which becomes its parent.
+*/
+QWebEngineHeadlessRenderer::QWebEngineHeadlessRenderer(QWebEnginePage *page)
+    : QObject(page), d_ptr(new QWebEngineHeadlessRendererPrivate(this, page))
+{
+    Q_ASSERT(page);
+    QWebEnginePagePrivate *pageD = page->d_func();
+    if (pageD->view)
+        qWarning("QWebEngineHeadlessRenderer: The page is already shown in a view.");
+    if (pageD->adapter->isInitialized())
+        qWarning("QWebEngineHeadlessRenderer: The page has already been loaded, frames may not "
+                 "be delivered until it navigates to another site.");
+    pageD->headlessRenderer = this;
+    page->setVisible(true);
+}
+
+/*!
+    Destroys the renderer. The page it rendered stops producing frames.
+*/
+QWebEngineHeadlessRenderer::~QWebEngineHeadlessRenderer()
+{
+    Q_D(QWebEngineHeadlessRenderer);
+    if (d->page && d->page->d_func()->headlessRenderer == this)
+        d->page->d_func()->headlessRenderer = nullptr;
+}
+
+/*!
+    Returns the page rendered by this renderer.
+*/
+QWebEnginePage *QWebEngineHeadlessRenderer::page() const
+{
+    Q_D(const QWebEngineHeadlessRenderer);
+    return d->page;
+}
+
+/*!
+    \property QWebEngineHeadlessRenderer::size
+    \brief The size of the page's viewport in device-independent pixels.
+
+    The default is 800x600.
+*/
+QSize QWebEngineHeadlessRenderer::size() const
+{
+    Q_D(const QWebEngineHeadlessRenderer);
+    return d->size;
+}
+
+void QWebEngineHeadlessRenderer::setSize(const QSize &size)
+{
+    Q_D(QWebEngineHeadlessRenderer);
+    if (d->size == size)
+        return;
+    d->size = size;
+    if (d->delegate)
+        d->delegate->setViewSize(size);
+    Q_EMIT sizeChanged(size);
+}
+
+/*!
+    \property QWebEngineHeadlessRenderer::frameRate
+    \brief The maximum number of frames per second produced by the page.
+
+    When set to zero, frames are only produced when requestFrame() is called. The default
+    is 60.
+*/
+qreal QWebEngineHeadlessRenderer::frameRate() const
+{
+    Q_D(const QWebEngineHeadlessRenderer);
+    return d->frameRate;
+}
+
+void QWebEngineHeadlessRenderer::setFrameRate(qreal frameRate)
+{
+    Q_D(QWebEngineHeadlessRenderer);
+    frameRate = qMax(frameRate, qreal(0));
+    if (qFuzzyCompare(d->frameRate, frameRate))
+        return;
+    d->frameRate = frameRate;
+    if (d->delegate)
+        d->delegate->setFrameRate(frameRate);
+    Q_EMIT frameRateChanged(frameRate);
+}
+
+/*!
+    \property QWebEngineHeadlessRenderer::frameCount
+    \brief The number of frames delivered so far.
+*/
+quint64 QWebEngineHeadlessRenderer::frameCount() const
+{
+    Q_D(const QWebEngineHeadlessRenderer);
+    return d->frameCount;
+}
+
+/*!
+    Sets the \a callback called with every new frame of the page and the part of it that
+    changed since the previous frame. The first frame and frames after a resize are reported
+    as changed entirely.
+
+    The callback is called on the main thread. The image shares its data with the renderer,
+    so keeping a copy of it makes the next frame copy the whole image.
+*/
+void QWebEngineHeadlessRenderer::setFrameCallback(
+        const std::function<void(const QImage &, const QRect &)> &callback)
+{
+    Q_D(QWebEngineHeadlessRenderer);
+    d->frameCallback = callback;
+}
+
+#if QT_CONFIG(sharedmemory)
+/*!
+    Creates the shared memory segment named by \a key, as passed to
+    QSharedMemory::platformSafeKey(), and writes every frame to it in addition to the frame
+    callback. Returns \c false if the segment could not be created.
+
+    The segment holds a ring of \a slotCount frames of at most \a maximumSize pixels each;
+    larger frames are skipped. It starts with a SharedMemoryHeader, followed by the slots,
+    each of which starts with a SharedMemoryFrame describing the pixels after it. Frames are
+    written while holding the segment's lock, so readers should lock it as well while copying
+    a frame.
+
+    Passing an empty \a key removes the ring.
+*/
+bool QWebEngineHeadlessRenderer::setSharedMemoryRing(const QString &key, int slotCount,
+                                                     const QSize &maximumSize)
+{
+    Q_D(QWebEngineHeadlessRenderer);
+    d->ring.reset();
+    d->warnedAboutRingSize = false;
+    if (key.isEmpty())
+        return true;
+    if (slotCount <= 0 || maximumSize.isEmpty()) {
+        qWarning("QWebEngineHeadlessRenderer: Invalid shared memory ring dimensions.");
+        return false;
+    }
+
+    const qsizetype slotSize = sizeof(SharedMemoryFrame)
+            + qsizetype(maximumSize.width()) * maximumSize.height() * 4;
+    auto ring = std::make_unique<QSharedMemory>(QSharedMemory::platformSafeKey(key));
+    if (!ring->create(sizeof(SharedMemoryHeader) + slotCount * slotSize)) {
+        qWarning("QWebEngineHeadlessRenderer: Could not create the shared memory ring: %ls",
+                 qUtf16Printable(ring->errorString()));
+        return false;
+    }
+
+    ring->lock();
+    *static_cast<SharedMemoryHeader *>(ring->data()) =
+            SharedMemoryHeader{ kRingMagic, kRingVersion, quint32(slotCount), quint32(slotSize), 0 };
+    ring->unlock();
+
+    d->ring = std::move(ring);
+    d->ringMaximumSize = maximumSize;
+    return true;
+}
+#endif // QT_CONFIG(sharedmemory)
+
+/*!
+    Lets the page produce its next frame. With a frame rate of zero, this is the only way for
+    a page to render; otherwise it produces a frame ahead of the next regular one.
+
+    As the page and the compositor each need a step to render, a change in the page may
+    take more than one request to show up in a frame.
+*/
+void QWebEngineHeadlessRenderer::requestFrame()
+{
+    Q_D(QWebEngineHeadlessRenderer);
+    if (d->delegate)
+        d->delegate->requestFrame();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qwebengineheadlessrenderer.cpp"
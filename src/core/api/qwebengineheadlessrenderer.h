@@ -0,0 +1,88 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+#ifndef QWEBENGINEHEADLESSRENDERER_H
+#define QWEBENGINEHEADLESSRENDERER_H
+
+#include <QtWebEngineCore/qtwebenginecoreglobal.h>
+
+#include <QtCore/qobject.h>
+#include <QtCore/qsize.h>
+
+#include <functional>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QImage;
+class QRect;
+class QWebEngineHeadlessRendererPrivate;
+class QWebEnginePage;
+
+class Q_WEBENGINECORE_EXPORT QWebEngineHeadlessRenderer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QSize size READ size WRITE setSize NOTIFY sizeChanged FINAL)
+    Q_PROPERTY(qreal frameRate READ frameRate WRITE setFrameRate NOTIFY frameRateChanged FINAL)
+    Q_PROPERTY(quint64 frameCount READ frameCount FINAL)
+
+public:
+    explicit QWebEngineHeadlessRenderer(QWebEnginePage *page);
+    ~QWebEngineHeadlessRenderer() override;
+
+    QWebEnginePage *page() const;
+
+    QSize size() const;
+    void setSize(const QSize &size);
+
+    qreal frameRate() const;
+    void setFrameRate(qreal frameRate);
+
+    quint64 frameCount() const;
+
+    void setFrameCallback(
+            const std::function<void(const QImage &frame, const QRect &damageRect)> &callback);
+
+#if QT_CONFIG(sharedmemory)
+    struct SharedMemoryHeader
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 slotCount;
+        quint32 slotSize;
+        quint64 frameCount;
+    };
+
+    struct SharedMemoryFrame
+    {
+        quint64 frameNumber;
+        qint32 width;
+        qint32 height;
+        qint32 bytesPerLine;
+        qint32 format;
+        qint32 damageX;
+        qint32 damageY;
+        qint32 damageWidth;
+        qint32 damageHeight;
+    };
+
+    bool setSharedMemoryRing(const QString &key, int slotCount, const QSize &maximumSize);
+#endif
+
+public Q_SLOTS:
+    void requestFrame();
+
+Q_SIGNALS:
+    void sizeChanged(const QSize &size);
+    void frameRateChanged(qreal frameRate);
+
+private:
+    Q_DISABLE_COPY(QWebEngineHeadlessRenderer)
+    Q_DECLARE_PRIVATE(QWebEngineHeadlessRenderer)
+    std::unique_ptr<QWebEngineHeadlessRendererPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINEHEADLESSRENDERER_H
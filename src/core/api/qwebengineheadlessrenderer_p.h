@@ -0,0 +1,69 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+#ifndef QWEBENGINEHEADLESSRENDERER_P_H
+#define QWEBENGINEHEADLESSRENDERER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qtwebenginecoreglobal_p.h"
+#include "qwebengineheadlessrenderer.h"
+
+#include <QtCore/qpointer.h>
+
+namespace QtWebEngineCore {
+class RenderWidgetHostViewQtDelegateHeadless;
+}
+
+QT_BEGIN_NAMESPACE
+
+#if QT_CONFIG(sharedmemory)
+class QSharedMemory;
+#endif
+
+class QWebEngineHeadlessRendererPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QWebEngineHeadlessRenderer)
+
+    QWebEngineHeadlessRendererPrivate(QWebEngineHeadlessRenderer *q, QWebEnginePage *page);
+    ~QWebEngineHeadlessRendererPrivate();
+
+    static QWebEngineHeadlessRendererPrivate *get(QWebEngineHeadlessRenderer *q)
+    {
+        return q->d_func();
+    }
+
+    void attach(QtWebEngineCore::RenderWidgetHostViewQtDelegateHeadless *delegate);
+    void deliverFrame(const QImage &frame, const QRect &damageRect);
+#if QT_CONFIG(sharedmemory)
+    void writeFrameToRing(const QImage &frame, const QRect &damageRect);
+#endif
+
+    QWebEngineHeadlessRenderer *q_ptr;
+    QPointer<QWebEnginePage> page;
+    QPointer<QtWebEngineCore::RenderWidgetHostViewQtDelegateHeadless> delegate;
+    QSize size = QSize(800, 600);
+    qreal frameRate = 60;
+    quint64 frameCount = 0;
+    std::function<void(const QImage &, const QRect &)> frameCallback;
+#if QT_CONFIG(sharedmemory)
+    std::unique_ptr<QSharedMemory> ring;
+    QSize ringMaximumSize;
+    bool warnedAboutRingSize = false;
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINEHEADLESSRENDERER_P_H
@@ -111,6 +111,15 @@ QtWebEngineCore::WebContentsAdapter *QWebEngineHistoryPrivate::adapter() const
     return client->webContentsAdapter();
 }
 
+QtWebEngineCore::WebContentsAdapter *QWebEngineHistoryPrivate::navigableAdapter() const
+{
+    QtWebEngineCore::WebContentsAdapter *adapter = this->adapter();
+    // A lazily restored history can be read as it is, but only navigated once it is loaded.
+    if (adapter->hasPendingNavigationHistory())
+        adapter->loadDefault();
+    return adapter;
+}
+
 QWebEngineHistoryModelPrivate::QWebEngineHistoryModelPrivate(const QWebEngineHistoryPrivate *history)
     : history(history)
 {
@@ -160,7 +169,7 @@ int QWebEngineBackHistoryModelPrivate::offsetForIndex(int index) const
 
 int QWebEngineForwardHistoryModelPrivate::count() const
 {
-    if (!adapter()->isInitialized())
+    if (!adapter()->isInitialized() && !adapter()->hasPendingNavigationHistory())
         return 0;
     return adapter()->navigationEntryCount() - adapter()->currentNavigationEntryIndex() - 1;
 }
@@ -246,7 +255,7 @@ QWebEngineHistory::~QWebEngineHistory() { }
 void QWebEngineHistory::clear()
 {
     Q_D(const QWebEngineHistory);
-    d->adapter()->clearNavigationHistory();
+    d->navigableAdapter()->clearNavigationHistory();
     d->client->updateNavigationActions();
     reset();
 }
@@ -291,20 +300,20 @@ bool QWebEngineHistory::canGoForward() const
 void QWebEngineHistory::back()
 {
     Q_D(const QWebEngineHistory);
-    d->adapter()->navigateToOffset(-1);
+    d->navigableAdapter()->navigateToOffset(-1);
 }
 
 void QWebEngineHistory::forward()
 {
     Q_D(const QWebEngineHistory);
-    d->adapter()->navigateToOffset(1);
+    d->navigableAdapter()->navigateToOffset(1);
 }
 
 void QWebEngineHistory::goToItem(const QWebEngineHistoryItem &item)
 {
     Q_D(const QWebEngineHistory);
     Q_ASSERT(item.d->client == d->client);
-    d->adapter()->navigateToIndex(item.d->index);
+    d->navigableAdapter()->navigateToIndex(item.d->index);
 }
 
 QWebEngineHistoryItem QWebEngineHistory::backItem() const
@@ -345,7 +354,7 @@ int QWebEngineHistory::currentItemIndex() const
 int QWebEngineHistory::count() const
 {
     Q_D(const QWebEngineHistory);
-    if (!d->adapter()->isInitialized())
+    if (!d->adapter()->isInitialized() && !d->adapter()->hasPendingNavigationHistory())
         return 0;
     return d->adapter()->navigationEntryCount();
 }
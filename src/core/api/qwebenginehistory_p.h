@@ -83,6 +83,7 @@ public:
 
     void updateItems() const;
     QtWebEngineCore::WebContentsAdapter *adapter() const;
+    QtWebEngineCore::WebContentsAdapter *navigableAdapter() const;
 
     QtWebEngineCore::WebContentsAdapterClient *client;
 
@@ -11,6 +11,7 @@
 #include "qwebenginefilesystemaccessrequest.h"
 #include "qwebenginefindtextresult.h"
 #include "qwebenginefullscreenrequest.h"
+#include "qwebengineheadlessrenderer_p.h"
 #include "qwebenginehistory.h"
 #include "qwebenginehistory_p.h"
 #include "qwebenginehttprequest.h"
@@ -32,11 +33,13 @@
 #include "color_chooser_controller.h"
 #include "find_text_helper.h"
 #include "file_picker_controller.h"
+#include "isolated_world_ids_qt.h"
 #include "javascript_dialog_controller.h"
 #include "profile_adapter.h"
 #include "render_view_context_menu_qt.h"
 #include "render_widget_host_view_qt_delegate.h"
 #include "render_widget_host_view_qt_delegate_client.h"
+#include "render_widget_host_view_qt_delegate_headless.h"
 #include "render_widget_host_view_qt_delegate_item.h"
 #include "touch_selection_menu_controller.h"
 #include "web_contents_adapter.h"
@@ -47,11 +50,14 @@
 #include <QClipboard>
 #include <QKeyEvent>
 #include <QIcon>
+#include <QJsonArray>
+#include <QJsonDocument>
 
 #include <QLoggingCategory>
 #include <QMimeData>
 #include <QtCore/QPointer>
 #include <QRect>
+#include <QRectF>
 #include <QTimer>
 #include <QUrl>
 #include <QVariant>
@@ -138,6 +144,11 @@ RenderWidgetHostViewQtDelegate *QWebEnginePagePrivate::CreateRenderWidgetHostVie
 {
     if (view)
         return view->CreateRenderWidgetHostViewQtDelegate(client);
+    if (headlessRenderer) {
+        auto *delegate = new QtWebEngineCore::RenderWidgetHostViewQtDelegateHeadless(client);
+        QWebEngineHeadlessRendererPrivate::get(headlessRenderer)->attach(delegate);
+        return delegate;
+    }
     delegateItem = new QtWebEngineCore::RenderWidgetHostViewQtDelegateItem(client, false);
     return delegateItem;
 }
@@ -156,6 +167,11 @@ RenderWidgetHostViewQtDelegate *QWebEnginePagePrivate::CreateRenderWidgetHostVie
          : new QtWebEngineCore::RenderWidgetHostViewQtDelegateItem(client, true);
 }
 
+bool QWebEnginePagePrivate::usesExternalBeginFrames() const
+{
+    return !view && headlessRenderer;
+}
+
 void QWebEnginePagePrivate::initializationFinished()
 {
     if (m_backgroundColor != Qt::white)
@@ -170,6 +186,8 @@ void QWebEnginePagePrivate::initializationFinished()
         adapter->setZoomFactor(defaultZoomFactor);
     if (view)
         adapter->setVisible(view->isVisible());
+    else if (headlessRenderer)
+        adapter->setVisible(true);
 
     scriptCollection.d->initializationFinished(adapter);
 
@@ -299,6 +317,13 @@ void QWebEnginePagePrivate::didPrintPageToPdf(const QString &filePath, bool succ
         view->didPrintPageToPdf(filePath, success);
 }
 
+void QWebEnginePagePrivate::didPrintPageToPdfProgress(const QString &filePath, qint64 bytesWritten,
+                                                      qint64 bytesTotal)
+{
+    Q_Q(QWebEnginePage);
+    Q_EMIT q->pdfPrintingProgress(filePath, bytesWritten, bytesTotal);
+}
+
 void QWebEnginePagePrivate::focusContainer()
 {
     if (view) {
@@ -750,13 +775,20 @@ void QWebEnginePagePrivate::_q_webActionTriggered(bool checked)
 }
 #endif // QT_CONFIG(action)
 
-void QWebEnginePagePrivate::recreateFromSerializedHistory(QDataStream &input)
+void QWebEnginePagePrivate::recreateFromSerializedHistory(QDataStream &input, bool deferLoad)
 {
     QSharedPointer<WebContentsAdapter> newWebContents = WebContentsAdapter::createFromSerializedNavigationHistory(input, this);
     if (newWebContents) {
         adapter = std::move(newWebContents);
         adapter->setClient(this);
-        adapter->loadDefault();
+        // With deferLoad, the entries of the history are only restored once the page is shown
+        // or used.
+        if (!deferLoad || !adapter->hasPendingNavigationHistory() || (view && view->isVisible())) {
+            adapter->loadDefault();
+        } else {
+            urlChanged();
+            titleChanged(adapter->pageTitle());
+        }
     }
 }
 
@@ -1527,6 +1559,114 @@ void QWebEnginePage::findText(const QString &subString, FindFlags options, const
     d->adapter->findTextHelper()->startFinding(subString, options & FindCaseSensitively, options & FindBackward, resultCallback);
 }
 
+// The match index of findTextMatchRects() and its mutation observer live in a world of their
+// own (kFindMatchRectsWorldId), so they neither show up in nor depend on scripts of the application.
+
+// Collects the document rectangles of all matches in a frame. The text nodes holding matches
+// are kept, so a search for a longer string only rescans those nodes until the document changes.
+static const char kFindMatchRectsScript[] = R"JS(
+(function(query, caseSensitive) {
+    const key = Symbol.for('qtWebEngineFindIndex');
+    let index = window[key];
+    if (!index) {
+        index = window[key] = { query: '', caseSensitive: false, nodes: null };
+        new MutationObserver(() => { index.nodes = null; })
+                .observe(document, { subtree: true, childList: true, characterData: true });
+    }
+    const fold = (text) => caseSensitive ? text : text.toLowerCase();
+    const needle = fold(query);
+    let candidates = index.nodes;
+    if (!candidates || index.caseSensitive !== caseSensitive || !needle.startsWith(index.query)) {
+        candidates = [];
+        const root = document.body || document.documentElement;
+        const walker = root ? document.createTreeWalker(root, NodeFilter.SHOW_TEXT) : null;
+        for (let node = walker && walker.nextNode(); node; node = walker.nextNode()) {
+            const parent = node.parentElement;
+            if (!parent || !parent.closest('script, style, noscript, template'))
+                candidates.push(node);
+        }
+    }
+    const nodes = [];
+    const rects = [];
+    const range = document.createRange();
+    for (const node of candidates) {
+        if (!node.isConnected)
+            continue;
+        const text = fold(node.data);
+        let found = false;
+        for (let pos = text.indexOf(needle); pos >= 0; pos = text.indexOf(needle, pos + needle.length)) {
+            found = true;
+            range.setStart(node, pos);
+            range.setEnd(node, pos + needle.length);
+            const rect = range.getBoundingClientRect();
+            if (rect.width > 0 || rect.height > 0)
+                rects.push([rect.left + window.scrollX, rect.top + window.scrollY, rect.width, rect.height]);
+        }
+        if (found)
+            nodes.push(node);
+    }
+    index.query = needle;
+    index.caseSensitive = caseSensitive;
+    index.nodes = nodes;
+    return rects;
+})
+)JS";
+
+/*!
+    \since 6.10
+
+    Finds all occurrences of \a subString in every frame of the page, using the given
+    \a options, and calls \a resultCallback once with the rectangles of the matches, grouped
+    per frame in document order. The rectangles are in CSS pixels relative to the top-left
+    corner of the frame's document, which makes them suitable for placing tick marks along
+    the frame's scroll bar. FindBackward has no effect.
+
+    Unlike findText(), this neither highlights nor selects the matches. Each frame keeps the
+    nodes that matched its last search, so when \a subString extends the previous search
+    string, for example while the user is typing, only those nodes are examined again. Matches
+    that span several text nodes are not included.
+
+    \sa findText(), runJavaScriptInFrames()
+*/
+void QWebEnginePage::findTextMatchRects(
+        const QString &subString, FindFlags options,
+        const std::function<void(const QList<QPair<QWebEngineFrame, QList<QRectF>>> &)>
+                &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    if (subString.isEmpty() || !d->adapter->isInitialized()) {
+        if (resultCallback)
+            resultCallback({});
+        return;
+    }
+
+    const QJsonArray arguments{ subString, bool(options & FindCaseSensitively) };
+    const QString script = QLatin1StringView(kFindMatchRectsScript) + u".apply(null, "_s
+            + QString::fromUtf8(QJsonDocument(arguments).toJson(QJsonDocument::Compact)) + u')';
+
+    runJavaScriptInFrames(
+            script, kFindMatchRectsWorldId, std::chrono::milliseconds::zero(), {},
+            [resultCallback](const QList<QPair<QWebEngineFrame, QVariant>> &results) {
+                if (!resultCallback)
+                    return;
+                QList<QPair<QWebEngineFrame, QList<QRectF>>> frameRects;
+                frameRects.reserve(results.size());
+                for (const auto &result : results) {
+                    QList<QRectF> rects;
+                    const QVariantList values = result.second.toList();
+                    rects.reserve(values.size());
+                    for (const QVariant &value : values) {
+                        const QVariantList rect = value.toList();
+                        if (rect.size() == 4)
+                            rects.append(QRectF(rect[0].toReal(), rect[1].toReal(),
+                                                rect[2].toReal(), rect[3].toReal()));
+                    }
+                    frameRects.append({ result.first, rects });
+                }
+                resultCallback(frameRects);
+            });
+}
+
 /*!
  * \reimp
  */
@@ -2101,6 +2241,76 @@ void QWebEnginePage::smoothScrollBy(int dx, int dy, double factor, int posX, int
     d->adapter->smoothScrollBy(dx, dy, factor, posX, posY);
 }
 
+QVariantMap QWebEnginePage::smoothScrollMetrics() const
+{
+    Q_D(const QWebEnginePage);
+    if (!d->adapter)
+        return QVariantMap();
+    return d->adapter->smoothScrollMetrics();
+}
+
+/*!
+    \since 6.10
+
+    Returns histograms of the latency of the input events of the page's view, by kind of event.
+
+    The map has an entry for each of \c mouse, \c wheel, \c keyboard and \c touch events,
+    which in turn maps the stages of handling an event to a histogram of the time from the
+    arrival of the event to the end of that stage: \c dispatch to the renderer, the
+    renderer's acknowledgement as \c rendererAck, and the \c presentation of the first frame
+    swapped after it. Each histogram has a \c count, \c meanMs, \c maxMs and the \c buckets
+    with the number of events up to each of the limits in \c bucketLimitsMs, with an additional
+    last bucket for anything above. \c dropped counts the events that were not
+    acknowledged by the renderer within two seconds, for example because they were coalesced
+    with later ones or did not result in any web event, and the events that were discarded
+    because too many of one kind were waiting at the same time.
+
+    When Chromium tracing is active with the \c input category, every event is also reported
+    as a nested async trace event named \c QtWebEngine::InputLatency.
+
+    \sa resetInputLatencyStatistics()
+*/
+QVariantMap QWebEnginePage::inputLatencyStatistics() const
+{
+    Q_D(const QWebEnginePage);
+    if (!d->adapter)
+        return QVariantMap();
+    return d->adapter->inputLatencyStatistics();
+}
+
+/*!
+    \since 6.10
+
+    Clears the histograms returned by inputLatencyStatistics().
+*/
+void QWebEnginePage::resetInputLatencyStatistics()
+{
+    Q_D(QWebEnginePage);
+    if (d->adapter)
+        d->adapter->resetInputLatencyStatistics();
+}
+
+/*!
+    \since 6.10
+
+    Returns counters of the input resampling of the page's view, enabled with
+    QWebEngineSettings::InputResamplingEnabled.
+
+    The map has an entry for each of \c mouse, \c wheel and \c touch input, holding the
+    number of events \c received while resampling, the number of events \c delivered to the
+    renderer, how many of the received events were \c coalesced into a pending one, how
+    many of the delivered events had their position \c predicted, and how many predictions
+    were \c corrected by delivering the real position again. Corrections are not counted as
+    delivered events.
+*/
+QVariantMap QWebEnginePage::inputResamplingStatistics() const
+{
+    Q_D(const QWebEnginePage);
+    if (!d->adapter)
+        return QVariantMap();
+    return d->adapter->inputResamplingStatistics();
+}
+
 /*!
     Returns the collection of scripts that are injected into the page.
 
@@ -2335,6 +2545,19 @@ QSizeF QWebEnginePage::contentsSize() const
     \sa printToPdf()
 */
 
+/*!
+    \fn void QWebEnginePage::pdfPrintingProgress(const QString &filePath, qint64 bytesWritten, qint64 bytesTotal)
+    \since 6.10
+
+    This signal is emitted while the PDF document generated by printToPdf() is being written to
+    \a filePath. \a bytesWritten is the amount of data written so far out of \a bytesTotal.
+
+    The progress covers saving the document only. The document is generated completely
+    before the first block is written.
+
+    \sa pdfPrintingFinished()
+*/
+
 /*!
     Renders the current content of the page into a PDF document and saves it
     in the location specified in \a filePath.
@@ -2345,13 +2568,15 @@ QSizeF QWebEnginePage::contentsSize() const
     This method issues an asynchronous request for printing the web page into
     a PDF and returns immediately.
     To be informed about the result of the request, connect to the signal
-    pdfPrintingFinished().
+    pdfPrintingFinished(). The document is generated completely before it is
+    saved. It is then written to the file in blocks, and pdfPrintingProgress()
+    is emitted after each block.
 
     \note The \l QWebEnginePage::Stop web action can be used to interrupt
     this asynchronous operation.
 
     If a file already exists at the provided file path, it will be overwritten.
-    \sa pdfPrintingFinished()
+    \sa pdfPrintingFinished(), pdfPrintingProgress()
 */
 void QWebEnginePage::printToPdf(const QString &filePath, const QPageLayout &layout, const QPageRanges &ranges)
 {
@@ -2387,8 +2612,10 @@ void QWebEnginePage::printToPdf(const std::function<void(const QByteArray&)> &re
     Q_D(QWebEnginePage);
     d->ensureInitialized();
     std::function wrappedCallback = [resultCallback](QSharedPointer<QByteArray> result) {
+        // The result references the shared memory of the print job; detach it before
+        // handing it out.
         if (resultCallback && result)
-            resultCallback(*result);
+            resultCallback(QByteArray(result->constData(), result->size()));
     };
     d->printToPdf(std::move(wrappedCallback), layout, ranges, WebContentsAdapter::kUseMainFrameId);
 #else
@@ -2567,10 +2794,59 @@ std::optional<QWebEngineFrame> QWebEnginePage::findFrameByName(QAnyStringView na
     return {};
 }
 
+/*!
+    \since 6.10
+
+    Runs the JavaScript code contained in \a scriptSource in every frame of the page for which
+    \a frameFilter returns \c true, using the script world given by \a worldId. If
+    \a frameFilter is empty, the script runs in all frames.
+
+    The script is sent to all selected frames at once, and \a resultCallback is called a single
+    time with one entry per selected frame, in document order. Frames that have not returned a
+    result within \a timeout, or that went away in the meantime, are reported with an invalid
+    QVariant. A timeout of zero waits for all frames.
+
+    \sa runJavaScript(), QWebEngineFrame::runJavaScript()
+*/
+void QWebEnginePage::runJavaScriptInFrames(
+        const QString &scriptSource, quint32 worldId, std::chrono::milliseconds timeout,
+        const std::function<bool(const QWebEngineFrame &)> &frameFilter,
+        const std::function<void(const QList<QPair<QWebEngineFrame, QVariant>> &)>
+                &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    d->ensureInitialized();
+    if (d->adapter->lifecycleState() == WebContentsAdapter::LifecycleState::Discarded) {
+        qWarning("runJavaScriptInFrames: disabled in Discarded state");
+        if (resultCallback)
+            resultCallback({});
+        return;
+    }
+
+    QList<quint64> frameIds;
+    for (quint64 frameId : d->adapter->allFrameIds()) {
+        if (!frameFilter || frameFilter(QWebEngineFrame(d->adapter, frameId)))
+            frameIds.append(frameId);
+    }
+
+    QWeakPointer<WebContentsAdapter> adapter = d->adapter;
+    d->adapter->runJavaScriptInFrames(
+            scriptSource, worldId, frameIds, int(timeout.count()),
+            [adapter, resultCallback](const QList<std::pair<quint64, QVariant>> &results) {
+                if (!resultCallback)
+                    return;
+                QList<QPair<QWebEngineFrame, QVariant>> frameResults;
+                frameResults.reserve(results.size());
+                for (const auto &result : results)
+                    frameResults.append({ QWebEngineFrame(adapter, result.first), result.second });
+                resultCallback(frameResults);
+            });
+}
+
 QDataStream &operator<<(QDataStream &stream, const QWebEngineHistory &history)
 {
-    auto adapter = history.d_func()->adapter();
-    if (!adapter->isInitialized())
+    auto adapter = history.d_func()->client->webContentsAdapter();
+    if (!adapter->isInitialized() && !adapter->hasPendingNavigationHistory())
         adapter->loadDefault();
     adapter->serializeNavigationHistory(stream);
     return stream;
@@ -15,10 +15,12 @@
 #include <QtCore/qanystringview.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qvariant.h>
 #include <QtGui/qpagelayout.h>
 #include <QtGui/qpageranges.h>
 #include <QtGui/qtgui-config.h>
 
+#include <chrono>
 #include <functional>
 #include <optional>
 
@@ -28,6 +30,7 @@ class QAction;
 class QAuthenticator;
 class QContextMenuBuilder;
 class QRect;
+class QRectF;
 class QVariant;
 class QWebChannel;
 class QWebEngineCertificateError;
@@ -255,6 +258,10 @@ public:
     bool event(QEvent*) override;
 
     void findText(const QString &subString, FindFlags options = {}, const std::function<void(const QWebEngineFindTextResult &)> &resultCallback = std::function<void(const QWebEngineFindTextResult &)>());
+    void findTextMatchRects(
+            const QString &subString, FindFlags options,
+            const std::function<void(const QList<QPair<QWebEngineFrame, QList<QRectF>>> &)>
+                    &resultCallback);
 
 #if QT_DEPRECATED_SINCE(6, 8)
     QT_DEPRECATED_VERSION_X_6_8(
@@ -291,6 +298,10 @@ public:
     void notifyUserActivation();
     QString networkQuery(const QString &queryType, const QString &argsJson = QString()) const;
     void smoothScrollBy(int dx, int dy, double factor, int posX = -1, int posY = -1);
+    QVariantMap smoothScrollMetrics() const;
+    QVariantMap inputLatencyStatistics() const;
+    void resetInputLatencyStatistics();
+    QVariantMap inputResamplingStatistics() const;
     QWebEngineScriptCollection &scripts();
     QWebEngineSettings *settings() const;
 
@@ -332,6 +343,11 @@ public:
 
     QWebEngineFrame mainFrame();
     std::optional<QWebEngineFrame> findFrameByName(QAnyStringView name);
+    void runJavaScriptInFrames(
+            const QString &scriptSource, quint32 worldId, std::chrono::milliseconds timeout,
+            const std::function<bool(const QWebEngineFrame &)> &frameFilter,
+            const std::function<void(const QList<QPair<QWebEngineFrame, QVariant>> &)>
+                    &resultCallback);
 
     void acceptAsNewWindow(QWebEngineNewWindowRequest &request);
 
@@ -388,6 +404,7 @@ Q_SIGNALS:
     void renderProcessPidChanged(qint64 pid);
 
     void pdfPrintingFinished(const QString &filePath, bool success);
+    void pdfPrintingProgress(const QString &filePath, qint64 bytesWritten, qint64 bytesTotal);
     void printRequested();
     void printRequestedByFrame(QWebEngineFrame frame);
 
@@ -425,6 +442,8 @@ private:
 #endif
 
     friend class QContextMenuBuilder;
+    friend class QWebEngineHeadlessRenderer;
+    friend class QWebEngineProfile;
     friend class QWebEngineView;
     friend class QWebEngineViewPrivate;
 #if QT_CONFIG(accessibility)
@@ -39,6 +39,7 @@ class WebContentsAdapter;
 QT_BEGIN_NAMESPACE
 class QPrinter;
 class QWebEngineFindTextResult;
+class QWebEngineHeadlessRenderer;
 class QWebEngineHistory;
 class QWebEnginePage;
 class QWebEngineProfile;
@@ -97,6 +98,7 @@ public:
 
     QtWebEngineCore::RenderWidgetHostViewQtDelegate* CreateRenderWidgetHostViewQtDelegate(QtWebEngineCore::RenderWidgetHostViewQtDelegateClient *client) override;
     QtWebEngineCore::RenderWidgetHostViewQtDelegate* CreateRenderWidgetHostViewQtDelegateForPopup(QtWebEngineCore::RenderWidgetHostViewQtDelegateClient *client) override;
+    bool usesExternalBeginFrames() const override;
     void initializationFinished() override;
     void lifecycleStateChanged(LifecycleState state) override;
     void recommendedStateChanged(LifecycleState state) override;
@@ -142,6 +144,8 @@ public:
     void printToPdf(std::function<void(QSharedPointer<QByteArray>)> &&callback,
                     const QPageLayout &layout, const QPageRanges &ranges, quint64 frameId) override;
     void didPrintPageToPdf(const QString &filePath, bool success) override;
+    void didPrintPageToPdfProgress(const QString &filePath, qint64 bytesWritten,
+                                   qint64 bytesTotal) override;
     bool passOnFocus(bool reverse) override;
     void javaScriptConsoleMessage(JavaScriptConsoleMessageLevel level, const QString &message,
                                   int lineNumber, const QString &sourceID) override;
@@ -190,7 +194,7 @@ public:
     void createNewWindow(WindowOpenDisposition disposition, bool userGesture, const QUrl &targetUrl);
     bool adoptWebContents(QtWebEngineCore::WebContentsAdapter *webContents);
     QtWebEngineCore::WebContentsAdapter *webContents() { return adapter.data(); }
-    void recreateFromSerializedHistory(QDataStream &input);
+    void recreateFromSerializedHistory(QDataStream &input, bool deferLoad = false);
     void didPrintPage(QSharedPointer<QByteArray> result);
 
     void setFullScreenMode(bool);
@@ -218,6 +222,7 @@ public:
     qreal defaultZoomFactor;
     QTimer wasShownTimer;
     QtWebEngineCore::RenderWidgetHostViewQtDelegateItem *delegateItem = nullptr;
+    QWebEngineHeadlessRenderer *headlessRenderer = nullptr;
 #if QT_CONFIG(webengine_printing_and_pdf)
     QPrinter *currentPrinter = nullptr;
 #endif
@@ -9,17 +9,27 @@
 #include "qwebenginedownloadrequest.h"
 #include "qwebenginedownloadrequest_p.h"
 #include "qwebengineextensionmanager.h"
+#include "qwebenginefindtextresult.h"
+#include "qwebenginehistory.h"
 #include "qwebenginenotification.h"
+#include "qwebenginepage.h"
+#include "qwebenginepage_p.h"
 #include "qwebenginesettings.h"
 #include "qwebenginescriptcollection.h"
 #include "qwebenginescriptcollection_p.h"
 #include "qwebenginepermission_p.h"
 #include "qtwebenginecoreglobal.h"
+#include "net/network_predictor_qt.h"
 #include "profile_adapter.h"
 #include "visited_links_manager_qt.h"
+#include "web_contents_pool.h"
 #include "web_engine_settings.h"
 
+#include <QFile>
 #include <QFileInfo>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSaveFile>
 #include <QtWebEngineCore/qwebengineurlscheme.h>
 
 QT_BEGIN_NAMESPACE
@@ -164,6 +174,17 @@ void QWebEngineProfilePrivate::showNotification(QSharedPointer<QtWebEngineCore::
   \sa QWebEngineProfile::clearHttpCache()
 */
 
+/*!
+  \fn QWebEngineProfile::ready()
+
+  \since 6.10
+
+  This signal is emitted when a profile created with
+  QWebEngineProfileBuilder::createProfileAsync() has finished loading its stored data.
+
+  \sa isReady()
+*/
+
 QWebEngineProfilePrivate::QWebEngineProfilePrivate(ProfileAdapter* profileAdapter)
     : m_settings(new QWebEngineSettings())
     , m_profileAdapter(profileAdapter)
@@ -282,6 +303,12 @@ void QWebEngineProfilePrivate::clearHttpCacheCompleted()
     Q_EMIT q->clearHttpCacheCompleted();
 }
 
+void QWebEngineProfilePrivate::profileReady()
+{
+    Q_Q(QWebEngineProfile);
+    Q_EMIT q->ready();
+}
+
 void QWebEngineProfilePrivate::addWebContentsAdapterClient(QtWebEngineCore::WebContentsAdapterClient *adapter)
 {
     Q_ASSERT(m_profileAdapter);
@@ -371,6 +398,25 @@ bool QWebEngineProfile::isOffTheRecord() const
     return d->profileAdapter()->isOffTheRecord();
 }
 
+/*!
+    \since 6.10
+
+    Returns \c true if the profile has loaded its stored preferences and permissions.
+
+    Only a profile created with QWebEngineProfileBuilder::createProfileAsync() can be not ready
+    yet. A page of the profile that is used earlier only starts loading once the profile emits
+    ready(); it loads the last URL or content it was given. Until then, the page is empty, and
+    functions that need its content, such as QWebEnginePage::runJavaScript(), return without
+    a result.
+
+    \sa ready()
+*/
+bool QWebEngineProfile::isReady() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->isReady();
+}
+
 /*!
     Returns the path used to store persistent data for the browser and web content.
 
@@ -433,6 +479,246 @@ void QWebEngineProfile::setDownloadPath(const QString &path)
     d->profileAdapter()->setDownloadPath(path);
 }
 
+/*!
+    \since 6.10
+
+    Returns the interval at which progress of running downloads is reported.
+
+    \sa setDownloadProgressInterval()
+*/
+std::chrono::milliseconds QWebEngineProfile::downloadProgressInterval() const
+{
+    const Q_D(QWebEngineProfile);
+    return std::chrono::milliseconds(d->profileAdapter()->downloadProgressInterval());
+}
+
+/*!
+    \since 6.10
+
+    Sets the interval at which progress of running downloads is reported to \a interval.
+
+    Within one interval, only the latest received byte count of each download is reported
+    through QWebEngineDownloadRequest. Changes of the download state, such as a download
+    being paused, interrupted or finished, are always reported immediately. An interval of
+    zero reports every update.
+
+    \note By default, the interval is zero, so every update is reported as it arrives.
+
+    \sa downloadProgressInterval()
+*/
+void QWebEngineProfile::setDownloadProgressInterval(std::chrono::milliseconds interval)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->setDownloadProgressInterval(int(interval.count()));
+}
+
+/*!
+    \since 6.10
+
+    Returns the maximum number of web contents of destroyed pages that are kept for reuse.
+
+    \sa setPagePoolCapacity(), pagePoolStatistics()
+*/
+int QWebEngineProfile::pagePoolCapacity() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->webContentsPoolCapacity();
+}
+
+/*!
+    \since 6.10
+
+    Keeps the web contents of up to \a capacity destroyed pages of this profile for reuse.
+
+    Creating a page sets up a web contents with its render view and the helpers attached to
+    it, and deleting the page tears all of this down again. With a page pool, the web contents
+    of a deleted page is reset instead: its document is unloaded, and its navigation history,
+    session storage, zoom factor, user scripts and web channel are cleared. The next QWebEnginePage created for the profile
+    takes it over, which is considerably cheaper for applications that create and delete many
+    short-lived pages.
+
+    Pages with an opener, a DevTools session, a crashed render process, or that were
+    discarded are not recycled. A page taken from the pool starts out on \c about:blank.
+
+    A capacity of zero, the default, disables the pool and releases all pooled web contents.
+
+    \sa pagePoolCapacity(), pagePoolStatistics()
+*/
+void QWebEngineProfile::setPagePoolCapacity(int capacity)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->setWebContentsPoolCapacity(capacity);
+}
+
+/*!
+    \class QWebEngineProfile::PagePoolStatistics
+    \inmodule QtWebEngineCore
+    \since 6.10
+    \brief Counters describing the use of the page pool of a profile.
+
+    \c createdPages and \c reusedPages count the pages that needed a new web contents and
+    the ones that took over a pooled one, so that the reuse rate is
+    \c{reusedPages / (createdPages + reusedPages)}. \c recycledPages counts the web contents
+    put into the pool, and \c discardedPages the ones of deleted pages that had to be
+    destroyed because the pool was full or they could not be recycled. \c availablePages is
+    the number of pooled web contents that finished resetting and can be taken over by the
+    next page right away.
+
+    \c averageCreationTime and \c averageReuseTime are the average time it took to set up
+    a page in both cases. Their difference is the time saved per page taken from the pool.
+
+    \sa QWebEngineProfile::setPagePoolCapacity()
+*/
+
+/*!
+    \since 6.10
+
+    Returns statistics about the page pool of this profile. They are reset when the pool is
+    disabled.
+
+    \sa setPagePoolCapacity()
+*/
+QWebEngineProfile::PagePoolStatistics QWebEngineProfile::pagePoolStatistics() const
+{
+    const Q_D(QWebEngineProfile);
+    PagePoolStatistics result;
+    const QtWebEngineCore::WebContentsPool *pool = d->profileAdapter()->webContentsPool();
+    if (!pool)
+        return result;
+
+    const auto &statistics = pool->statistics();
+    result.createdPages = statistics.created;
+    result.reusedPages = statistics.reused;
+    result.recycledPages = statistics.recycled;
+    result.discardedPages = statistics.discarded;
+    result.availablePages = pool->availableCount();
+    if (statistics.created)
+        result.averageCreationTime = std::chrono::microseconds(
+                statistics.creationTime.InMicroseconds() / qint64(statistics.created));
+    if (statistics.reused)
+        result.averageReuseTime = std::chrono::microseconds(
+                statistics.reuseTime.InMicroseconds() / qint64(statistics.reused));
+    return result;
+}
+
+/*!
+    \since 6.10
+
+    Opens \a count connections to \a origin ahead of a request to it, including the TLS
+    handshake for HTTPS origins. The connections are kept in the profile's socket pool for a
+    while and are used by the next requests of any page of this profile to the origin.
+
+    Only the scheme, host and port of \a origin are used. The warm-up is passed to the
+    profile's request interceptor as a request of type
+    QWebEngineUrlRequestInfo::ResourceTypePrefetch first, which may block or redirect it, and
+    it goes through the profile's proxy.
+
+    \sa prefetchDns(), prefetch(), networkWarmupStatistics()
+*/
+void QWebEngineProfile::preconnect(const QUrl &origin, int count)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->ensureNetworkPredictor()->preconnect(origin, count);
+}
+
+/*!
+    \since 6.10
+
+    Resolves the host names in \a hosts into the profile's host cache, so that requests to
+    them do not have to wait for DNS.
+
+    Each host is passed to the profile's request interceptor as an HTTPS URL of type
+    QWebEngineUrlRequestInfo::ResourceTypePrefetch first, which may block or redirect it.
+
+    \sa preconnect(), prefetch(), networkWarmupStatistics()
+*/
+void QWebEngineProfile::prefetchDns(const QStringList &hosts)
+{
+    Q_D(QWebEngineProfile);
+    QtWebEngineCore::NetworkPredictorQt *predictor = d->profileAdapter()->ensureNetworkPredictor();
+    for (const QString &host : hosts)
+        predictor->prefetchDns(host);
+}
+
+/*!
+    \since 6.10
+
+    Loads the resources at \a urls into the profile's HTTP cache. They are loaded like the
+    requests of pages, through the profile's request interceptor and proxy, with the
+    resource type QWebEngineUrlRequestInfo::ResourceTypePrefetch.
+
+    The HTTP cache is partitioned by the site of the top-level document. Without a
+    \a firstPartyUrl, every resource is cached for navigating to it. Resources used by the
+    pages of a site, like scripts or images, should be prefetched with a URL of that site as
+    \a firstPartyUrl. Only resources the server allows to be cached are reused, and bodies
+    larger than 5MB are not loaded completely.
+
+    \sa preconnect(), prefetchDns(), networkWarmupStatistics()
+*/
+void QWebEngineProfile::prefetch(const QList<QUrl> &urls, const QUrl &firstPartyUrl)
+{
+    Q_D(QWebEngineProfile);
+    QtWebEngineCore::NetworkPredictorQt *predictor = d->profileAdapter()->ensureNetworkPredictor();
+    for (const QUrl &url : urls)
+        predictor->prefetch(url, firstPartyUrl);
+}
+
+/*!
+    \class QWebEngineProfile::NetworkWarmupStatistics
+    \inmodule QtWebEngineCore
+    \since 6.10
+    \brief Counters describing the network warm-ups of a profile and what they saved.
+
+    \c preconnects, \c dnsPrefetches and \c prefetches count the warm-ups started with
+    QWebEngineProfile::preconnect(), QWebEngineProfile::prefetchDns() and
+    QWebEngineProfile::prefetch(), and \c blockedWarmups the ones blocked by the request
+    interceptor. \c dnsPrefetchFailures and \c prefetchFailures count the warm-ups that
+    failed.
+
+    The hits count warm-ups that were used by a later request of a page within five minutes:
+    a preconnect when the first request to the origin used an existing connection, a DNS
+    prefetch by the first request to the host, and a prefetch when the first request for the
+    URL was served from the cache. Each warm-up counts at most once.
+
+    The time saved is the time the warm-ups that were hit took themselves: the host
+    resolution minus what the request still spent resolving, and the load of a prefetched
+    resource. For preconnects it is estimated from the average time of the fresh connections
+    observed by the profile.
+
+    \sa QWebEngineProfile::networkWarmupStatistics()
+*/
+
+/*!
+    \since 6.10
+
+    Returns statistics about the network warm-ups of this profile.
+
+    \sa preconnect(), prefetchDns(), prefetch()
+*/
+QWebEngineProfile::NetworkWarmupStatistics QWebEngineProfile::networkWarmupStatistics() const
+{
+    const Q_D(QWebEngineProfile);
+    NetworkWarmupStatistics result;
+    const QtWebEngineCore::NetworkPredictorQt *predictor = d->profileAdapter()->networkPredictor();
+    if (!predictor)
+        return result;
+
+    const auto &statistics = predictor->statistics();
+    result.preconnects = statistics.preconnects;
+    result.preconnectHits = statistics.preconnectHits;
+    result.dnsPrefetches = statistics.dnsPrefetches;
+    result.dnsPrefetchFailures = statistics.dnsPrefetchFailures;
+    result.dnsPrefetchHits = statistics.dnsPrefetchHits;
+    result.prefetches = statistics.prefetches;
+    result.prefetchFailures = statistics.prefetchFailures;
+    result.prefetchHits = statistics.prefetchHits;
+    result.blockedWarmups = statistics.blocked;
+    result.preconnectTimeSaved = std::chrono::microseconds(statistics.preconnectTimeSaved.InMicroseconds());
+    result.dnsTimeSaved = std::chrono::microseconds(statistics.dnsTimeSaved.InMicroseconds());
+    result.prefetchTimeSaved = std::chrono::microseconds(statistics.prefetchTimeSaved.InMicroseconds());
+    return result;
+}
+
 /*!
     \since 6.5
 
@@ -646,6 +932,51 @@ void QWebEngineProfile::setHttpCacheMaximumSize(int maxSize)
     d->profileAdapter()->setHttpCacheMaxSize(maxSize);
 }
 
+/*!
+    \since 6.10
+
+    Returns the path of the HTTP cache shared with other profiles, or an empty string if the
+    profile does not use one.
+
+    \sa setSharedHttpCachePath()
+*/
+QString QWebEngineProfile::sharedHttpCachePath() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->sharedHttpCachePath();
+}
+
+/*!
+    \since 6.10
+
+    Sets the path of an HTTP cache shared by all profiles that set the same \a path. Pages of
+    the profile consult it before the profile's own cache. An empty \a path, the default,
+    disables the shared cache.
+
+    Only responses that HTTP allows shared caches to serve to anyone are stored: images,
+    scripts, style sheets and fonts that are served with \c{Cache-Control: public}, without
+    cookies, and that do not vary on anything but their encoding. They are stored while a page
+    loads them, and only served while they are fresh, for requests that allow cached
+    responses. Like the profile's own cache, the shared cache is partitioned by the site of the
+    page, but a body is only stored once for all pages. Off-the-record profiles use the shared
+    cache without adding to it.
+
+    \note A response served from the shared cache arrives faster than one from the network.
+    By timing its loads, a page can therefore learn which public resources a page of the same
+    site loaded in another profile using the same cache. Only share a cache between profiles
+    that may know about each other's browsing.
+
+    When the shared cache grows beyond 256MB, the least recently used entries are removed
+    until it is back at 192MB. It can be deleted by the application when no profile uses it.
+
+    \sa sharedHttpCachePath(), setHttpCacheType()
+*/
+void QWebEngineProfile::setSharedHttpCachePath(const QString &path)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->setSharedHttpCachePath(path);
+}
+
 /*!
     Returns the cookie store for this profile.
 
@@ -704,6 +1035,39 @@ bool QWebEngineProfile::visitedLinksContainsUrl(const QUrl &url) const
     return d->profileAdapter()->visitedLinksManager()->containsUrl(url);
 }
 
+/*!
+    \since 6.10
+
+    Returns for each URL in \a urls whether it is considered a visited link by this profile,
+    in the same order.
+
+    \sa visitedLinksContainsUrl()
+*/
+QList<bool> QWebEngineProfile::visitedLinksContainUrls(const QList<QUrl> &urls) const
+{
+    Q_D(const QWebEngineProfile);
+    return d->profileAdapter()->visitedLinksManager()->containsUrls(urls);
+}
+
+/*!
+    \since 6.10
+
+    Adds the links in \a urls to the visited links database, for instance to migrate the history
+    of another browser. \a resultCallback is invoked once all of them are visited links.
+
+    The URLs are prepared in the background and added in large batches, which is much faster
+    than visiting them one by one. Pages that are already open update their links once each
+    batch is added.
+
+    \sa visitedLinksContainUrls(), clearVisitedLinks()
+*/
+void QWebEngineProfile::importVisitedLinks(const QList<QUrl> &urls,
+                                           const std::function<void()> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->visitedLinksManager()->importUrls(urls, resultCallback);
+}
+
 /*!
     Returns the collection of scripts that are injected into all pages that share
     this profile.
@@ -898,6 +1262,107 @@ void QWebEngineProfile::clearHttpCache()
     d->profileAdapter()->clearHttpCache();
 }
 
+/*!
+    \class QWebEngineProfile::HttpCacheEntry
+    \inmodule QtWebEngineCore
+    \since 6.10
+    \brief Describes an entry of the HTTP cache of a profile.
+
+    \c url is the URL of the cached resource, \c size the number of bytes the entry takes on
+    disk, including its headers and metadata, and \c lastModified the last time the entry was
+    written.
+
+    \sa QWebEngineProfile::requestHttpCacheEntries()
+*/
+
+/*!
+    \since 6.10
+
+    Lists the entries of the profile's HTTP cache and passes them to \a resultCallback.
+
+    The cache is read on a background thread, and the callback is invoked on the thread of the
+    profile once it is done. Entries that are being written at the time may be missing.
+
+    Only a disk cache can be listed, for other cache types the list is empty.
+
+    \sa httpCacheType(), removeHttpCacheEntriesWithPrefix()
+*/
+void QWebEngineProfile::requestHttpCacheEntries(const std::function<void(const QList<HttpCacheEntry> &)> &resultCallback) const
+{
+    const Q_D(QWebEngineProfile);
+    d->profileAdapter()->requestHttpCacheEntries(
+            [resultCallback](const QList<QtWebEngineCore::HttpCacheFiles::Entry> &entries) {
+                QList<HttpCacheEntry> result;
+                result.reserve(entries.size());
+                for (const auto &entry : entries)
+                    result.append({ entry.url, entry.size, entry.lastModified });
+                resultCallback(result);
+            });
+}
+
+/*!
+    \since 6.10
+
+    Removes the entries of the profile's HTTP cache that were cached for the resources of
+    \a origins. An empty list of \a origins matches all resources.
+
+    If \a lastUsedBefore is valid, only the entries that were not used since then are removed,
+    so that the entries still in use are kept. Unlike clearHttpCache(), navigations may
+    continue while the entries are removed. \a resultCallback is invoked once they are.
+
+    \sa removeHttpCacheEntriesWithPrefix(), clearHttpCache()
+*/
+void QWebEngineProfile::removeHttpCacheEntries(const QList<QUrl> &origins, const QDateTime &lastUsedBefore,
+                                               const std::function<void()> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->removeHttpCacheEntries(origins, lastUsedBefore, resultCallback);
+}
+
+/*!
+    \since 6.10
+
+    Removes the entries of the profile's HTTP cache whose URL starts with \a urlPrefix, and
+    passes the number of removed entries to \a resultCallback.
+
+    Only a disk cache supports removing entries by URL, and only while it is closed. If the
+    profile has not opened its cache yet, the entries are removed right before it does, and
+    \a resultCallback is invoked then. Otherwise the removal is recorded next to the cache and
+    carried out the next time the application opens it, and \a resultCallback receives \c -1.
+    Until then, the entries can still be used. To remove entries right away, use
+    removeHttpCacheEntries() or clearHttpCache().
+
+    \sa requestHttpCacheEntries(), removeHttpCacheEntries()
+*/
+void QWebEngineProfile::removeHttpCacheEntriesWithPrefix(const QString &urlPrefix,
+                                                         const std::function<void(qsizetype)> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->removeHttpCacheEntriesWithPrefix(urlPrefix, resultCallback);
+}
+
+/*!
+    \since 6.10
+
+    Imports the HTTP cache in \a snapshotDirectory into the profile, to start the application
+    with a warm cache. The directory must be a copy of the cachePath() of a profile with a
+    disk cache, taken while that profile was not in use. Only the HTTP cache is imported from
+    it, and  resultCallback is invoked with \c false if the directory does not contain one.
+
+    The snapshot is copied next to the profile's cache first, and replaces the cache the next
+    time the profile opens it. This is before the first page of the profile loads if the
+    import completed before, or otherwise the next time the application starts.
+    \a resultCallback is invoked with \c true once the snapshot has been copied.
+
+    \sa cachePath(), httpCacheType()
+*/
+void QWebEngineProfile::importHttpCache(const QString &snapshotDirectory,
+                                        const std::function<void(bool)> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->importHttpCache(snapshotDirectory, resultCallback);
+}
+
 /*!
     \since 5.13
 
@@ -1084,6 +1549,43 @@ QList<QWebEnginePermission> QWebEngineProfile::listPermissionsForPermissionType(
     return d->profileAdapter()->listPermissions(QUrl(), permissionType);
 }
 
+/*!
+    Returns all permissions currently present in the persistent permission store as a JSON object.
+
+    The object contains one member per permission type, named after the type, mapping each
+    security origin to \c true if the permission was granted, or \c false if it was denied.
+    The result can be passed to importPermissions(), for instance to move the permissions of a
+    user to another profile.
+
+    \note When persistentPermissionPolicy() is set to \c AskEveryTime, this will return an empty object.
+    \since 6.10
+    \sa importPermissions(), listAllPermissions()
+*/
+QJsonObject QWebEngineProfile::exportPermissions() const
+{
+    Q_D(const QWebEngineProfile);
+    return d->profileAdapter()->exportPermissions();
+}
+
+/*!
+    Grants or denies all permissions described by \a permissions, in the format returned by
+    exportPermissions(), and returns the number of permissions that were imported.
+
+    Entries with an unknown or non-persistent permission type, an invalid origin, or a value
+    that is not a boolean are ignored. Existing permissions for the same origin and type are
+    replaced. Importing a large number of permissions does not write to disk for each of them;
+    the changes are stored together shortly afterwards.
+
+    \note When persistentPermissionPolicy() is set to \c AskEveryTime, nothing is imported.
+    \since 6.10
+    \sa exportPermissions(), QWebEnginePermission::isPersistent()
+*/
+qsizetype QWebEngineProfile::importPermissions(const QJsonObject &permissions)
+{
+    Q_D(QWebEngineProfile);
+    return d->profileAdapter()->importPermissions(permissions);
+}
+
 /*!
     Return the Client Hints settings associated with this browsing context.
 
@@ -1099,6 +1601,10 @@ QWebEngineClientHints *QWebEngineProfile::clientHints() const
 /*!
     Returns the extension manager associated with this browsing context.
 
+    The installed extensions are loaded when the first page of the profile is initialized, or
+    when this function is first called. For a profile that is not ready yet, it returns
+    \nullptr.
+
     \since 6.10
     \sa QWebEngineExtensionManager
 */
@@ -1112,6 +1618,136 @@ QWebEngineExtensionManager *QWebEngineProfile::extensionManager() const
 #endif
 }
 
+static const quint32 kSessionFileMagic = 0x51574553; // "QWES"
+static const quint32 kSessionFileVersion = 1;
+
+/*!
+    \since 6.10
+
+    Saves the navigation history of every QWebEnginePage using this profile to the file
+    \a fileName, in the order the pages were created. Returns \c true on success.
+
+    Pages whose history was restored but that have not been shown or used since are written
+    without loading them.
+
+    \sa restoreSession()
+*/
+bool QWebEngineProfile::saveSession(const QString &fileName) const
+{
+    Q_D(const QWebEngineProfile);
+    QList<QWebEnginePage *> pages;
+    for (auto *client : d->profileAdapter()->webContentsAdapterClients()) {
+        if (client->clientType() == QtWebEngineCore::WebContentsAdapterClient::WidgetsClient)
+            pages.append(static_cast<QWebEnginePagePrivate *>(client)->q_ptr);
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Could not open %ls for writing the session.", qUtf16Printable(fileName));
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_10);
+    stream << kSessionFileMagic << kSessionFileVersion << qint32(pages.size());
+    for (QWebEnginePage *page : std::as_const(pages))
+        stream << *page->history();
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+/*!
+    \since 6.10
+
+    Creates a QWebEnginePage using this profile for every page stored in the session file
+    \a fileName written by saveSession(), and returns them in the order they were saved. The
+    pages are created with the given \a parent.
+
+    The file is mapped into memory while reading. Each page only keeps its history in
+    compressed form until it is shown or navigates, so restoring a large session does not
+    load all pages at once. title(), url() and the entries of history() are available right
+    away.
+
+    Returns an empty list if the file could not be read.
+
+    \sa saveSession()
+*/
+QList<QWebEnginePage *> QWebEngineProfile::restoreSession(const QString &fileName, QObject *parent)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning("Could not open %ls for reading the session.", qUtf16Printable(fileName));
+        return {};
+    }
+
+    QByteArray data;
+    if (uchar *mapped = file.map(0, file.size()))
+        data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file.size());
+    else
+        data = file.readAll();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_10);
+    quint32 magic, version;
+    qint32 count;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != kSessionFileMagic
+        || version != kSessionFileVersion || count < 0) {
+        qWarning("%ls is not a valid session file.", qUtf16Printable(fileName));
+        return {};
+    }
+
+    QList<QWebEnginePage *> pages;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        auto *page = new QWebEnginePage(this, parent);
+        page->d_func()->recreateFromSerializedHistory(stream, true);
+        pages.append(page);
+    }
+    return pages;
+}
+
+/*!
+    \since 6.10
+
+    Searches for \a subString in every QWebEnginePage using this profile, with the given
+    \a caseSensitivity, and returns the number of pages searched.
+
+    The search runs in all pages at the same time, as with QWebEnginePage::findText() called
+    on each of them, so the matches are highlighted in every page. \a resultCallback is called
+    once per page as soon as that page has finished, with the page and its result. Pages that
+    are deleted before finishing are not reported.
+
+    \note Only pages of the Qt WebEngine Widgets and Core APIs are searched. WebEngineView items
+    of Qt WebEngine Quick that use this profile are skipped, since they have no QWebEnginePage
+    to report; call WebEngineView::findText() on them instead.
+
+    \sa QWebEnginePage::findText()
+*/
+int QWebEngineProfile::findTextInPages(
+        const QString &subString, Qt::CaseSensitivity caseSensitivity,
+        const std::function<void(QWebEnginePage *, const QWebEngineFindTextResult &)>
+                &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    QList<QPointer<QWebEnginePage>> pages;
+    // Quick views are backed by QQuickWebEngineViewPrivate and have no page to report.
+    for (auto *client : d->profileAdapter()->webContentsAdapterClients()) {
+        if (client->clientType() == QtWebEngineCore::WebContentsAdapterClient::WidgetsClient)
+            pages.append(static_cast<QWebEnginePagePrivate *>(client)->q_ptr);
+    }
+
+    QWebEnginePage::FindFlags options;
+    if (caseSensitivity == Qt::CaseSensitive)
+        options |= QWebEnginePage::FindCaseSensitively;
+    for (const QPointer<QWebEnginePage> &page : std::as_const(pages)) {
+        if (!page)
+            continue;
+        page->findText(subString, options, [page, resultCallback](const QWebEngineFindTextResult &result) {
+            if (page && resultCallback)
+                resultCallback(page, result);
+        });
+    }
+    return pages.size();
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qwebengineprofile.cpp"
@@ -8,15 +8,19 @@
 #include <QtWebEngineCore/qtwebenginecoreglobal.h>
 #include <QtWebEngineCore/qwebenginepermission.h>
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 
 QT_BEGIN_NAMESPACE
 
+class QJsonObject;
 class QSslCertificate;
 class QUrl;
 class QWebEngineClientCertificateStore;
@@ -24,7 +28,9 @@ class QWebEngineClientHints;
 class QWebEngineCookieStore;
 class QWebEngineDownloadRequest;
 class QWebEngineExtensionManager;
+class QWebEngineFindTextResult;
 class QWebEngineNotification;
+class QWebEnginePage;
 class QWebEngineProfilePrivate;
 class QWebEngineSettings;
 class QWebEngineScriptCollection;
@@ -53,6 +59,40 @@ public:
     };
     Q_ENUM(PersistentCookiesPolicy)
 
+    struct PagePoolStatistics
+    {
+        quint64 createdPages = 0;
+        quint64 reusedPages = 0;
+        quint64 recycledPages = 0;
+        quint64 discardedPages = 0;
+        quint64 availablePages = 0;
+        std::chrono::microseconds averageCreationTime{ 0 };
+        std::chrono::microseconds averageReuseTime{ 0 };
+    };
+
+    struct NetworkWarmupStatistics
+    {
+        quint64 preconnects = 0;
+        quint64 preconnectHits = 0;
+        quint64 dnsPrefetches = 0;
+        quint64 dnsPrefetchFailures = 0;
+        quint64 dnsPrefetchHits = 0;
+        quint64 prefetches = 0;
+        quint64 prefetchFailures = 0;
+        quint64 prefetchHits = 0;
+        quint64 blockedWarmups = 0;
+        std::chrono::microseconds preconnectTimeSaved{ 0 };
+        std::chrono::microseconds dnsTimeSaved{ 0 };
+        std::chrono::microseconds prefetchTimeSaved{ 0 };
+    };
+
+    struct HttpCacheEntry
+    {
+        QUrl url;
+        qint64 size = 0;
+        QDateTime lastModified;
+    };
+
     enum class PersistentPermissionsPolicy : quint8 {
         AskEveryTime = 0,
         StoreInMemory,
@@ -62,6 +102,7 @@ public:
 
     QString storageName() const;
     bool isOffTheRecord() const;
+    bool isReady() const;
 
     QString persistentStoragePath() const;
     void setPersistentStoragePath(const QString &path);
@@ -87,12 +128,17 @@ public:
     int httpCacheMaximumSize() const;
     void setHttpCacheMaximumSize(int maxSize);
 
+    QString sharedHttpCachePath() const;
+    void setSharedHttpCachePath(const QString &path);
+
     QWebEngineCookieStore *cookieStore();
     void setUrlRequestInterceptor(QWebEngineUrlRequestInterceptor *interceptor);
 
     void clearAllVisitedLinks();
     void clearVisitedLinks(const QList<QUrl> &urls);
     bool visitedLinksContainsUrl(const QUrl &url) const;
+    QList<bool> visitedLinksContainUrls(const QList<QUrl> &urls) const;
+    void importVisitedLinks(const QList<QUrl> &urls, const std::function<void()> &resultCallback = {});
 
     QWebEngineSettings *settings() const;
     QWebEngineScriptCollection *scripts() const;
@@ -105,6 +151,13 @@ public:
     void removeAllUrlSchemeHandlers();
 
     void clearHttpCache();
+    void requestHttpCacheEntries(const std::function<void(const QList<HttpCacheEntry> &)> &resultCallback) const;
+    void removeHttpCacheEntries(const QList<QUrl> &origins, const QDateTime &lastUsedBefore = QDateTime(),
+                                const std::function<void()> &resultCallback = {});
+    void removeHttpCacheEntriesWithPrefix(const QString &urlPrefix,
+                                          const std::function<void(qsizetype)> &resultCallback = {});
+    void importHttpCache(const QString &snapshotDirectory,
+                         const std::function<void(bool)> &resultCallback = {});
 
     void setSpellCheckLanguages(const QStringList &languages);
     QStringList spellCheckLanguages() const;
@@ -114,6 +167,18 @@ public:
     QString downloadPath() const;
     void setDownloadPath(const QString &path);
 
+    std::chrono::milliseconds downloadProgressInterval() const;
+    void setDownloadProgressInterval(std::chrono::milliseconds interval);
+
+    int pagePoolCapacity() const;
+    void setPagePoolCapacity(int capacity);
+    PagePoolStatistics pagePoolStatistics() const;
+
+    void preconnect(const QUrl &origin, int count = 1);
+    void prefetchDns(const QStringList &hosts);
+    void prefetch(const QList<QUrl> &urls, const QUrl &firstPartyUrl = QUrl());
+    NetworkWarmupStatistics networkWarmupStatistics() const;
+
     bool isPushServiceEnabled() const;
     void setPushServiceEnabled(bool enabled);
 
@@ -129,14 +194,24 @@ public:
     QList<QWebEnginePermission> listAllPermissions() const;
     QList<QWebEnginePermission> listPermissionsForOrigin(const QUrl &securityOrigin) const;
     QList<QWebEnginePermission> listPermissionsForPermissionType(QWebEnginePermission::PermissionType permissionType) const;
+    QJsonObject exportPermissions() const;
+    qsizetype importPermissions(const QJsonObject &permissions);
 
     QWebEngineExtensionManager *extensionManager() const;
 
+    bool saveSession(const QString &fileName) const;
+    QList<QWebEnginePage *> restoreSession(const QString &fileName, QObject *parent = nullptr);
+
+    int findTextInPages(const QString &subString, Qt::CaseSensitivity caseSensitivity,
+                        const std::function<void(QWebEnginePage *,
+                                                 const QWebEngineFindTextResult &)> &resultCallback);
+
     static QWebEngineProfile *defaultProfile();
 
 Q_SIGNALS:
     void downloadRequested(QWebEngineDownloadRequest *download);
     void clearHttpCacheCompleted();
+    void ready();
 
 private:
     Q_DISABLE_COPY(QWebEngineProfile)
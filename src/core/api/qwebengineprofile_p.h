@@ -57,6 +57,7 @@ public:
 
     void showNotification(QSharedPointer<QtWebEngineCore::UserNotificationController> &) override;
     void clearHttpCacheCompleted() override;
+    void profileReady() override;
 
     void addWebContentsAdapterClient(QtWebEngineCore::WebContentsAdapterClient *adapter) override;
     void removeWebContentsAdapterClient(QtWebEngineCore::WebContentsAdapterClient *adapter) override;
@@ -39,24 +39,9 @@ QWebEngineProfile *QWebEngineProfileBuilder::createOffTheRecordProfile(QObject *
     return new QWebEngineProfile(parent);
 }
 
-/*!
-    Constructs a profile with the storage name \a storageName and parent \a parent.
-
-    The storage name is used to give each disk-based profile, a separate subdirectory for
-    persistent data and cache. The storage location must be unique during application life time.
-    It is up to the user to prevent the creation of profiles with same storage's location, which can
-    lead to corrupted browser cache.
-
-    A disk-based \l{QWebEngineProfile} should be destroyed before the application exit, otherwise the
-    cache and persistent data may not be fully flushed to disk.
-
-    \note When creating a disk-based profile, if the data path is already in use by another
-    profile, the function will return a null pointer.
-
-    \sa QWebEngineProfile::storageName()
-*/
-QWebEngineProfile *QWebEngineProfileBuilder::createProfile(const QString &storageName,
-                                                           QObject *parent) const
+static QWebEngineProfile *buildProfile(const QWebEngineProfileBuilderPrivate &d,
+                                       const QString &storageName, QObject *parent,
+                                       bool loadAsynchronously)
 {
     auto buildLocationFromStandardPath = [](const QString &standardPath, const QString &name) {
         QString location;
@@ -68,7 +53,7 @@ QWebEngineProfile *QWebEngineProfileBuilder::createProfile(const QString &storag
         return location;
     };
 
-    QString dataPath = d_ptr->m_dataPath;
+    QString dataPath = d.m_dataPath;
     if (dataPath.isEmpty() && !storageName.isEmpty())
         dataPath = buildLocationFromStandardPath(
                 QStandardPaths::writableLocation(QStandardPaths::AppDataLocation), storageName);
@@ -83,17 +68,63 @@ QWebEngineProfile *QWebEngineProfileBuilder::createProfile(const QString &storag
 
     return new QWebEngineProfile(
             new QWebEngineProfilePrivate(new QtWebEngineCore::ProfileAdapter(
-                    storageName, d_ptr->m_dataPath, d_ptr->m_cachePath,
-                    QtWebEngineCore::ProfileAdapter::HttpCacheType(d_ptr->m_httpCacheType),
+                    storageName, d.m_dataPath, d.m_cachePath,
+                    QtWebEngineCore::ProfileAdapter::HttpCacheType(d.m_httpCacheType),
                     QtWebEngineCore::ProfileAdapter::PersistentCookiesPolicy(
-                            d_ptr->m_persistentCookiesPolicy),
-                    d_ptr->m_httpCacheMaxSize,
+                            d.m_persistentCookiesPolicy),
+                    d.m_httpCacheMaxSize,
                     QtWebEngineCore::ProfileAdapter::PersistentPermissionsPolicy(
-                            d_ptr->m_persistentPermissionPolicy),
-                    d_ptr->m_additionalTrustedCertificates)),
+                            d.m_persistentPermissionPolicy),
+                    d.m_additionalTrustedCertificates, loadAsynchronously)),
             parent);
 }
 
+/*!
+    Constructs a profile with the storage name \a storageName and parent \a parent.
+
+    The storage name is used to give each disk-based profile, a separate subdirectory for
+    persistent data and cache. The storage location must be unique during application life time.
+    It is up to the user to prevent the creation of profiles with same storage's location, which can
+    lead to corrupted browser cache.
+
+    A disk-based \l{QWebEngineProfile} should be destroyed before the application exit, otherwise the
+    cache and persistent data may not be fully flushed to disk.
+
+    \note When creating a disk-based profile, if the data path is already in use by another
+    profile, the function will return a null pointer.
+
+    \sa QWebEngineProfile::storageName(), createProfileAsync()
+*/
+QWebEngineProfile *QWebEngineProfileBuilder::createProfile(const QString &storageName,
+                                                           QObject *parent) const
+{
+    return buildProfile(*d_ptr, storageName, parent, false);
+}
+
+/*!
+    \since 6.10
+
+    Constructs a profile with the storage name \a storageName and parent \a parent, like
+    createProfile(), but reads its stored preferences and permissions in the background instead
+    of blocking the calling thread.
+
+    The returned profile can be configured right away. Spell checking settings made before it
+    is ready are applied once its preferences have been read. Pages should only be created once
+    QWebEngineProfile::isReady() returns \c true, which the profile signals with
+    QWebEngineProfile::ready(); a page that is used earlier waits until then before it starts
+    loading. Creating several profiles this way at application start-up lets their stores load
+    in parallel.
+
+    Off-the-record profiles have nothing to load and are ready immediately.
+
+    \sa createProfile(), QWebEngineProfile::isReady()
+*/
+QWebEngineProfile *QWebEngineProfileBuilder::createProfileAsync(const QString &storageName,
+                                                                QObject *parent) const
+{
+    return buildProfile(*d_ptr, storageName, parent, true);
+}
+
 /*!
     Sets the path used to store persistent data for the browser and web content to \a path.
     Persistent data includes persistent cookies, HTML5 local storage, and visited links.
@@ -19,6 +19,7 @@ public:
     Q_WEBENGINECORE_EXPORT QWebEngineProfileBuilder();
     Q_WEBENGINECORE_EXPORT ~QWebEngineProfileBuilder();
     Q_WEBENGINECORE_EXPORT QWebEngineProfile *createProfile(const QString &storageName, QObject *parent = nullptr) const;
+    Q_WEBENGINECORE_EXPORT QWebEngineProfile *createProfileAsync(const QString &storageName, QObject *parent = nullptr) const;
     Q_WEBENGINECORE_EXPORT static QWebEngineProfile *createOffTheRecordProfile(QObject *parent = nullptr);
     Q_WEBENGINECORE_EXPORT QWebEngineProfileBuilder &setPersistentStoragePath(const QString &path);
     Q_WEBENGINECORE_EXPORT QWebEngineProfileBuilder &setCachePath(const QString &path);
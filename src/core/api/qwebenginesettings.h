@@ -68,6 +68,8 @@ public:
         TouchEventsApiEnabled,
         BackForwardCacheEnabled,
         ElementShaderEnabled,
+        InputResamplingEnabled,
+        // Update kLastAttribute in web_engine_settings.cpp when adding attributes.
     };
 
     enum FontSize {
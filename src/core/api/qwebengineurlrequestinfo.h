@@ -15,6 +15,7 @@
 namespace QtWebEngineCore {
 class ContentBrowserClientQt;
 class InterceptedRequest;
+class NetworkPredictorQt;
 } // namespace QtWebEngineCore
 
 QT_BEGIN_NAMESPACE
@@ -83,6 +84,7 @@ public:
 private:
     friend class QtWebEngineCore::ContentBrowserClientQt;
     friend class QtWebEngineCore::InterceptedRequest;
+    friend class QtWebEngineCore::NetworkPredictorQt;
     Q_DISABLE_COPY(QWebEngineUrlRequestInfo)
     Q_DECLARE_PRIVATE(QWebEngineUrlRequestInfo)
 
@@ -16,6 +16,8 @@
 #include "ui/accessibility/platform/browser_accessibility.h"
 
 #include <QtGui/qaccessible.h>
+
+#include <utility>
 #endif // QT_CONFIG(accessibility)
 
 namespace ui {
@@ -93,17 +95,120 @@ void BrowserAccessibilityManagerQt::FireBlinkEvent(ax::mojom::Event event_type,
                                                    BrowserAccessibility *node,
                                                    int action_request_id)
 {
-    auto *iface = toQAccessibleInterface(node);
+    switch (event_type) {
+    case ax::mojom::Event::kFocus:
+        queueEvent(EventType::Focus, node);
+        break;
+    case ax::mojom::Event::kCheckedStateChanged:
+        queueEvent(EventType::CheckedStateChanged, node);
+        break;
+    case ax::mojom::Event::kValueChanged:
+        queueEvent(EventType::ValueChanged, node);
+        break;
+    case ax::mojom::Event::kChildrenChanged:
+        break;
+    case ax::mojom::Event::kLayoutComplete:
+        break;
+    case ax::mojom::Event::kLoadComplete:
+        break;
+    case ax::mojom::Event::kTextChanged:
+        queueEvent(EventType::TextUpdated, node);
+        break;
+    case ax::mojom::Event::kTextSelectionChanged:
+        queueEvent(EventType::TextSelectionChanged, node);
+        break;
+    default:
+        break;
+    }
+}
+
+void BrowserAccessibilityManagerQt::FireGeneratedEvent(ui::AXEventGenerator::Event event_type,
+                                                       const ui::AXNode *node)
+{
+    BrowserAccessibilityManager::FireGeneratedEvent(event_type, node);
+
+    BrowserAccessibility *wrapper = GetFromAXNode(node);
+    DCHECK(wrapper);
 
     switch (event_type) {
-    case ax::mojom::Event::kFocus: {
+    case ui::AXEventGenerator::Event::VALUE_IN_TEXT_FIELD_CHANGED:
+        // Roles reported as QAccessible::EditableText
+        if (wrapper->GetRole() == ax::mojom::Role::kTextField
+            || wrapper->GetRole() == ax::mojom::Role::kSearchBox)
+            queueEvent(EventType::TextUpdated, wrapper);
+        break;
+    default:
+        break;
+    }
+}
+
+void BrowserAccessibilityManagerQt::BeforeAccessibilityEvents()
+{
+    BrowserAccessibilityManager::BeforeAccessibilityEvents();
+    m_inTreeUpdate = true;
+}
+
+void BrowserAccessibilityManagerQt::FinalizeAccessibilityEvents()
+{
+    BrowserAccessibilityManager::FinalizeAccessibilityEvents();
+    m_inTreeUpdate = false;
+
+    const std::vector<PendingEvent> events = std::move(m_pendingEvents);
+    const std::optional<ui::AXNodeID> focusId = std::exchange(m_pendingFocus, std::nullopt);
+    m_pendingEvents.clear();
+    m_pendingEventKeys.clear();
+
+    // The nodes may have been removed by a later part of the same update.
+    for (const PendingEvent &pending : events) {
+        if (BrowserAccessibility *node = GetFromID(pending.nodeId))
+            fireEvent(pending.type, node);
+    }
+    if (focusId) {
+        if (BrowserAccessibility *node = GetFromID(*focusId))
+            fireEvent(EventType::Focus, node);
+    }
+}
+
+void BrowserAccessibilityManagerQt::queueEvent(EventType type, BrowserAccessibility *node)
+{
+    if (!m_inTreeUpdate) {
+        fireEvent(type, node);
+        return;
+    }
+
+    // Only the last focus change is of interest, and it is delivered after the other events.
+    if (type == EventType::Focus) {
+        m_pendingFocus = node->GetId();
+        return;
+    }
+
+    // Event payloads are read from the node when the event is delivered, so only the
+    // first occurrence per node and type needs to be kept.
+    const quint64 key = (quint64(type) << 32) | quint32(node->GetId());
+    if (m_pendingEventKeys.contains(key))
+        return;
+    m_pendingEventKeys.insert(key);
+    m_pendingEvents.push_back({ type, node->GetId() });
+}
+
+void BrowserAccessibilityManagerQt::fireEvent(EventType type, BrowserAccessibility *node)
+{
+    // Nothing can be observing an off-screen node that has never been queried, so skip
+    // creating its interface just to deliver the event.
+    if (type != EventType::Focus && !hasQAccessibleInterface(node) && node->IsOffscreen())
+        return;
+
+    auto *iface = toQAccessibleInterface(node);
+
+    switch (type) {
+    case EventType::Focus: {
         QAccessibleEvent event(iface, QAccessible::Focus);
         if (event.object())
             event.setChild(-1);
         QAccessible::updateAccessibility(&event);
         break;
     }
-    case ax::mojom::Event::kCheckedStateChanged: {
+    case EventType::CheckedStateChanged: {
         QAccessible::State change;
         change.checked = true;
         QAccessibleStateChangeEvent event(iface, change);
@@ -112,7 +217,7 @@ void BrowserAccessibilityManagerQt::FireBlinkEvent(ax::mojom::Event event_type,
         QAccessible::updateAccessibility(&event);
         break;
     }
-    case ax::mojom::Event::kValueChanged: {
+    case EventType::ValueChanged: {
         QVariant value;
         if (QAccessibleValueInterface *valueIface = iface->valueInterface())
             value = valueIface->currentValue();
@@ -122,20 +227,14 @@ void BrowserAccessibilityManagerQt::FireBlinkEvent(ax::mojom::Event event_type,
         QAccessible::updateAccessibility(&event);
         break;
     }
-    case ax::mojom::Event::kChildrenChanged:
-        break;
-    case ax::mojom::Event::kLayoutComplete:
-        break;
-    case ax::mojom::Event::kLoadComplete:
-        break;
-    case ax::mojom::Event::kTextChanged: {
+    case EventType::TextUpdated: {
         QAccessibleTextUpdateEvent event(iface, -1, QString(), QString());
         if (event.object())
             event.setChild(-1);
         QAccessible::updateAccessibility(&event);
         break;
     }
-    case ax::mojom::Event::kTextSelectionChanged: {
+    case EventType::TextSelectionChanged: {
         QAccessibleTextInterface *textIface = iface->textInterface();
         if (textIface) {
             int start = 0;
@@ -155,31 +254,6 @@ void BrowserAccessibilityManagerQt::FireBlinkEvent(ax::mojom::Event event_type,
         }
         break;
     }
-    default:
-        break;
-    }
-}
-
-void BrowserAccessibilityManagerQt::FireGeneratedEvent(ui::AXEventGenerator::Event event_type,
-                                                       const ui::AXNode *node)
-{
-    BrowserAccessibilityManager::FireGeneratedEvent(event_type, node);
-
-    BrowserAccessibility *wrapper = GetFromAXNode(node);
-    DCHECK(wrapper);
-    auto *iface = toQAccessibleInterface(wrapper);
-
-    switch (event_type) {
-    case ui::AXEventGenerator::Event::VALUE_IN_TEXT_FIELD_CHANGED:
-        if (iface->role() == QAccessible::EditableText) {
-            QAccessibleTextUpdateEvent event(iface, -1, QString(), QString());
-            if (event.object())
-                event.setChild(-1);
-            QAccessible::updateAccessibility(&event);
-        }
-        break;
-    default:
-        break;
     }
 }
 
@@ -6,9 +6,13 @@
 
 #include "ui/accessibility/platform/browser_accessibility_manager.h"
 
+#include <QtCore/qset.h>
 #include <QtCore/qtclasshelpermacros.h>
 #include <QtCore/qtconfigmacros.h>
 
+#include <optional>
+#include <vector>
+
 QT_FORWARD_DECLARE_CLASS(QAccessibleInterface)
 
 namespace QtWebEngineCore {
@@ -31,13 +35,38 @@ public:
     void FireGeneratedEvent(ui::AXEventGenerator::Event event_type,
                             const ui::AXNode *node) override;
 
+    void BeforeAccessibilityEvents() override;
+    void FinalizeAccessibilityEvents() override;
+
     QAccessibleInterface *rootParentAccessible();
     bool isValid() const { return m_valid; }
 
 private:
+    enum class EventType {
+        Focus,
+        CheckedStateChanged,
+        ValueChanged,
+        TextUpdated,
+        TextSelectionChanged,
+    };
+    struct PendingEvent {
+        EventType type;
+        ui::AXNodeID nodeId;
+    };
+
+    void queueEvent(EventType type, BrowserAccessibility *node);
+    void fireEvent(EventType type, BrowserAccessibility *node);
+
     Q_DISABLE_COPY(BrowserAccessibilityManagerQt)
     QtWebEngineCore::WebContentsAccessibilityQt *m_webContentsAccessibility;
     bool m_valid = false;
+
+    // Events raised while a tree update is being applied are collected here and
+    // delivered once the update is finished, with duplicates per node dropped.
+    bool m_inTreeUpdate = false;
+    std::vector<PendingEvent> m_pendingEvents;
+    QSet<quint64> m_pendingEventKeys;
+    std::optional<ui::AXNodeID> m_pendingFocus;
 };
 
 }
@@ -37,7 +37,11 @@ public:
 
     bool isReady() const;
 
-    QtWebEngineCore::BrowserAccessibilityInterface *interface = nullptr;
+    // The interface is created when it is first asked for, so nodes that are never
+    // visited by an assistive technology do not register with QAccessible.
+    QtWebEngineCore::BrowserAccessibilityInterface *ensureInterface() const;
+
+    mutable QtWebEngineCore::BrowserAccessibilityInterface *interface = nullptr;
 };
 
 class BrowserAccessibilityInterface
@@ -145,7 +149,7 @@ private:
 
 BrowserAccessibilityQt::BrowserAccessibilityQt(ui::BrowserAccessibilityManager *manager,
                                                ui::AXNode *node)
-    : ui::BrowserAccessibility(manager, node), interface(new BrowserAccessibilityInterface(this))
+    : ui::BrowserAccessibility(manager, node)
 {
 }
 
@@ -155,6 +159,13 @@ BrowserAccessibilityQt::~BrowserAccessibilityQt()
         interface->destroy();
 }
 
+BrowserAccessibilityInterface *BrowserAccessibilityQt::ensureInterface() const
+{
+    if (!interface)
+        interface = new BrowserAccessibilityInterface(const_cast<BrowserAccessibilityQt *>(this));
+    return interface;
+}
+
 bool BrowserAccessibilityQt::isReady() const
 {
     // FIXME: This is just a workaround, remove this when the commented out assert in
@@ -1289,10 +1300,15 @@ std::unique_ptr<BrowserAccessibility> BrowserAccessibility::Create(BrowserAccess
 #if QT_CONFIG(accessibility)
 QAccessibleInterface *toQAccessibleInterface(BrowserAccessibility *obj)
 {
-    return static_cast<QtWebEngineCore::BrowserAccessibilityQt *>(obj)->interface;
+    return static_cast<QtWebEngineCore::BrowserAccessibilityQt *>(obj)->ensureInterface();
 }
 
 const QAccessibleInterface *toQAccessibleInterface(const BrowserAccessibility *obj)
+{
+    return static_cast<const QtWebEngineCore::BrowserAccessibilityQt *>(obj)->ensureInterface();
+}
+
+bool hasQAccessibleInterface(const BrowserAccessibility *obj)
 {
     return static_cast<const QtWebEngineCore::BrowserAccessibilityQt *>(obj)->interface;
 }
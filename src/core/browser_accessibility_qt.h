@@ -14,6 +14,7 @@ class BrowserAccessibility;
 
 QAccessibleInterface *toQAccessibleInterface(BrowserAccessibility *obj);
 const QAccessibleInterface *toQAccessibleInterface(const BrowserAccessibility *obj);
+bool hasQAccessibleInterface(const BrowserAccessibility *obj);
 
 } // namespace ui
 #endif // QT_CONFIG(accessibility)
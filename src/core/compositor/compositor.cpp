@@ -9,6 +9,7 @@
 
 #include <QGuiApplication>
 #include <QHash>
+#include <QImage>
 #include <QReadWriteLock>
 #include <QQuickWindow>
 
@@ -161,6 +162,16 @@ bool Compositor::textureIsFlipped()
     Q_UNREACHABLE_RETURN(false);
 }
 
+QImage Compositor::image()
+{
+    Q_UNREACHABLE_RETURN(QImage());
+}
+
+QRect Compositor::damageRect()
+{
+    Q_UNREACHABLE_RETURN(QRect());
+}
+
 void Compositor::releaseResources() { }
 
 Compositor::Compositor(Type type) : m_type(type)
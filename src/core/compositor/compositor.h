@@ -8,7 +8,9 @@
 #include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
 
 QT_BEGIN_NAMESPACE
+class QImage;
 class QQuickWindow;
+class QRect;
 class QSize;
 class QSGTexture;
 QT_END_NAMESPACE
@@ -131,6 +133,12 @@ public:
     // Is the texture produced upside down?
     virtual bool textureIsFlipped();
 
+    // Image of the frame (Software only).
+    virtual QImage image();
+
+    // Part of image() that changed with the last swapFrame() (Software only).
+    virtual QRect damageRect();
+
     // Are there resources to be released?
     virtual bool hasResources() { return false; }
 
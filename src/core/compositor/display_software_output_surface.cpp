@@ -32,6 +32,8 @@ public:
     void swapFrame() override;
     QSGTexture *texture(QQuickWindow *win, uint32_t) override;
     bool textureIsFlipped() override;
+    QImage image() override;
+    QRect damageRect() override;
     float devicePixelRatio() override;
     QSize size() override;
     bool requiresAlphaChannel() override;
@@ -43,6 +45,7 @@ private:
     scoped_refptr<base::SingleThreadTaskRunner> m_taskRunner;
     SwapBuffersCallback m_swapCompletionCallback;
     QImage m_image;
+    QRect m_damageRect;
     float m_imageDevicePixelRatio = 1.0;
 };
 
@@ -106,9 +109,11 @@ void DisplaySoftwareOutputSurface::Device::swapFrame()
         QPainter painter(&m_image);
         painter.setCompositionMode(QPainter::CompositionMode_Source);
         painter.drawImage(damageRect, image, damageRect);
+        m_damageRect = damageRect;
     } else {
         m_image = image;
         m_image.detach();
+        m_damageRect = m_image.rect();
     }
     m_imageDevicePixelRatio = m_devicePixelRatio;
     m_taskRunner->PostTask(
@@ -126,6 +131,18 @@ bool DisplaySoftwareOutputSurface::Device::textureIsFlipped()
     return false;
 }
 
+QImage DisplaySoftwareOutputSurface::Device::image()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_image;
+}
+
+QRect DisplaySoftwareOutputSurface::Device::damageRect()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_damageRect;
+}
+
 float DisplaySoftwareOutputSurface::Device::devicePixelRatio()
 {
     return m_imageDevicePixelRatio;
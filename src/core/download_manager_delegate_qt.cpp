@@ -349,42 +349,99 @@ void DownloadManagerDelegateQt::savePackageDownloadCreated(download::DownloadIte
     item->AddObserver(this);
 }
 
-void DownloadManagerDelegateQt::OnDownloadUpdated(download::DownloadItem *download)
+ProfileAdapterClient::DownloadItemInfo
+DownloadManagerDelegateQt::downloadItemInfo(download::DownloadItem *download)
+{
+    WebContentsAdapterClient *adapterClient = nullptr;
+    content::WebContents *webContents = content::DownloadItemUtils::GetWebContents(download);
+    if (webContents)
+        adapterClient = static_cast<WebContentsDelegateQt *>(webContents->GetDelegate())->adapterClient();
+
+    ProfileAdapterClient::DownloadItemInfo info = {};
+    // Chromium doesn't increase download ID when saving page.
+    info.id = download->GetId();
+    info.url = toQt(download->GetURL());
+    info.state = download->GetState();
+    info.totalBytes = download->GetTotalBytes();
+    info.receivedBytes = download->GetReceivedBytes();
+    info.mimeType = toQt(download->GetMimeType());
+    info.path = QString();
+    info.savePageFormat = ProfileAdapterClient::UnknownSavePageFormat;
+    info.accepted = true;
+    info.paused = download->IsPaused();
+    info.done = download->IsDone();
+    info.isSavePageDownload = false; // unused
+    info.useDownloadTargetCallback = false; // unused
+    info.downloadInterruptReason = download->GetLastReason();
+    info.page = adapterClient;
+    info.suggestedFileName = toQt(download->GetSuggestedFilename());
+    info.startTime = download->GetStartTime().ToTimeT();
+    return info;
+}
+
+void DownloadManagerDelegateQt::deliverDownloadUpdate(download::DownloadItem *download)
 {
     QList<ProfileAdapterClient*> clients = m_profileAdapter->clients();
-    if (!clients.isEmpty()) {
-        WebContentsAdapterClient *adapterClient = nullptr;
-        content::WebContents *webContents = content::DownloadItemUtils::GetWebContents(download);
-        if (webContents)
-            adapterClient = static_cast<WebContentsDelegateQt *>(webContents->GetDelegate())->adapterClient();
+    if (clients.isEmpty())
+        return;
 
-        ProfileAdapterClient::DownloadItemInfo info = {};
-        // Chromium doesn't increase download ID when saving page.
-        info.id = download->GetId();
-        info.url = toQt(download->GetURL());
-        info.state = download->GetState();
-        info.totalBytes = download->GetTotalBytes();
-        info.receivedBytes = download->GetReceivedBytes();
-        info.mimeType = toQt(download->GetMimeType());
-        info.path = QString();
-        info.savePageFormat = ProfileAdapterClient::UnknownSavePageFormat;
-        info.accepted = true;
-        info.paused = download->IsPaused();
-        info.done = download->IsDone();
-        info.isSavePageDownload = false; // unused
-        info.useDownloadTargetCallback = false; // unused
-        info.downloadInterruptReason = download->GetLastReason();
-        info.page = adapterClient;
-        info.suggestedFileName = toQt(download->GetSuggestedFilename());
-        info.startTime = download->GetStartTime().ToTimeT();
+    if (download->IsDone())
+        m_deliveredStates.erase(download);
+    else
+        m_deliveredStates[download] = { download->GetState(), download->IsPaused() };
 
-        QTimer::singleShot(0, m_profileAdapter,
-                           [client = clients[0], info]() { client->downloadUpdated(info); });
+    QTimer::singleShot(0, m_profileAdapter,
+                       [client = clients[0], info = downloadItemInfo(download)]() {
+                           client->downloadUpdated(info);
+                       });
+}
+
+void DownloadManagerDelegateQt::flushDownloadUpdates()
+{
+    QList<ProfileAdapterClient*> clients = m_profileAdapter->clients();
+    const std::set<download::DownloadItem *> pending = std::exchange(m_pendingUpdates, {});
+    if (clients.isEmpty() || pending.empty())
+        return;
+
+    QList<ProfileAdapterClient::DownloadItemInfo> infos;
+    infos.reserve(pending.size());
+    for (download::DownloadItem *download : pending)
+        infos.append(downloadItemInfo(download));
+
+    QTimer::singleShot(0, m_profileAdapter, [client = clients[0], infos]() {
+        for (const auto &info : infos)
+            client->downloadUpdated(info);
+    });
+}
+
+void DownloadManagerDelegateQt::OnDownloadUpdated(download::DownloadItem *download)
+{
+    if (m_profileAdapter->clients().isEmpty())
+        return;
+
+    // Chromium reports every chunk written to disk. Only the latest progress of a download is
+    // delivered once per interval, while changes of its state are delivered right away.
+    const int interval = m_profileAdapter->downloadProgressInterval();
+    auto it = m_deliveredStates.find(download);
+    if (interval <= 0 || it == m_deliveredStates.end()
+        || it->second != std::make_pair(download->GetState(), download->IsPaused())) {
+        m_pendingUpdates.erase(download);
+        deliverDownloadUpdate(download);
+        return;
+    }
+
+    m_pendingUpdates.insert(download);
+    if (!m_progressTimer.IsRunning()) {
+        m_progressTimer.Start(FROM_HERE, base::Milliseconds(interval),
+                              base::BindOnce(&DownloadManagerDelegateQt::flushDownloadUpdates,
+                                             base::Unretained(this)));
     }
 }
 
 void DownloadManagerDelegateQt::OnDownloadDestroyed(download::DownloadItem *download)
 {
+    m_pendingUpdates.erase(download);
+    m_deliveredStates.erase(download);
     download->RemoveObserver(this);
     download->Cancel(/* user_cancel */ false);
 }
@@ -6,10 +6,12 @@
 
 #include "content/public/browser/download_manager_delegate.h"
 #include <base/memory/weak_ptr.h>
+#include <base/timer/timer.h>
 
 #include <QString>
 #include <QtGlobal>
 #include <map>
+#include <set>
 
 #include "profile_adapter_client.h"
 
@@ -66,11 +68,21 @@ private:
     void cancelDownload(download::DownloadTargetCallback callback);
     download::DownloadItem *findDownloadById(quint32 downloadId);
     void savePackageDownloadCreated(download::DownloadItem *download);
+    ProfileAdapterClient::DownloadItemInfo downloadItemInfo(download::DownloadItem *download);
+    void deliverDownloadUpdate(download::DownloadItem *download);
+    void flushDownloadUpdates();
     ProfileAdapter *m_profileAdapter;
 
     uint32_t m_currentId;
     std::map<quint32, download::DownloadTargetCallback> m_pendingDownloads;
     std::map<quint32, content::SavePackagePathPickedCallback> m_pendingSaves;
+
+    // Last state and paused flag delivered to the client per download, changes of either are
+    // delivered immediately while plain progress is coalesced until m_progressTimer fires.
+    std::map<download::DownloadItem *, std::pair<download::DownloadItem::DownloadState, bool>>
+            m_deliveredStates;
+    std::set<download::DownloadItem *> m_pendingUpdates;
+    base::OneShotTimer m_progressTimer;
     base::WeakPtrFactory<DownloadManagerDelegateQt> m_weakPtrFactory;
 };
 
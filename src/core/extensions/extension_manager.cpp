@@ -14,7 +14,9 @@
 #include "extension_installer.h"
 #include "type_conversion.h"
 
+#include "base/functional/bind.h"
 #include "base/functional/callback.h"
+#include "base/task/sequenced_task_runner.h"
 #include "content/public/browser/browser_context.h"
 #include "extensions/browser/extension_file_task_runner.h"
 
@@ -54,9 +56,26 @@ ExtensionManager::ExtensionManager(content::BrowserContext *context)
     , m_installer(new ExtensionInstaller(context, this))
     , m_actionManager(new ExtensionActionManager())
 {
-    for (auto dir : QDirListing(installDirectory(), QDirListing::IteratorFlag::DirsOnly)) {
-        loadExtension(dir.filePath());
-    }
+    // Installed extensions are listed on the extension file sequence, like they are loaded,
+    // to keep the profile creation from touching the disk.
+    GetExtensionFileTaskRunner()->PostTaskAndReplyWithResult(
+            FROM_HERE,
+            base::BindOnce(
+                    [](const QString &directory) {
+                        QStringList paths;
+                        for (const auto &dir : QDirListing(directory, QDirListing::IteratorFlag::DirsOnly))
+                            paths.append(dir.filePath());
+                        return paths;
+                    },
+                    installDirectory()),
+            base::BindOnce(
+                    [](base::WeakPtr<ExtensionManager> manager, const QStringList &paths) {
+                        if (!manager)
+                            return;
+                        for (const QString &path : paths)
+                            manager->loadExtension(path);
+                    },
+                    m_weakFactory.GetWeakPtr()));
 }
 
 ExtensionManager::~ExtensionManager() { }
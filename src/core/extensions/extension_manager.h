@@ -6,6 +6,8 @@
 
 #include <memory>
 
+#include "base/memory/weak_ptr.h"
+
 #include "api/qwebengineextensioninfo.h"
 #include "api/qwebengineextensioninfo_p.h"
 
@@ -65,6 +67,7 @@ private:
     std::unique_ptr<ExtensionLoader> m_loader;
     std::unique_ptr<ExtensionInstaller> m_installer;
     std::unique_ptr<ExtensionActionManager> m_actionManager;
+    base::WeakPtrFactory<ExtensionManager> m_weakFactory{ this };
 };
 } // namespace QtWebEngineCore
 
@@ -20,6 +20,7 @@ FindTextHelper::FindTextHelper(content::WebContents *webContents, WebContentsAda
     , m_currentFindRequestId(m_findRequestIdCounter++)
     , m_lastCompletedFindRequestId(m_currentFindRequestId)
     , m_previousCaseSensitively(false)
+    , m_noMatchesCaseSensitively(false)
 {
 }
 
@@ -39,6 +40,13 @@ void FindTextHelper::startFinding(const QString &findText, bool caseSensitively,
         return;
     }
 
+    if (isKnownWithoutMatches(findText, caseSensitively)) {
+        finishWithoutMatches();
+        if (resultCallback)
+            resultCallback(QWebEngineFindTextResult());
+        return;
+    }
+
     startFinding(findText, caseSensitively, findBackward);
     m_widgetCallbacks.insert(m_currentFindRequestId, resultCallback);
 }
@@ -56,6 +64,16 @@ void FindTextHelper::startFinding(const QString &findText, bool caseSensitively,
         return;
     }
 
+    if (isKnownWithoutMatches(findText, caseSensitively)) {
+        finishWithoutMatches();
+        if (!resultCallback.isUndefined()) {
+            QJSValueList args;
+            args.append(QJSValue(0));
+            const_cast<QJSValue&>(resultCallback).call(args);
+        }
+        return;
+    }
+
     startFinding(findText, caseSensitively, findBackward);
     if (!resultCallback.isUndefined())
         m_quickCallbacks.insert(m_currentFindRequestId, resultCallback);
@@ -65,7 +83,9 @@ void FindTextHelper::startFinding(const QString &findText, bool caseSensitively,
 {
     Q_ASSERT(!findText.isEmpty());
 
-    const bool findNext = !m_previousFindText.isEmpty() && findText == m_previousFindText && caseSensitively == m_previousCaseSensitively;
+    // A search without matches is repeated in a new session, which scans the document again.
+    const bool findNext = !m_previousFindText.isEmpty() && findText == m_previousFindText
+            && caseSensitively == m_previousCaseSensitively && m_noMatchesFindText.isEmpty();
     if (isFindTextInProgress()) {
         // There are cases where the render process will overwrite a previous request
         // with the new search and we'll have a dangling callback, leaving the application
@@ -86,6 +106,9 @@ void FindTextHelper::startFinding(const QString &findText, bool caseSensitively,
     m_previousFindText = findText;
     m_previousCaseSensitively = caseSensitively;
 
+    // Only the searches that directly refine the one answered by this request can rely on its
+    // result, anything else is answered by the current document again.
+    m_noMatchesFindText.clear();
     m_currentFindRequestId = m_findRequestIdCounter++;
     m_webContents->Find(m_currentFindRequestId, toString16(findText), std::move(options), /*skip_delay=*/true);
 }
@@ -94,9 +117,34 @@ void FindTextHelper::stopFinding()
 {
     m_lastCompletedFindRequestId = m_currentFindRequestId;
     m_previousFindText = QString();
+    m_noMatchesFindText.clear();
     m_webContents->StopFinding(content::STOP_FIND_ACTION_KEEP_SELECTION);
 }
 
+bool FindTextHelper::isKnownWithoutMatches(const QString &findText, bool caseSensitively) const
+{
+    // Repeating the search asks the page again, the document may have changed since.
+    if (m_noMatchesFindText.isEmpty() || findText.size() <= m_noMatchesFindText.size())
+        return false;
+    // A case-insensitive miss also rules out every case-sensitive search, but not vice versa.
+    if (m_noMatchesCaseSensitively && !caseSensitively)
+        return false;
+    return findText.startsWith(m_noMatchesFindText,
+                               m_noMatchesCaseSensitively ? Qt::CaseSensitive : Qt::CaseInsensitive);
+}
+
+void FindTextHelper::finishWithoutMatches()
+{
+    if (isFindTextInProgress()) {
+        m_lastCompletedFindRequestId = m_currentFindRequestId;
+        m_webContents->StopFinding(content::STOP_FIND_ACTION_KEEP_SELECTION);
+        invokeResultCallback(m_currentFindRequestId, 0, 0);
+    }
+    // The renderer never saw this text, so the next search has to start a new session.
+    m_previousFindText = QString();
+    m_viewClient->findTextFinished(QWebEngineFindTextResult());
+}
+
 bool FindTextHelper::isFindTextInProgress() const
 {
     return m_currentFindRequestId != m_lastCompletedFindRequestId;
@@ -114,6 +162,12 @@ void FindTextHelper::handleFindReply(content::WebContents *source, int requestId
 
     Q_ASSERT(m_currentFindRequestId == requestId);
     m_lastCompletedFindRequestId = requestId;
+    if (numberOfMatches == 0) {
+        m_noMatchesFindText = m_previousFindText;
+        m_noMatchesCaseSensitively = m_previousCaseSensitively;
+    } else {
+        m_noMatchesFindText.clear();
+    }
     m_viewClient->findTextFinished(QWebEngineFindTextResult(numberOfMatches, activeMatch));
     invokeResultCallback(requestId, numberOfMatches, activeMatch);
 }
@@ -122,6 +176,7 @@ void FindTextHelper::handleLoadCommitted()
 {
     // Make sure that we don't set the findNext WebFindOptions on a new frame.
     m_previousFindText = QString();
+    m_noMatchesFindText.clear();
 }
 
 void FindTextHelper::invokeResultCallback(int requestId, int numberOfMatches, int activeMatch)
@@ -51,6 +51,8 @@ public:
     void handleLoadCommitted();
 
 private:
+    bool isKnownWithoutMatches(const QString &findText, bool caseSensitively) const;
+    void finishWithoutMatches();
     void invokeResultCallback(int requestId, int numberOfMatches, int activeMatch);
 
     content::WebContents *m_webContents;
@@ -63,6 +65,12 @@ private:
     QString m_previousFindText;
     bool m_previousCaseSensitively;
 
+    // Text of the last search sent to the renderer if it was found nowhere on the page.
+    // Typing further characters cannot produce matches, so those searches are answered
+    // without the renderer until another search reaches it.
+    QString m_noMatchesFindText;
+    bool m_noMatchesCaseSensitively;
+
     QMap<int, QJSValue> m_quickCallbacks;
     QMap<int, std::function<void(const QWebEngineFindTextResult &)>> m_widgetCallbacks;
 };
@@ -0,0 +1,233 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "input_latency_tracker.h"
+
+#include "base/trace_event/trace_event.h"
+#include "third_party/blink/public/common/input/web_input_event.h"
+
+#include <QtCore/qevent.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace Qt::StringLiterals;
+
+namespace QtWebEngineCore {
+
+// Events not acknowledged within this time are considered lost.
+static constexpr base::TimeDelta kPendingTimeout = base::Seconds(2);
+// Events acknowledged longer ago than this before the next swap didn't change anything on
+// screen, they are finished without a presentation time.
+static constexpr base::TimeDelta kPresentationTimeout = base::Milliseconds(500);
+// Bounds the events waiting on a single category, for instance while the view is hidden.
+static constexpr size_t kMaxPendingEvents = 256;
+
+static const char *const kCategoryNames[] = { "mouse", "wheel", "keyboard", "touch" };
+static const char *const kStageNames[] = { "dispatch", "rendererAck", "presentation" };
+
+static std::atomic<quint64> s_nextTraceId = 1;
+
+std::optional<InputLatencyTracker::Category> InputLatencyTracker::categoryForEvent(const QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove:
+    case QEvent::HoverMove:
+#if QT_CONFIG(tabletevent)
+    case QEvent::TabletPress:
+    case QEvent::TabletRelease:
+    case QEvent::TabletMove:
+#endif
+        return Mouse;
+    case QEvent::Wheel:
+        return Wheel;
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+        return Keyboard;
+    case QEvent::TouchBegin:
+    case QEvent::TouchUpdate:
+    case QEvent::TouchEnd:
+    case QEvent::TouchCancel:
+        return Touch;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<InputLatencyTracker::Category> InputLatencyTracker::categoryForEvent(const blink::WebInputEvent &event)
+{
+    const blink::WebInputEvent::Type type = event.GetType();
+    if (type == blink::WebInputEvent::Type::kMouseWheel)
+        return Wheel;
+    if (blink::WebInputEvent::IsMouseEventType(type))
+        return Mouse;
+    if (blink::WebInputEvent::IsKeyboardEventType(type))
+        return Keyboard;
+    if (blink::WebInputEvent::IsTouchEventType(type))
+        return Touch;
+    return std::nullopt;
+}
+
+void InputLatencyTracker::Histogram::add(base::TimeDelta latency)
+{
+    const double ms = latency.InMillisecondsF();
+    const auto limit = std::lower_bound(kBucketLimitsMs.begin(), kBucketLimitsMs.end(), ms);
+    ++buckets[limit - kBucketLimitsMs.begin()];
+    ++count;
+    totalMs += ms;
+    maxMs = std::max(maxMs, ms);
+}
+
+QVariantMap InputLatencyTracker::Histogram::toVariantMap() const
+{
+    QVariantList bucketList;
+    for (quint64 bucket : buckets)
+        bucketList.append(bucket);
+    return QVariantMap{
+        { u"count"_s, count },
+        { u"meanMs"_s, count ? totalMs / count : 0.0 },
+        { u"maxMs"_s, maxMs },
+        { u"buckets"_s, bucketList },
+    };
+}
+
+void InputLatencyTracker::eventReceived(Category category, base::TimeTicks time)
+{
+    QMutexLocker locker(&m_mutex);
+    dropStaleEntries(time);
+    std::deque<Entry> &pending = m_pending[category];
+    if (pending.size() == kMaxPendingEvents) {
+        pending.pop_front();
+        ++m_dropped;
+    }
+    pending.push_back(Entry{ s_nextTraceId++, time, {}, {}, {} });
+}
+
+void InputLatencyTracker::eventConverted(const QEvent *event, base::TimeTicks eventTime)
+{
+    const std::optional<Category> category = categoryForEvent(event);
+    if (!category)
+        return;
+    QMutexLocker locker(&m_mutex);
+    // A Qt event may be converted into several web events, they all share one timestamp.
+    // When a pending web event is coalesced with a later one, it takes the timestamp of the
+    // later one and the earlier Qt event keeps the one it was converted with.
+    std::deque<Entry> &pending = m_pending[*category];
+    if (!pending.empty() && pending.back().eventTime.is_null())
+        pending.back().eventTime = eventTime;
+}
+
+InputLatencyTracker::Entry *InputLatencyTracker::findEntry(Category category,
+                                                           const blink::WebInputEvent &event)
+{
+    std::deque<Entry> &pending = m_pending[category];
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+        if (it->eventTime == event.TimeStamp())
+            return &*it;
+    }
+    return nullptr;
+}
+
+void InputLatencyTracker::eventDispatched(const blink::WebInputEvent &event, base::TimeTicks time)
+{
+    const std::optional<Category> category = categoryForEvent(event);
+    if (!category)
+        return;
+    QMutexLocker locker(&m_mutex);
+    // Events synthesized by the browser have no matching Qt event, and keyboard events may be
+    // dispatched twice, as RawKeyDown and Char.
+    if (Entry *entry = findEntry(*category, event); entry && entry->dispatched.is_null())
+        entry->dispatched = time;
+}
+
+void InputLatencyTracker::eventAcked(const blink::WebInputEvent &event, base::TimeTicks time)
+{
+    const std::optional<Category> category = categoryForEvent(event);
+    if (!category)
+        return;
+    QMutexLocker locker(&m_mutex);
+    if (Entry *entry = findEntry(*category, event);
+        entry && !entry->dispatched.is_null() && entry->acked.is_null())
+        entry->acked = time;
+}
+
+void InputLatencyTracker::framePresented(base::TimeTicks time)
+{
+    QMutexLocker locker(&m_mutex);
+    for (int category = 0; category < CategoryCount; ++category) {
+        std::deque<Entry> &pending = m_pending[category];
+        std::erase_if(pending, [&](const Entry &entry) {
+            if (entry.acked.is_null())
+                return false;
+            finishEntry(Category(category), entry,
+                        time - entry.acked <= kPresentationTimeout ? time : base::TimeTicks());
+            return true;
+        });
+    }
+    dropStaleEntries(time);
+}
+
+void InputLatencyTracker::finishEntry(Category category, const Entry &entry, base::TimeTicks presented)
+{
+    auto &histograms = m_histograms[category];
+    histograms[Dispatch].add(entry.dispatched - entry.received);
+    histograms[RendererAck].add(entry.acked - entry.received);
+    if (!presented.is_null())
+        histograms[Presentation].add(presented - entry.received);
+
+    const base::TimeTicks end = presented.is_null() ? entry.acked : presented;
+    const auto id = TRACE_ID_LOCAL(entry.id);
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP1("input", "QtWebEngine::InputLatency", id,
+                                                     entry.received, "type", kCategoryNames[category]);
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0("input", "Dispatch", id, entry.received);
+    TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0("input", "Dispatch", id, entry.dispatched);
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0("input", "RendererAck", id, entry.dispatched);
+    TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0("input", "RendererAck", id, entry.acked);
+    if (!presented.is_null()) {
+        TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0("input", "Presentation", id, entry.acked);
+        TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0("input", "Presentation", id, presented);
+    }
+    TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0("input", "QtWebEngine::InputLatency", id, end);
+}
+
+void InputLatencyTracker::dropStaleEntries(base::TimeTicks now)
+{
+    for (std::deque<Entry> &pending : m_pending) {
+        while (!pending.empty() && pending.front().acked.is_null()
+               && now - pending.front().received > kPendingTimeout) {
+            pending.pop_front();
+            ++m_dropped;
+        }
+    }
+}
+
+QVariantMap InputLatencyTracker::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    QVariantList bucketLimits;
+    for (int limit : kBucketLimitsMs)
+        bucketLimits.append(limit);
+    QVariantMap statistics{
+        { u"bucketLimitsMs"_s, bucketLimits },
+        { u"dropped"_s, m_dropped },
+    };
+    for (int category = 0; category < CategoryCount; ++category) {
+        QVariantMap stages;
+        for (int stage = 0; stage < StageCount; ++stage)
+            stages.insert(QLatin1StringView(kStageNames[stage]),
+                          m_histograms[category][stage].toVariantMap());
+        statistics.insert(QLatin1StringView(kCategoryNames[category]), stages);
+    }
+    return statistics;
+}
+
+void InputLatencyTracker::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_histograms = {};
+    m_dropped = 0;
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,105 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef INPUT_LATENCY_TRACKER_H
+#define INPUT_LATENCY_TRACKER_H
+
+#include "base/time/time.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qvariant.h>
+
+#include <array>
+#include <deque>
+#include <optional>
+
+QT_FORWARD_DECLARE_CLASS(QEvent)
+
+namespace blink {
+class WebInputEvent;
+}
+
+namespace QtWebEngineCore {
+
+// Follows input events of a view from their arrival as Qt events, over their dispatch to the
+// renderer and the renderer's acknowledgement, to the swap of the first frame after it.
+//
+// The input event observers of Chromium only see the web events, so the timestamp a web event
+// is created with serves as its ID: it is recorded with the Qt event it was converted from, and
+// the dispatch and acknowledgement of a web event are attributed to the Qt event with exactly
+// that timestamp. Coalescing keeps the timestamp of the latest event. Events which never make
+// it to the renderer, for instance because they were coalesced, are dropped after a while.
+//
+// Finished events are added to per-stage histograms and, when the "input" tracing category
+// is enabled, reported as nested async trace events.
+//
+// Frames may be swapped on the render thread of Qt Quick, so all methods are thread-safe.
+class InputLatencyTracker
+{
+public:
+    enum Category { Mouse, Wheel, Keyboard, Touch, CategoryCount };
+    // Each stage is measured from the arrival of the Qt event.
+    enum Stage { Dispatch, RendererAck, Presentation, StageCount };
+
+    static constexpr std::array<int, 11> kBucketLimitsMs = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024 };
+
+    static std::optional<Category> categoryForEvent(const QEvent *event);
+    static std::optional<Category> categoryForEvent(const blink::WebInputEvent &event);
+
+    void eventReceived(Category category, base::TimeTicks time);
+    // Called for each web event converted from the Qt event that was received last.
+    void eventConverted(const QEvent *event, base::TimeTicks eventTime);
+    void eventDispatched(const blink::WebInputEvent &event, base::TimeTicks time);
+    void eventAcked(const blink::WebInputEvent &event, base::TimeTicks time);
+    void framePresented(base::TimeTicks time);
+
+    QVariantMap statistics() const;
+    void reset();
+
+private:
+    struct Entry
+    {
+        quint64 id;
+        base::TimeTicks received;
+        // The timestamp of the web events converted from the Qt event.
+        base::TimeTicks eventTime;
+        base::TimeTicks dispatched;
+        base::TimeTicks acked;
+    };
+
+    struct Histogram
+    {
+        // The last bucket holds everything above the last limit.
+        std::array<quint64, kBucketLimitsMs.size() + 1> buckets = {};
+        quint64 count = 0;
+        double totalMs = 0;
+        double maxMs = 0;
+
+        void add(base::TimeDelta latency);
+        QVariantMap toVariantMap() const;
+    };
+
+    Entry *findEntry(Category category, const blink::WebInputEvent &event);
+    void finishEntry(Category category, const Entry &entry, base::TimeTicks presented);
+    void dropStaleEntries(base::TimeTicks now);
+
+    mutable QMutex m_mutex;
+    std::array<std::deque<Entry>, CategoryCount> m_pending;
+    std::array<std::array<Histogram, StageCount>, CategoryCount> m_histograms;
+    quint64 m_dropped = 0;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // INPUT_LATENCY_TRACKER_H
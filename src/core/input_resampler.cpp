@@ -0,0 +1,298 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "input_resampler.h"
+
+#include "render_widget_host_view_qt.h"
+#include "web_contents_adapter_client.h"
+
+#include "components/viz/common/frame_sinks/begin_frame_args.h"
+#include "ui/compositor/compositor.h"
+#include "ui/events/base_event_utils.h"
+
+#include <QtWebEngineCore/qwebenginesettings.h>
+
+using namespace Qt::StringLiterals;
+
+namespace QtWebEngineCore {
+
+// Positions are not extrapolated further than this from the last sample.
+static constexpr base::TimeDelta kMaxPrediction = base::Milliseconds(8);
+// Samples further apart than this mean the pointer stopped in between.
+static constexpr base::TimeDelta kMaxSampleInterval = base::Milliseconds(20);
+static constexpr std::chrono::milliseconds kFallbackInterval(33);
+
+static const char *const kInputTypeNames[] = { "mouse", "wheel", "touch" };
+
+void InputResampler::History::add(const gfx::PointF &position, base::TimeTicks time)
+{
+    previousPosition = lastPosition;
+    previousTime = lastTime;
+    lastPosition = position;
+    lastTime = time;
+}
+
+std::optional<gfx::Vector2dF> InputResampler::History::predict(base::TimeTicks target) const
+{
+    const base::TimeDelta interval = lastTime - previousTime;
+    if (previousTime.is_null() || !interval.is_positive() || interval > kMaxSampleInterval)
+        return std::nullopt;
+    const base::TimeDelta horizon = std::min(target - lastTime, kMaxPrediction);
+    if (!horizon.is_positive())
+        return std::nullopt;
+    const gfx::Vector2dF velocity = lastPosition - previousPosition;
+    return gfx::ScaleVector2d(velocity, horizon / interval);
+}
+
+InputResampler::InputResampler(RenderWidgetHostViewQt *rwhv) : m_rwhv(rwhv)
+{
+    m_fallbackTimer.setSingleShot(true);
+    m_fallbackTimer.setTimerType(Qt::PreciseTimer);
+    m_fallbackTimer.setInterval(kFallbackInterval);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &InputResampler::flush);
+}
+
+InputResampler::~InputResampler()
+{
+    if (m_observedCompositor)
+        m_observedCompositor->RemoveAnimationObserver(this);
+}
+
+bool InputResampler::isEnabled() const
+{
+    WebContentsAdapterClient *client = m_rwhv->adapterClient();
+    return client
+            && client->webEngineSettings()->testAttribute(QWebEngineSettings::InputResamplingEnabled);
+}
+
+bool InputResampler::queueMouseEvent(const blink::WebMouseEvent &event)
+{
+    if (event.GetType() != blink::WebInputEvent::Type::kMouseMove || !isEnabled()) {
+        flush();
+        return false;
+    }
+
+    ++m_counters[Mouse].received;
+    m_mouseHistory.add(event.PositionInWidget(), event.TimeStamp());
+    if (m_pendingMouseEvent && m_pendingMouseEvent->CanCoalesce(event)) {
+        m_pendingMouseEvent->Coalesce(event);
+        ++m_counters[Mouse].coalesced;
+        return true;
+    }
+    flush();
+    m_pendingMouseEvent = event;
+    schedule();
+    return true;
+}
+
+void InputResampler::queueWheelEvent(const blink::WebMouseWheelEvent &event)
+{
+    ++m_counters[Wheel].received;
+    if (m_pendingWheelEvent && m_pendingWheelEvent->CanCoalesce(event)) {
+        m_pendingWheelEvent->Coalesce(event);
+        ++m_counters[Wheel].coalesced;
+        return;
+    }
+    flush();
+    m_pendingWheelEvent = event;
+    schedule();
+}
+
+bool InputResampler::queueMotionEvent(const ui::MotionEvent &event)
+{
+    if (event.GetAction() != ui::MotionEvent::Action::MOVE || !isEnabled()) {
+        flush();
+        if (event.GetAction() == ui::MotionEvent::Action::DOWN)
+            m_touchHistory.clear();
+        return false;
+    }
+
+    ++m_counters[Touch].received;
+    for (size_t i = 0; i < event.GetPointerCount(); ++i)
+        m_touchHistory[event.GetPointerId(i)].add(gfx::PointF(event.GetX(i), event.GetY(i)),
+                                                  event.GetEventTime());
+
+    // The latest move carries the current position of all pointers, as long as no pointer was
+    // added or removed in the meantime.
+    bool samePointers = m_pendingMotionEvent
+            && m_pendingMotionEvent->GetPointerCount() == event.GetPointerCount();
+    for (size_t i = 0; samePointers && i < event.GetPointerCount(); ++i)
+        samePointers = m_pendingMotionEvent->GetPointerId(i) == event.GetPointerId(i);
+    if (samePointers)
+        ++m_counters[Touch].coalesced;
+    else
+        flush();
+    m_pendingMotionEvent = ui::MotionEventGeneric::CloneEvent(event);
+    schedule();
+    return true;
+}
+
+void InputResampler::flush()
+{
+    if (!hasPending())
+        return;
+    for (int type = 0; type < InputTypeCount; ++type)
+        deliver(InputType(type), base::TimeTicks());
+    unschedule();
+}
+
+void InputResampler::onBeginFrame(const viz::BeginFrameArgs &args)
+{
+    if (!hasPending() || args.type == viz::BeginFrameArgs::MISSED)
+        return;
+    // Input delivered now is rendered into the frame after this one's deadline.
+    const base::TimeTicks presentationTime = args.frame_time + args.interval;
+    for (int type = 0; type < InputTypeCount; ++type)
+        deliver(InputType(type), presentationTime);
+    // Predicted positions are corrected at the next BeginFrame if no newer event came in.
+    if (hasPending())
+        schedule();
+    else
+        unschedule();
+}
+
+void InputResampler::OnCompositingShuttingDown(ui::Compositor *compositor)
+{
+    compositor->RemoveAnimationObserver(this);
+    m_observedCompositor = nullptr;
+}
+
+void InputResampler::schedule()
+{
+    if (!m_observedCompositor) {
+        if (ui::Compositor *compositor = m_rwhv->GetCompositor()) {
+            compositor->AddAnimationObserver(this);
+            m_observedCompositor = compositor;
+        }
+    }
+    if (!m_fallbackTimer.isActive())
+        m_fallbackTimer.start();
+}
+
+void InputResampler::unschedule()
+{
+    m_fallbackTimer.stop();
+    if (m_observedCompositor) {
+        m_observedCompositor->RemoveAnimationObserver(this);
+        m_observedCompositor = nullptr;
+    }
+}
+
+bool InputResampler::hasPending() const
+{
+    return m_pendingMouseEvent || m_pendingWheelEvent || m_pendingMotionEvent
+            || m_uncorrectedMouseEvent || m_uncorrectedMotionEvent;
+}
+
+void InputResampler::deliver(InputType type, base::TimeTicks presentationTime)
+{
+    switch (type) {
+    case Mouse:
+        if (m_pendingMouseEvent) {
+            blink::WebMouseEvent event = *m_pendingMouseEvent;
+            m_pendingMouseEvent.reset();
+            m_uncorrectedMouseEvent.reset();
+            gfx::Vector2dF offset;
+            // The position does not follow the mouse while the pointer is locked.
+            if (!presentationTime.is_null() && !m_rwhv->IsPointerLocked()) {
+                if (auto prediction = m_mouseHistory.predict(presentationTime)) {
+                    offset = *prediction;
+                    m_uncorrectedMouseEvent = event;
+                    ++m_counters[Mouse].predicted;
+                }
+            }
+            ++m_counters[Mouse].delivered;
+            dispatchMouseMove(event, offset);
+        } else if (m_uncorrectedMouseEvent) {
+            blink::WebMouseEvent event = *m_uncorrectedMouseEvent;
+            m_uncorrectedMouseEvent.reset();
+            // Only the way back from the predicted position is left to move.
+            event.movement_x = 0;
+            event.movement_y = 0;
+            event.SetTimeStamp(base::TimeTicks::Now());
+            ++m_counters[Mouse].corrected;
+            dispatchMouseMove(event, gfx::Vector2dF());
+        }
+        break;
+    case Wheel:
+        if (m_pendingWheelEvent) {
+            blink::WebMouseWheelEvent event = *m_pendingWheelEvent;
+            m_pendingWheelEvent.reset();
+            ++m_counters[Wheel].delivered;
+            m_rwhv->dispatchWheelEvent(event);
+        }
+        break;
+    case Touch:
+        if (m_pendingMotionEvent) {
+            std::unique_ptr<ui::MotionEventGeneric> event = std::move(m_pendingMotionEvent);
+            m_uncorrectedMotionEvent.reset();
+            if (!presentationTime.is_null()) {
+                std::unique_ptr<ui::MotionEventGeneric> predicted;
+                for (size_t i = 0; i < event->GetPointerCount(); ++i) {
+                    auto history = m_touchHistory.constFind(event->GetPointerId(i));
+                    if (history == m_touchHistory.cend())
+                        continue;
+                    if (auto offset = history->predict(presentationTime)) {
+                        if (!predicted)
+                            predicted = ui::MotionEventGeneric::CloneEvent(*event);
+                        ui::PointerProperties &pointer = predicted->pointer(i);
+                        pointer.x += offset->x();
+                        pointer.y += offset->y();
+                        pointer.raw_x += offset->x();
+                        pointer.raw_y += offset->y();
+                    }
+                }
+                if (predicted) {
+                    m_uncorrectedMotionEvent = std::move(event);
+                    event = std::move(predicted);
+                    ++m_counters[Touch].predicted;
+                }
+            }
+            ++m_counters[Touch].delivered;
+            m_rwhv->dispatchMotionEvent(*event);
+        } else if (m_uncorrectedMotionEvent) {
+            std::unique_ptr<ui::MotionEventGeneric> event = std::move(m_uncorrectedMotionEvent);
+            // The predicted event was delivered with the ID of this one, and touch events are
+            // acknowledged by ID.
+            event->set_unique_event_id(ui::GetNextTouchEventId());
+            event->set_event_time(base::TimeTicks::Now());
+            ++m_counters[Touch].corrected;
+            m_rwhv->dispatchMotionEvent(*event);
+        }
+        break;
+    case InputTypeCount:
+        Q_UNREACHABLE();
+    }
+}
+
+// Moves the event ahead of its real position by offset, and adjusts its movement to the
+// positions the page has seen, so that both keep adding up.
+void InputResampler::dispatchMouseMove(blink::WebMouseEvent event, const gfx::Vector2dF &offset)
+{
+    const gfx::Vector2dF shift = offset - m_mouseOffset;
+    event.SetPositionInWidget(event.PositionInWidget() + offset);
+    event.SetPositionInScreen(event.PositionInScreen() + offset);
+    event.movement_x += shift.x();
+    event.movement_y += shift.y();
+    m_mouseOffset = offset;
+    m_rwhv->dispatchMouseEvent(event);
+}
+
+QVariantMap InputResampler::statistics() const
+{
+    QVariantMap statistics;
+    for (int type = 0; type < InputTypeCount; ++type) {
+        const Counters &counters = m_counters[type];
+        statistics.insert(QLatin1StringView(kInputTypeNames[type]),
+                          QVariantMap{
+                                  { u"received"_s, counters.received },
+                                  { u"delivered"_s, counters.delivered },
+                                  { u"coalesced"_s, counters.coalesced },
+                                  { u"predicted"_s, counters.predicted },
+                                  { u"corrected"_s, counters.corrected },
+                          });
+    }
+    return statistics;
+}
+
+} // namespace QtWebEngineCore
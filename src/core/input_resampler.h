@@ -0,0 +1,128 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef INPUT_RESAMPLER_H
+#define INPUT_RESAMPLER_H
+
+#include "base/time/time.h"
+#include "third_party/blink/public/common/input/web_mouse_event.h"
+#include "third_party/blink/public/common/input/web_mouse_wheel_event.h"
+#include "ui/compositor/compositor_animation_observer.h"
+#include "ui/events/velocity_tracker/motion_event_generic.h"
+#include "ui/gfx/geometry/point_f.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/qvariant.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+
+namespace viz {
+struct BeginFrameArgs;
+}
+
+namespace QtWebEngineCore {
+
+class RenderWidgetHostViewQt;
+
+// Aligns continuous input of a view with its frames when the InputResamplingEnabled setting
+// is on. Mouse moves, wheel events and touch moves arriving between two BeginFrames are
+// coalesced into a single event of each type, which is delivered at the next BeginFrame.
+// Pointer positions are extrapolated from their recent velocity to the time the frame is
+// expected to be presented, by at most kMaxPrediction. A pointer never comes to rest at an
+// extrapolated position: unless a newer event of its type supersedes a predicted one by the
+// next BeginFrame, or before any other input, the real position is delivered again.
+//
+// Any event that is not resampled, and any resampled one that cannot be coalesced with the
+// pending event of its type, delivers all pending events first. Only events of different types
+// that are pending at the same BeginFrame may change their order.
+class InputResampler : public QObject, public ui::CompositorAnimationObserver
+{
+    Q_OBJECT
+public:
+    enum InputType { Mouse, Wheel, Touch, InputTypeCount };
+
+    explicit InputResampler(RenderWidgetHostViewQt *rwhv);
+    ~InputResampler() override;
+
+    bool isEnabled() const;
+
+    // Return whether the event was taken, otherwise it has to be delivered right away.
+    bool queueMouseEvent(const blink::WebMouseEvent &event);
+    void queueWheelEvent(const blink::WebMouseWheelEvent &event);
+    bool queueMotionEvent(const ui::MotionEvent &event);
+
+    // Delivers all pending events without prediction.
+    void flush();
+
+    void onBeginFrame(const viz::BeginFrameArgs &args);
+
+    QVariantMap statistics() const;
+
+    // Overridden from ui::CompositorAnimationObserver
+    void OnAnimationStep(base::TimeTicks) override { }
+    void OnCompositingShuttingDown(ui::Compositor *compositor) override;
+
+private:
+    // The last two positions of a pointer.
+    struct History
+    {
+        gfx::PointF previousPosition;
+        base::TimeTicks previousTime;
+        gfx::PointF lastPosition;
+        base::TimeTicks lastTime;
+
+        void add(const gfx::PointF &position, base::TimeTicks time);
+        std::optional<gfx::Vector2dF> predict(base::TimeTicks target) const;
+    };
+
+    struct Counters
+    {
+        quint64 received = 0;
+        quint64 delivered = 0;
+        quint64 coalesced = 0;
+        quint64 predicted = 0;
+        quint64 corrected = 0;
+    };
+
+    void schedule();
+    void unschedule();
+    void deliver(InputType type, base::TimeTicks presentationTime);
+    void dispatchMouseMove(blink::WebMouseEvent event, const gfx::Vector2dF &offset);
+    bool hasPending() const;
+
+    RenderWidgetHostViewQt *m_rwhv;
+    ui::Compositor *m_observedCompositor = nullptr;
+    // Delivers pending events when the compositor stops producing BeginFrames.
+    QTimer m_fallbackTimer;
+
+    std::optional<blink::WebMouseEvent> m_pendingMouseEvent;
+    std::optional<blink::WebMouseWheelEvent> m_pendingWheelEvent;
+    std::unique_ptr<ui::MotionEventGeneric> m_pendingMotionEvent;
+    // The last delivered events, with their real positions, if they were predicted.
+    std::optional<blink::WebMouseEvent> m_uncorrectedMouseEvent;
+    std::unique_ptr<ui::MotionEventGeneric> m_uncorrectedMotionEvent;
+    // How far the position of the last delivered mouse move is ahead of the real one.
+    gfx::Vector2dF m_mouseOffset;
+    History m_mouseHistory;
+    QHash<int, History> m_touchHistory;
+    std::array<Counters, InputTypeCount> m_counters;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // INPUT_RESAMPLER_H
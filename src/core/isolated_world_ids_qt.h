@@ -0,0 +1,20 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef ISOLATED_WORLD_IDS_QT_H
+#define ISOLATED_WORLD_IDS_QT_H
+
+namespace QtWebEngineCore {
+
+// Isolated world IDs up to this one belong to the application, see QWebEngineScript::setWorldId().
+constexpr int kLastApplicationWorldId = 256;
+
+// World of the match index kept by QWebEnginePage::findTextMatchRects().
+constexpr int kFindMatchRectsWorldId = kLastApplicationWorldId + 1;
+
+// Extensions allocate their isolated worlds upwards from this ID.
+constexpr int kLowestExtensionWorldId = kFindMatchRectsWorldId + 1;
+
+} // namespace QtWebEngineCore
+
+#endif // ISOLATED_WORLD_IDS_QT_H
@@ -6,8 +6,7 @@
 
 #include "base/functional/bind.h"
 #include "base/functional/callback_forward.h"
-#include "content/public/browser/browser_thread.h"
-#include "content/public/browser/browser_task_traits.h"
+#include "base/task/sequenced_task_runner.h"
 #include "crypto/crypto_buildflags.h"
 #include "net/ssl/client_cert_store.h"
 #include "net/ssl/ssl_cert_request_info.h"
@@ -65,26 +64,44 @@ ClientCertStoreQt::ClientCertStoreQt(ClientCertificateStoreData *storeData)
 ClientCertStoreQt::~ClientCertStoreQt() = default;
 
 #if QT_CONFIG(ssl)
-net::ClientCertIdentityList ClientCertStoreQt::GetClientCertsOnUIThread(scoped_refptr<const net::SSLCertRequestInfo> cert_request_info)
+net::ClientCertIdentityList ClientCertStoreQt::selectInMemoryCerts(const net::SSLCertRequestInfo &cert_request_info)
 {
-    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-    const auto &clientCertOverrideData = m_storeData->extraCerts;
-
-    // Look for certificates in memory store
     net::ClientCertIdentityList selected_identities;
-    for (int i = 0; i < clientCertOverrideData.length(); i++) {
-        scoped_refptr<net::X509Certificate> cert = clientCertOverrideData[i]->certPtr;
-        if (cert) {
-            if (cert->HasExpired()) {
-                qWarning() << "Expired certificate" << clientCertOverrideData[i];
-                continue;
-            }
-            if (cert_request_info->cert_authorities.empty()
-                || cert->IsIssuedByEncoded(cert_request_info->cert_authorities)) {
-                selected_identities.push_back(std::make_unique<ClientCertIdentityQt>(
-                        cert, clientCertOverrideData[i]->keyPtr));
-            }
+    if (!m_storeData)
+        return selected_identities;
+    const std::shared_ptr<const ClientCertificateStoreData::Snapshot> snapshot = m_storeData->snapshot();
+    const auto &identities = snapshot->identities;
+
+    auto select = [&selected_identities](const ClientCertificateStoreData::Snapshot::Identity &identity) {
+        if (identity.certPtr->HasExpired()) {
+            qWarning() << "Expired certificate"
+                       << QString::fromStdString(identity.certPtr->subject().GetDisplayName());
+            return;
         }
+        selected_identities.push_back(
+                std::make_unique<ClientCertIdentityQt>(identity.certPtr, identity.keyPtr));
+    };
+
+    if (cert_request_info.cert_authorities.empty()) {
+        for (const auto &identity : identities)
+            select(identity);
+        return selected_identities;
+    }
+
+    // Look up the certificates whose issuer is encoded exactly like one of the requested
+    // authorities first, that is the common case.
+    std::vector<bool> matched(identities.size(), false);
+    for (const std::string &authority : cert_request_info.cert_authorities) {
+        const auto range = snapshot->byIssuer.equal_range(QByteArray::fromStdString(authority));
+        for (auto it = range.first; it != range.second; ++it)
+            matched[*it] = true;
+    }
+    // Any other certificate may still have been issued by one of the authorities under a
+    // differently encoded name, let the full comparison, which normalizes the names, decide.
+    // Selecting in the order of the store keeps it independent of which way matched.
+    for (size_t i = 0; i < identities.size(); ++i) {
+        if (matched[i] || identities[i].certPtr->IsIssuedByEncoded(cert_request_info.cert_authorities))
+            select(identities[i]);
     }
     return selected_identities;
 }
@@ -107,7 +124,9 @@ void ClientCertStoreQt::GetClientCertsReturn(scoped_refptr<const net::SSLCertReq
                 std::move(callback), std::move(result));
         m_nativeStore->GetClientCerts(cert_request_info, std::move(callback2));
     } else {
-        std::move(callback).Run(std::move(result));
+        // Callers expect the certificates to be returned asynchronously.
+        base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+                FROM_HERE, base::BindOnce(std::move(callback), std::move(result)));
     }
 }
 
@@ -117,14 +136,9 @@ void ClientCertStoreQt::GetClientCerts(scoped_refptr<const net::SSLCertRequestIn
                                        ClientCertListCallback callback)
 {
 #if QT_CONFIG(ssl)
-    // Access the user-provided data from the UI thread, but return on whatever thread this is.
-    bool ok = content::GetUIThreadTaskRunner({})->PostTaskAndReplyWithResult(
-            FROM_HERE,
-            base::BindOnce(&ClientCertStoreQt::GetClientCertsOnUIThread,
-                           base::Unretained(this), cert_request_info),
-            base::BindOnce(&ClientCertStoreQt::GetClientCertsReturn,
-                           base::Unretained(this), cert_request_info, std::move(callback)));
-    DCHECK(ok); // callback is already moved and we can't really recover here.
+    // The in-memory certificates are read from a snapshot of the store, so they can be
+    // selected right away on whatever thread this is.
+    GetClientCertsReturn(cert_request_info, std::move(callback), selectInMemoryCerts(*cert_request_info));
 #else
     if (m_nativeStore)
         m_nativeStore->GetClientCerts(cert_request_info, std::move(callback));
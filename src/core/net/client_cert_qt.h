@@ -25,7 +25,7 @@ public:
                         ClientCertListCallback callback) override;
 private:
     static std::unique_ptr<net::ClientCertStore> createNativeStore();
-    net::ClientCertIdentityList GetClientCertsOnUIThread(scoped_refptr<const net::SSLCertRequestInfo> cert_request_info);
+    net::ClientCertIdentityList selectInMemoryCerts(const net::SSLCertRequestInfo &cert_request_info);
     void GetClientCertsReturn(scoped_refptr<const net::SSLCertRequestInfo> cert_request_info,
                               ClientCertListCallback callback,
                               net::ClientCertIdentityList &&result);
@@ -17,6 +17,7 @@
 #include "third_party/boringssl/src/include/openssl/evp.h"
 #include "third_party/boringssl/src/include/openssl/rsa.h"
 #include "third_party/boringssl/src/include/openssl/pem.h"
+#include "third_party/boringssl/src/include/openssl/x509.h"
 
 #include "QtCore/qbytearray.h"
 
@@ -25,18 +26,11 @@ namespace {
 class SSLPlatformKeyQt : public net::ThreadedSSLPrivateKey::Delegate
 {
 public:
+    // The key is parsed once and used for all handshakes the certificate is selected for.
     SSLPlatformKeyQt(const QByteArray &sslKeyInBytes)
     {
-        m_mem = BIO_new_mem_buf(sslKeyInBytes, -1);
-        m_key = PEM_read_bio_PrivateKey(m_mem, nullptr, nullptr, nullptr);
-    }
-
-    ~SSLPlatformKeyQt() override
-    {
-        if (m_key)
-            EVP_PKEY_free(m_key);
-        if (m_mem)
-            BIO_free(m_mem);
+        bssl::UniquePtr<BIO> mem(BIO_new_mem_buf(sslKeyInBytes.constData(), sslKeyInBytes.size()));
+        m_key.reset(PEM_read_bio_PrivateKey(mem.get(), nullptr, nullptr, nullptr));
     }
 
     net::Error Sign(uint16_t algorithm, base::span<const uint8_t> input, std::vector<uint8_t> *signature) override
@@ -45,7 +39,7 @@ public:
         EVP_PKEY_CTX *pctx;
         if (!EVP_DigestSignInit(ctx.get(), &pctx,
                                 SSL_get_signature_algorithm_digest(algorithm),
-                                nullptr, m_key)) {
+                                nullptr, m_key.get())) {
             return net::ERR_SSL_CLIENT_AUTH_SIGNATURE_FAILED;
         }
 
@@ -67,15 +61,14 @@ public:
 
     std::vector<uint16_t> GetAlgorithmPreferences() override
     {
-        return net::SSLPrivateKey::DefaultAlgorithmPreferences(EVP_PKEY_id(m_key),
+        return net::SSLPrivateKey::DefaultAlgorithmPreferences(EVP_PKEY_id(m_key.get()),
                                                                /* supports pss */ true);
     }
     std::string GetProviderName() override {
         return "qtwebengine";
     }
 private:
-    EVP_PKEY *m_key;
-    BIO *m_mem;
+    bssl::UniquePtr<EVP_PKEY> m_key;
 };
 
 scoped_refptr<net::SSLPrivateKey> wrapOpenSSLPrivateKey(const QByteArray &sslKeyInBytes)
@@ -88,6 +81,21 @@ scoped_refptr<net::SSLPrivateKey> wrapOpenSSLPrivateKey(const QByteArray &sslKey
                 net::GetSSLPlatformKeyTaskRunner());
 }
 
+QByteArray issuerNameInDer(const QByteArray &certInBytes)
+{
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(certInBytes.constData());
+    bssl::UniquePtr<X509> x509(d2i_X509(nullptr, &data, certInBytes.size()));
+    if (!x509)
+        return QByteArray();
+    uint8_t *issuer = nullptr;
+    const int length = i2d_X509_NAME(X509_get_issuer_name(x509.get()), &issuer);
+    if (length <= 0)
+        return QByteArray();
+    QByteArray result(reinterpret_cast<const char *>(issuer), length);
+    OPENSSL_free(issuer);
+    return result;
+}
+
 } // namespace
 
 namespace QtWebEngineCore {
@@ -104,6 +112,7 @@ void ClientCertificateStoreData::add(const QSslCertificate &certificate, const Q
     data->key = privateKey;
     data->certificate = certificate;
     extraCerts.append(data);
+    updateSnapshot();
 }
 
 void ClientCertificateStoreData::remove(const QSslCertificate &certificate)
@@ -118,12 +127,36 @@ void ClientCertificateStoreData::remove(const QSslCertificate &certificate)
         }
         ++it;
     }
+    updateSnapshot();
 }
 
 void ClientCertificateStoreData::clear()
 {
     qDeleteAll(extraCerts);
     extraCerts.clear();
+    updateSnapshot();
+}
+
+std::shared_ptr<const ClientCertificateStoreData::Snapshot> ClientCertificateStoreData::snapshot() const
+{
+    QMutexLocker locker(&m_snapshotMutex);
+    return m_snapshot;
+}
+
+void ClientCertificateStoreData::updateSnapshot()
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    for (const Entry *entry : std::as_const(extraCerts)) {
+        if (!entry->certPtr)
+            continue;
+        const QByteArray issuer = issuerNameInDer(entry->certificate.toDer());
+        if (!issuer.isEmpty())
+            snapshot->byIssuer.insert(issuer, snapshot->identities.size());
+        snapshot->identities.push_back(Snapshot::Identity{ entry->certPtr, entry->keyPtr });
+    }
+
+    QMutexLocker locker(&m_snapshotMutex);
+    m_snapshot = std::move(snapshot);
 }
 
 } // namespace QtWebEngineCore
@@ -11,10 +11,16 @@
 #if QT_CONFIG(ssl)
 #include "base/memory/ref_counted.h"
 
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
 #include <QtNetwork/qsslcertificate.h>
 #include <QtNetwork/qsslkey.h>
 
+#include <memory>
+#include <vector>
+
 namespace net {
 class SSLPrivateKey;
 class X509Certificate;
@@ -32,11 +38,35 @@ struct ClientCertificateStoreData
         scoped_refptr<net::SSLPrivateKey> keyPtr;
     };
 
+    // An immutable copy of the parsed identities in the store, which can be used on any
+    // thread. It is replaced whenever the store changes.
+    struct Snapshot
+    {
+        struct Identity
+        {
+            scoped_refptr<net::X509Certificate> certPtr;
+            scoped_refptr<net::SSLPrivateKey> keyPtr;
+        };
+
+        // In the order they were added to the store.
+        std::vector<Identity> identities;
+        // Indices into identities by the DER encoding of the issuer's distinguished name.
+        QMultiHash<QByteArray, size_t> byIssuer;
+    };
+
     void add(const QSslCertificate &certificate, const QSslKey &privateKey);
     void remove(const QSslCertificate &certificate);
     void clear();
 
+    std::shared_ptr<const Snapshot> snapshot() const;
+
     QList<Entry *> extraCerts;
+
+private:
+    void updateSnapshot();
+
+    mutable QMutex m_snapshotMutex;
+    std::shared_ptr<const Snapshot> m_snapshot = std::make_shared<const Snapshot>();
 };
 
 } // namespace QtWebEngineCore
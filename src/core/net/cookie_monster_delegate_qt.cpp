@@ -5,6 +5,8 @@
 #include "cookie_monster_delegate_qt.h"
 
 #include "base/functional/bind.h"
+#include "base/strings/string_util.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "net/cookies/cookie_util.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 
@@ -89,11 +91,49 @@ void CookieMonsterDelegateQt::getAllCookies()
     m_mojoCookieManager->GetAllCookies(net::CookieStore::GetAllCookiesCallback());
 }
 
-void CookieMonsterDelegateQt::setCookie(const QNetworkCookie &cookie, const QUrl &origin)
+void CookieMonsterDelegateQt::getCookies(const QWebEngineCookieStore::CookieQuery &query,
+                                         const std::function<void(const QList<QNetworkCookie> &)> &callback)
 {
     Q_ASSERT(hasCookieMonster());
-    Q_ASSERT(m_client);
 
+    // The cookie manager can only filter by URL, which does not cover domain-wide or
+    // expiry queries, so the filtering happens here on the already batched result.
+    // If the cookie manager goes away first, the callback still runs, with no cookies.
+    m_mojoCookieManager->GetAllCookies(mojo::WrapCallbackWithDefaultInvokeIfNotRun(base::BindOnce(
+            [](const QWebEngineCookieStore::CookieQuery &query,
+               const std::function<void(const QList<QNetworkCookie> &)> &callback,
+               const net::CookieList &cookies) {
+                // Like a cookie domain, the domain may be given with a leading dot.
+                QString queryDomain = query.domain.toLower();
+                while (queryDomain.startsWith(u'.'))
+                    queryDomain.remove(0, 1);
+                const std::string domain = queryDomain.toStdString();
+                const std::string subdomainSuffix = '.' + domain;
+                const std::string name = query.name.toStdString();
+                const bool checkExpiry = query.expiresBefore.isValid();
+                const base::Time expiresBefore = checkExpiry ? toTime(query.expiresBefore) : base::Time();
+
+                QList<QNetworkCookie> result;
+                for (const net::CanonicalCookie &cookie : cookies) {
+                    if (!domain.empty()) {
+                        const std::string cookieDomain = cookie.DomainWithoutDot();
+                        if (cookieDomain != domain && !base::EndsWith(cookieDomain, subdomainSuffix))
+                            continue;
+                    }
+                    if (!name.empty() && cookie.Name() != name)
+                        continue;
+                    if (checkExpiry && (!cookie.IsPersistent() || cookie.ExpiryDate() >= expiresBefore))
+                        continue;
+                    result.append(toQt(cookie));
+                }
+                if (callback)
+                    callback(result);
+            },
+            query, callback), net::CookieList()));
+}
+
+bool CookieMonsterDelegateQt::setCookieImpl(const QNetworkCookie &cookie, const QUrl &origin)
+{
     GURL gurl = origin.isEmpty() ? sourceUrlForCookie(cookie) : toGurl(origin);
     std::string cookie_line = cookie.toRawForm().toStdString();
 
@@ -101,21 +141,17 @@ void CookieMonsterDelegateQt::setCookie(const QNetworkCookie &cookie, const QUrl
     auto canonCookie = net::CanonicalCookie::Create(gurl, cookie_line, base::Time::Now(),
                                                     std::nullopt, std::nullopt,
                                                     net::CookieSourceType::kOther, &inclusion);
-    if (!canonCookie || !inclusion.IsInclude()) {
-        LOG(WARNING) << "QWebEngineCookieStore::setCookie() - Tried to set invalid cookie";
-        return;
-    }
+    if (!canonCookie || !inclusion.IsInclude())
+        return false;
     net::CookieOptions options;
     options.set_include_httponly();
     options.set_same_site_cookie_context(net::CookieOptions::SameSiteCookieContext::MakeInclusiveForSet());
     m_mojoCookieManager->SetCanonicalCookie(*canonCookie.get(), gurl, options, net::CookieStore::SetCookiesCallback());
+    return true;
 }
 
-void CookieMonsterDelegateQt::deleteCookie(const QNetworkCookie &cookie, const QUrl &origin)
+void CookieMonsterDelegateQt::deleteCookieImpl(const QNetworkCookie &cookie, const QUrl &origin)
 {
-    Q_ASSERT(hasCookieMonster());
-    Q_ASSERT(m_client);
-
     GURL gurl = origin.isEmpty() ? sourceUrlForCookie(cookie) : toGurl(origin);
     std::string cookie_name = cookie.name().toStdString();
     auto filter = network::mojom::CookieDeletionFilter::New();
@@ -124,6 +160,49 @@ void CookieMonsterDelegateQt::deleteCookie(const QNetworkCookie &cookie, const Q
     m_mojoCookieManager->DeleteCookies(std::move(filter), network::mojom::CookieManager::DeleteCookiesCallback());
 }
 
+void CookieMonsterDelegateQt::setCookie(const QNetworkCookie &cookie, const QUrl &origin)
+{
+    Q_ASSERT(hasCookieMonster());
+    Q_ASSERT(m_client);
+
+    if (!setCookieImpl(cookie, origin))
+        LOG(WARNING) << "QWebEngineCookieStore::setCookie() - Tried to set invalid cookie";
+}
+
+void CookieMonsterDelegateQt::deleteCookie(const QNetworkCookie &cookie, const QUrl &origin)
+{
+    Q_ASSERT(hasCookieMonster());
+    Q_ASSERT(m_client);
+
+    deleteCookieImpl(cookie, origin);
+}
+
+// The cookie manager interface has no bulk setter or multi-name deletion filter, so the
+// batch is written back-to-back into the message pipe from one task. The network service
+// then processes it as one uninterrupted run of messages.
+void CookieMonsterDelegateQt::setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin)
+{
+    Q_ASSERT(hasCookieMonster());
+    Q_ASSERT(m_client);
+
+    qsizetype invalid = 0;
+    for (const QNetworkCookie &cookie : cookies) {
+        if (!setCookieImpl(cookie, origin))
+            ++invalid;
+    }
+    if (invalid)
+        LOG(WARNING) << "QWebEngineCookieStore::setCookies() - Tried to set " << invalid << " invalid cookie(s)";
+}
+
+void CookieMonsterDelegateQt::deleteCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin)
+{
+    Q_ASSERT(hasCookieMonster());
+    Q_ASSERT(m_client);
+
+    for (const QNetworkCookie &cookie : cookies)
+        deleteCookieImpl(cookie, origin);
+}
+
 void CookieMonsterDelegateQt::deleteSessionCookies()
 {
     Q_ASSERT(hasCookieMonster());
@@ -34,10 +34,12 @@
 #undef StAsH_signals
 #endif
 
+#include <QList>
 #include <QPointer>
 
-QT_FORWARD_DECLARE_CLASS(QNetworkCookie)
-QT_FORWARD_DECLARE_CLASS(QWebEngineCookieStore)
+#include <functional>
+
+#include "api/qwebenginecookiestore.h"
 
 namespace QtWebEngineCore {
 
@@ -62,7 +64,11 @@ public:
 
     void setCookie(const QNetworkCookie &cookie, const QUrl &origin);
     void deleteCookie(const QNetworkCookie &cookie, const QUrl &origin);
+    void setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin);
+    void deleteCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin);
     void getAllCookies();
+    void getCookies(const QWebEngineCookieStore::CookieQuery &query,
+                    const std::function<void(const QList<QNetworkCookie> &)> &callback);
     void deleteSessionCookies();
     void deleteAllCookies();
 
@@ -76,6 +82,10 @@ public:
 
     void AddStore(net::CookieStore *store);
     void OnCookieChanged(const net::CookieChangeInfo &change);
+
+private:
+    bool setCookieImpl(const QNetworkCookie &cookie, const QUrl &origin);
+    void deleteCookieImpl(const QNetworkCookie &cookie, const QUrl &origin);
 };
 
 } // namespace QtWebEngineCore
@@ -4,6 +4,7 @@
 
 #include "custom_url_loader_factory.h"
 
+#include "base/strings/string_split.h"
 #include "base/strings/stringprintf.h"
 #include "content/browser/web_contents/web_contents_impl.h"
 #include "content/public/browser/browser_task_traits.h"
@@ -24,6 +25,7 @@
 #include "url/url_util_qt.h"
 
 #include "api/qwebengineurlscheme.h"
+#include "net/qrc_url_scheme_handler.h"
 #include "net/url_request_custom_job_proxy.h"
 #include "profile_adapter.h"
 #include "qwebengineloadinginfo.h"
@@ -32,10 +34,12 @@
 #include "web_contents_delegate_qt.h"
 #include "web_contents_view_qt.h"
 
+#include <QtCore/qbuffer.h>
 #include <QtCore/qbytearray.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qlocale.h>
 #include <QtCore/qmimedatabase.h>
 #include <QtCore/qmimedata.h>
 #include <QtCore/qpointer.h>
@@ -157,6 +161,11 @@ private:
         if (ParseRange(m_request.headers))
             m_firstBytePosition = m_byteRange.first_byte_position();
 
+        // The qrc scheme is always handled by the built-in QrcUrlSchemeHandler, serve it directly
+        // on the IO thread instead of going through a QWebEngineUrlRequestJob on the UI thread.
+        if (m_request.url.SchemeIs("qrc"))
+            return StartQrc();
+
 //        m_taskRunner->PostTask(FROM_HERE,
         content::GetUIThreadTaskRunner({})->PostTask(
                 FROM_HERE,
@@ -165,6 +174,77 @@ private:
                                m_request.request_body));
     }
 
+    void StartQrc()
+    {
+        DCHECK(m_taskRunner->RunsTasksInCurrentSequence());
+        if (m_request.method != net::HttpRequestHeaders::kGetMethod)
+            return notifyStartFailure(net::ERR_ACCESS_DENIED);
+
+        const QString path = toQt(m_request.url).path();
+        m_qrcResource = QrcUrlSchemeHandler::resource(path);
+        if (!m_qrcResource) {
+            qWarning("QResource '%s' not found or is empty", qUtf8Printable(path));
+            return notifyStartFailure(net::ERR_FILE_NOT_FOUND);
+        }
+
+        m_mimeType = m_qrcResource->mimeType;
+        m_validatorHeaders = base::StringPrintf("ETag: %s\n", m_qrcResource->etag.c_str());
+        if (m_qrcResource->lastModified.isValid()) {
+            const QString lastModified = QLocale::c().toString(
+                    m_qrcResource->lastModified.toUTC(), u"ddd, dd MMM yyyy hh:mm:ss 'GMT'");
+            m_validatorHeaders += "Last-Modified: " + lastModified.toStdString() + "\n";
+        }
+        m_validatorHeaders += "Accept-Ranges: bytes\n";
+
+        // The buffer shares the cached data, for uncompressed resources that is the mapped
+        // resource itself.
+        m_qrcBuffer = std::make_unique<QBuffer>();
+        m_notModified = QrcNotModified();
+        if (m_notModified) {
+            m_byteRange = net::HttpByteRange();
+            m_firstBytePosition = 0;
+        } else {
+            m_qrcBuffer->setData(m_qrcResource->data);
+        }
+        m_qrcBuffer->open(QIODevice::ReadOnly);
+        m_device = m_qrcBuffer.get();
+
+        const qint64 size = m_qrcBuffer->size();
+        if (m_byteRange.IsValid() && !m_byteRange.ComputeBounds(size))
+            return notifyStartFailure(net::ERR_REQUEST_RANGE_NOT_SATISFIABLE);
+        if (m_firstBytePosition > 0)
+            m_device->seek(m_firstBytePosition);
+        notifyExpectedContentSize(size);
+        notifyHeadersComplete();
+    }
+
+    bool QrcNotModified() const
+    {
+        if (std::optional<std::string> ifNoneMatch = m_request.headers.GetHeader(net::HttpRequestHeaders::kIfNoneMatch)) {
+            // If-None-Match uses the weak comparison, and takes precedence over If-Modified-Since.
+            const std::string &etag = m_qrcResource->etag;
+            for (std::string_view tag : base::SplitStringPiece(*ifNoneMatch, ",", base::TRIM_WHITESPACE,
+                                                               base::SPLIT_WANT_NONEMPTY)) {
+                if (tag.starts_with("W/"))
+                    tag.remove_prefix(2);
+                if (tag == "*" || tag == etag)
+                    return true;
+            }
+            return false;
+        }
+        if (!m_qrcResource->lastModified.isValid())
+            return false;
+        if (std::optional<std::string> ifModifiedSince = m_request.headers.GetHeader(net::HttpRequestHeaders::kIfModifiedSince)) {
+            base::Time since;
+            if (base::Time::FromUTCString(ifModifiedSince->c_str(), &since)) {
+                // HTTP dates have a resolution of seconds.
+                const qint64 lastModified = m_qrcResource->lastModified.toSecsSinceEpoch();
+                return lastModified <= since.InMillisecondsSinceUnixEpoch() / 1000;
+            }
+        }
+        return false;
+    }
+
     void CompleteWithFailure(network::CorsErrorStatus cors_error)
     {
         DCHECK(m_taskRunner->RunsTasksInCurrentSequence());
@@ -246,7 +326,9 @@ private:
             headers += "HTTP/1.1 303 See Other\n";
             headers += base::StringPrintf("Location: %s\n", m_redirect.spec().c_str());
         } else {
-            if (m_byteRange.IsValid() && m_totalSize > 0) {
+            if (m_notModified) {
+                headers += "HTTP/1.1 304 Not Modified\n";
+            } else if (m_byteRange.IsValid() && m_totalSize > 0) {
                 headers += "HTTP/1.1 206 Partial Content\n";
                 headers += net::HttpResponseHeaders::kContentRange;
                 headers += base::StringPrintf(": bytes %lld-%lld/%lld",
@@ -271,6 +353,7 @@ private:
                 headers += "Access-Control-Allow-Credentials: true\n";
             }
         }
+        headers += m_validatorHeaders;
         for (auto it = m_additionalResponseHeaders.cbegin();
              it != m_additionalResponseHeaders.cend(); ++it) {
             headers += it.key().toLower().toStdString() + ": " + it.value().toLower().toStdString()
@@ -340,6 +423,9 @@ private:
         case net::ERR_ACCESS_DENIED:
             headers = "HTTP/1.1 403 Forbidden\n";
             break;
+        case net::ERR_REQUEST_RANGE_NOT_SATISFIABLE:
+            headers = "HTTP/1.1 416 Range Not Satisfiable\n";
+            break;
         case net::ERR_FAILED:
             headers = "HTTP/1.1 400 Request Failed\n";
             break;
@@ -464,6 +550,12 @@ private:
     bool m_corsEnabled;
     bool m_isLocal;
 
+    // Requests for qrc resources served by StartQrc():
+    std::shared_ptr<const QrcUrlSchemeHandler::Resource> m_qrcResource;
+    std::unique_ptr<QBuffer> m_qrcBuffer;
+    std::string m_validatorHeaders;
+    bool m_notModified = false;
+
     base::WeakPtrFactory<CustomURLLoader> m_weakPtrFactory{this};
 };
 
@@ -0,0 +1,188 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+#include "http_cache_files_qt.h"
+
+#include "type_conversion.h"
+
+#include "net/disk_cache/simple/simple_entry_format.h"
+#include "net/http/http_cache.h"
+
+#include <QtCore/qdir.h>
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+
+#include <optional>
+
+using namespace Qt::StringLiterals;
+
+namespace QtWebEngineCore {
+namespace HttpCacheFiles {
+
+// Keys are limited by the network stack, anything longer is not a valid entry.
+static constexpr quint32 kMaxKeyLength = 64 * 1024;
+
+// The files of an entry are named after the hash of its key, with a suffix for the stream
+// they hold. The key is stored after the header of the first one.
+static const QLatin1StringView kEntryFileSuffixes[] = { "_0"_L1, "_1"_L1, "_s"_L1 };
+
+static QString importDirectory(const QString &cacheDirectory)
+{
+    return QDir::cleanPath(cacheDirectory) + ".import"_L1;
+}
+
+// Holds one URL prefix per line.
+static QString removalsFile(const QString &cacheDirectory)
+{
+    return QDir::cleanPath(cacheDirectory) + ".remove"_L1;
+}
+
+static std::optional<std::string> readEntryKey(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+    disk_cache::SimpleFileHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != qint64(sizeof(header))
+        || header.initial_magic_number != disk_cache::kSimpleInitialMagicNumber
+        || header.key_length == 0 || header.key_length > kMaxKeyLength)
+        return std::nullopt;
+    const QByteArray key = file.read(header.key_length);
+    if (key.size() != qsizetype(header.key_length))
+        return std::nullopt;
+    return key.toStdString();
+}
+
+// The network service keeps the files of the cache in a subdirectory of the cache path it is
+// given (Cache_Data), so look for entries in all subdirectories.
+template<typename Function>
+static void forEachEntry(const QString &cacheDirectory, Function function)
+{
+    QDirIterator it(cacheDirectory, { u"*_0"_s }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QFileInfo info = it.nextFileInfo();
+        const std::optional<std::string> key = readEntryKey(info.filePath());
+        if (!key)
+            continue;
+        const std::string url = net::HttpCache::GetResourceURLFromHttpCacheKey(*key);
+        if (url.empty())
+            continue;
+        const QString base = info.filePath().chopped(2);
+        function(toQt(GURL(url)), base);
+    }
+}
+
+QList<Entry> entries(const QString &cacheDirectory)
+{
+    QList<Entry> result;
+    forEachEntry(cacheDirectory, [&result](const QUrl &url, const QString &base) {
+        Entry entry{ url, 0, QDateTime() };
+        for (QLatin1StringView suffix : kEntryFileSuffixes) {
+            const QFileInfo file(base + suffix);
+            if (!file.exists())
+                continue;
+            entry.size += file.size();
+            const QDateTime modified = file.lastModified();
+            if (!entry.lastModified.isValid() || modified > entry.lastModified)
+                entry.lastModified = modified;
+        }
+        result.append(entry);
+    });
+    return result;
+}
+
+qsizetype removeEntriesWithPrefix(const QString &cacheDirectory, const QString &urlPrefix)
+{
+    qsizetype removed = 0;
+    forEachEntry(cacheDirectory, [&](const QUrl &url, const QString &base) {
+        if (!url.toString().startsWith(urlPrefix))
+            return;
+        // The first file goes last, an entry without it is not found anymore. The index of the
+        // cache is older than the directory afterwards, so it is rebuilt when the cache opens.
+        for (size_t i = 1; i < std::size(kEntryFileSuffixes); ++i)
+            QFile::remove(base + kEntryFileSuffixes[i]);
+        if (QFile::remove(base + kEntryFileSuffixes[0]))
+            ++removed;
+    });
+    return removed;
+}
+
+bool stageRemoval(const QString &cacheDirectory, const QString &urlPrefix)
+{
+    if (urlPrefix.contains(u'\n'))
+        return false;
+    QFile file(removalsFile(cacheDirectory));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+        return false;
+    return file.write(urlPrefix.toUtf8() + '\n') > 0;
+}
+
+void applyStagedRemovals(const QString &cacheDirectory)
+{
+    QFile file(removalsFile(cacheDirectory));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const QList<QByteArray> prefixes = file.readAll().split('\n');
+    file.close();
+    for (const QByteArray &prefix : prefixes) {
+        if (!prefix.isEmpty())
+            removeEntriesWithPrefix(cacheDirectory, QString::fromUtf8(prefix));
+    }
+    file.remove();
+}
+
+static bool copyDirectory(const QString &from, const QString &to)
+{
+    if (!QDir().mkpath(to))
+        return false;
+    QDirIterator it(from, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden,
+                    QDirIterator::Subdirectories);
+    const QDir source(from);
+    while (it.hasNext()) {
+        const QFileInfo info = it.nextFileInfo();
+        const QString target = to + u'/' + source.relativeFilePath(info.filePath());
+        if (info.isDir() ? !QDir().mkpath(target) : !QFile::copy(info.filePath(), target))
+            return false;
+    }
+    return true;
+}
+
+bool stageImport(const QString &snapshotDirectory, const QString &cacheDirectory)
+{
+    if (!QFileInfo(snapshotDirectory).isDir())
+        return false;
+    // A copy of a profile's cache path holds the HTTP cache in a subdirectory of the same name
+    // as the one it replaces.
+    const QString snapshotCache =
+            QDir(snapshotDirectory).filePath(QFileInfo(QDir::cleanPath(cacheDirectory)).fileName());
+    if (!QFileInfo(snapshotCache).isDir())
+        return false;
+    // Copy to a temporary directory first, so that an interrupted copy is never applied.
+    const QString staged = importDirectory(cacheDirectory);
+    const QString partial = staged + ".partial"_L1;
+    QDir(partial).removeRecursively();
+    if (!copyDirectory(snapshotCache, partial)) {
+        QDir(partial).removeRecursively();
+        return false;
+    }
+    QDir(staged).removeRecursively();
+    return QDir().rename(partial, staged);
+}
+
+bool hasStagedImport(const QString &cacheDirectory)
+{
+    return QFileInfo(importDirectory(cacheDirectory)).isDir();
+}
+
+void applyImport(const QString &cacheDirectory)
+{
+    const QString staged = importDirectory(cacheDirectory);
+    QDir(cacheDirectory).removeRecursively();
+    if (!QDir().rename(staged, cacheDirectory))
+        qWarning("Could not import the HTTP cache from %ls.", qUtf16Printable(staged));
+}
+
+} // namespace HttpCacheFiles
+} // namespace QtWebEngineCore
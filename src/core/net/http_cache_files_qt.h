@@ -0,0 +1,62 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef HTTP_CACHE_FILES_QT_H
+#define HTTP_CACHE_FILES_QT_H
+
+#include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+
+namespace QtWebEngineCore {
+
+// Direct access to the files of a disk HTTP cache in the simple cache format, which is used
+// by Chromium on all platforms we support. Entries can be listed while the network service
+// uses the cache, anything that changes the files must only run while the cache is closed.
+// Such changes are staged next to the cache and applied before it is opened the next time.
+//
+// All functions block and must run on a thread that allows it.
+namespace HttpCacheFiles {
+
+struct Entry
+{
+    QUrl url;
+    qint64 size = 0;
+    QDateTime lastModified;
+};
+
+QList<Entry> entries(const QString &cacheDirectory);
+
+// Removes the entries whose URL starts with urlPrefix from a closed cache and returns how many
+// were removed.
+qsizetype removeEntriesWithPrefix(const QString &cacheDirectory, const QString &urlPrefix);
+// Records urlPrefix so that applyStagedRemovals() removes its entries.
+bool stageRemoval(const QString &cacheDirectory, const QString &urlPrefix);
+void applyStagedRemovals(const QString &cacheDirectory);
+
+// Copies the cache in snapshotDirectory, a copy of the directory that contains cacheDirectory,
+// next to cacheDirectory. It replaces the cache the next time applyImport() is called, before
+// the cache is opened.
+bool stageImport(const QString &snapshotDirectory, const QString &cacheDirectory);
+bool hasStagedImport(const QString &cacheDirectory);
+void applyImport(const QString &cacheDirectory);
+
+} // namespace HttpCacheFiles
+} // namespace QtWebEngineCore
+
+#endif // HTTP_CACHE_FILES_QT_H
@@ -0,0 +1,306 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+#include "network_predictor_qt.h"
+
+#include "api/qwebengineurlrequestinfo_p.h"
+#include "api/qwebengineurlrequestinterceptor.h"
+#include "net/proxying_url_loader_factory_qt.h"
+#include "profile_adapter.h"
+#include "profile_qt.h"
+#include "type_conversion.h"
+
+#include "base/functional/bind.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "net/base/isolation_info.h"
+#include "net/base/load_flags.h"
+#include "net/base/network_anonymization_key.h"
+#include "net/base/schemeful_site.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_host_resolver.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+namespace QtWebEngineCore {
+
+// Warm-ups not used within this time are forgotten.
+static constexpr base::TimeDelta kWarmupLifetime = base::Minutes(5);
+static constexpr qsizetype kMaxWarmups = 256;
+
+static constexpr net::NetworkTrafficAnnotationTag kTrafficAnnotation =
+        net::DefineNetworkTrafficAnnotation("qtwebengine_network_warmup", R"(
+            semantics {
+              sender: "QWebEngineProfile"
+              description:
+                "Resolves host names, opens connections and loads resources the application "
+                "expects to be used by one of its pages soon."
+              trigger: "The application asking the profile to warm up the network."
+              data: "Anything."
+              destination: OTHER
+            }
+            policy {
+              cookies_allowed: YES
+              cookies_store: "user"
+              setting:
+                "It's possible not to use this feature."
+            })");
+
+static net::NetworkAnonymizationKey anonymizationKeyFor(const GURL &url)
+{
+    return net::NetworkAnonymizationKey::CreateSameSite(net::SchemefulSite(url));
+}
+
+NetworkPredictorQt::NetworkPredictorQt(ProfileAdapter *profileAdapter)
+    : m_profileAdapter(profileAdapter)
+{
+}
+
+NetworkPredictorQt::~NetworkPredictorQt() = default;
+
+network::mojom::NetworkContext *NetworkPredictorQt::networkContext()
+{
+    return m_profileAdapter->profile()->GetDefaultStoragePartition()->GetNetworkContext();
+}
+
+// Passes a warm-up of url to the profile's request interceptor. Returns false if it was
+// blocked, otherwise url is where the warm-up should go.
+bool NetworkPredictorQt::intercept(QUrl &url)
+{
+    QWebEngineUrlRequestInterceptor *interceptor = m_profileAdapter->requestInterceptor();
+    if (!interceptor)
+        return true;
+
+    QWebEngineUrlRequestInfo info(new QWebEngineUrlRequestInfoPrivate(
+            QWebEngineUrlRequestInfo::ResourceTypePrefetch,
+            QWebEngineUrlRequestInfo::NavigationTypeOther, url, url, QUrl(), QByteArrayLiteral("GET")));
+    interceptor->interceptRequest(info);
+    if (info.d_ptr->changed) {
+        if (info.d_ptr->shouldBlockRequest) {
+            ++m_statistics.blocked;
+            return false;
+        }
+        if (info.d_ptr->shouldRedirectRequest)
+            url = info.d_ptr->url;
+    }
+    return true;
+}
+
+template<typename Hash>
+static void removeExpired(Hash &warmups, base::TimeTicks now)
+{
+    warmups.removeIf([now](typename Hash::iterator it) { return it->expiry <= now; });
+}
+
+void NetworkPredictorQt::expireWarmups()
+{
+    const base::TimeTicks now = base::TimeTicks::Now();
+    removeExpired(m_resolvedHosts, now);
+    removeExpired(m_preconnectedOrigins, now);
+    removeExpired(m_prefetchedUrls, now);
+}
+
+void NetworkPredictorQt::preconnect(const QUrl &origin, int count)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    QUrl url = origin.adjusted(QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment
+                               | QUrl::RemoveUserInfo);
+    if (!intercept(url))
+        return;
+    const GURL gurl = toGurl(url);
+    if (!gurl.SchemeIsHTTPOrHTTPS()) {
+        qWarning("Cannot preconnect to %ls, only HTTP and HTTPS origins are supported.",
+                 qUtf16Printable(url.toDisplayString()));
+        return;
+    }
+
+    networkContext()->PreconnectSockets(uint32_t(qMax(count, 1)), gurl,
+                                        network::mojom::CredentialsMode::kInclude,
+                                        anonymizationKeyFor(gurl),
+                                        net::MutableNetworkTrafficAnnotationTag(kTrafficAnnotation),
+                                        std::nullopt);
+    ++m_statistics.preconnects;
+
+    if (m_preconnectedOrigins.size() >= kMaxWarmups)
+        expireWarmups();
+    m_preconnectedOrigins.insert(QString::fromStdString(url::Origin::Create(gurl).Serialize()),
+                                 Warmup{ base::TimeTicks::Now() + kWarmupLifetime, {} });
+}
+
+void NetworkPredictorQt::prefetchDns(const QString &host)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    QUrl url;
+    url.setScheme(QStringLiteral("https"));
+    url.setHost(host);
+    if (!url.isValid() || !intercept(url))
+        return;
+    const GURL gurl = toGurl(url);
+    if (!gurl.is_valid() || !gurl.has_host())
+        return;
+
+    network::mojom::NetworkContext *context = networkContext();
+    if (!m_hostResolver || m_resolverContext != context) {
+        m_hostResolver = network::SimpleHostResolver::Create(context);
+        m_resolverContext = context;
+    }
+
+    auto parameters = network::mojom::ResolveHostParameters::New();
+    parameters->initial_priority = net::RequestPriority::IDLE;
+    // Only fills the host cache.
+    parameters->is_speculative = true;
+    ++m_statistics.dnsPrefetches;
+    m_hostResolver->ResolveHost(
+            network::mojom::HostResolverHost::NewSchemeHostPort(url::SchemeHostPort(gurl)),
+            anonymizationKeyFor(gurl), std::move(parameters),
+            base::BindOnce(
+                    [](base::WeakPtr<NetworkPredictorQt> predictor, const QString &host,
+                       base::TimeTicks start, int result, const net::ResolveErrorInfo &,
+                       const std::optional<net::AddressList> &,
+                       const std::optional<net::HostResolverEndpointResults> &) {
+                        if (predictor)
+                            predictor->dnsPrefetchFinished(host, start, result);
+                    },
+                    m_weakPtrFactory.GetWeakPtr(), url.host(), base::TimeTicks::Now()));
+}
+
+void NetworkPredictorQt::dnsPrefetchFinished(const QString &host, base::TimeTicks start, int result)
+{
+    if (result != net::OK) {
+        ++m_statistics.dnsPrefetchFailures;
+        return;
+    }
+    if (m_resolvedHosts.size() >= kMaxWarmups)
+        expireWarmups();
+    const base::TimeTicks now = base::TimeTicks::Now();
+    m_resolvedHosts.insert(host, Warmup{ now + kWarmupLifetime, now - start });
+}
+
+void NetworkPredictorQt::prefetch(const QUrl &url, const QUrl &firstPartyUrl)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    const GURL gurl = toGurl(url);
+    if (!gurl.SchemeIsHTTPOrHTTPS()) {
+        qWarning("Cannot prefetch %ls, only HTTP and HTTPS URLs are supported.",
+                 qUtf16Printable(url.toDisplayString()));
+        return;
+    }
+
+    // Without a first party, the resource is cached as if it was navigated to. The HTTP cache
+    // is partitioned by the top-level site, so only loads within that site can use it.
+    const url::Origin topFrameOrigin =
+            url::Origin::Create(firstPartyUrl.isValid() ? toGurl(firstPartyUrl) : gurl);
+    auto request = std::make_unique<network::ResourceRequest>();
+    request->url = gurl;
+    request->method = net::HttpRequestHeaders::kGetMethod;
+    request->resource_type = int(blink::mojom::ResourceType::kPrefetch);
+    request->load_flags = net::LOAD_PREFETCH;
+    request->credentials_mode = network::mojom::CredentialsMode::kInclude;
+    request->site_for_cookies = net::SiteForCookies::FromOrigin(topFrameOrigin);
+    request->trusted_params = network::ResourceRequest::TrustedParams();
+    request->trusted_params->isolation_info = net::IsolationInfo::Create(
+            net::IsolationInfo::RequestType::kMainFrame, topFrameOrigin, topFrameOrigin,
+            request->site_for_cookies);
+
+    // Load through the interceptors of the profile, like the requests of its pages.
+    mojo::PendingRemote<network::mojom::URLLoaderFactory> targetFactory;
+    m_profileAdapter->profile()->GetDefaultStoragePartition()
+            ->GetURLLoaderFactoryForBrowserProcess()
+            ->Clone(targetFactory.InitWithNewPipeAndPassReceiver());
+    mojo::Remote<network::mojom::URLLoaderFactory> factory;
+    // Will manage its own lifetime
+    new ProxyingURLLoaderFactoryQt(m_profileAdapter, content::FrameTreeNodeId(),
+                                   factory.BindNewPipeAndPassReceiver(), std::move(targetFactory),
+                                   content::ContentBrowserClient::URLLoaderFactoryType::kPrefetch);
+
+    std::unique_ptr<network::SimpleURLLoader> loader =
+            network::SimpleURLLoader::Create(std::move(request), kTrafficAnnotation);
+    network::SimpleURLLoader *rawLoader = loader.get();
+    m_loaders.insert(rawLoader, std::move(loader));
+    ++m_statistics.prefetches;
+    // The body is only loaded to get it into the cache.
+    rawLoader->DownloadToString(
+            factory.get(),
+            base::BindOnce(
+                    [](base::WeakPtr<NetworkPredictorQt> predictor, network::SimpleURLLoader *loader,
+                       const GURL &url, base::TimeTicks start, std::optional<std::string>) {
+                        if (predictor)
+                            predictor->prefetchFinished(loader, url, start);
+                    },
+                    m_weakPtrFactory.GetWeakPtr(), rawLoader, gurl, base::TimeTicks::Now()),
+            network::SimpleURLLoader::kMaxBoundedStringDownloadSize);
+}
+
+void NetworkPredictorQt::prefetchFinished(network::SimpleURLLoader *loader, const GURL &url,
+                                          base::TimeTicks start)
+{
+    const std::unique_ptr<network::SimpleURLLoader> finished = m_loaders.take(loader);
+    if (finished->NetError() != net::OK) {
+        ++m_statistics.prefetchFailures;
+        return;
+    }
+    if (m_prefetchedUrls.size() >= kMaxWarmups)
+        expireWarmups();
+    const base::TimeTicks now = base::TimeTicks::Now();
+    // A redirected prefetch only helps requests of the final URL.
+    const GURL finalUrl = finished->GetFinalURL().is_valid() ? finished->GetFinalURL() : url;
+    m_prefetchedUrls.insert(toQt(finalUrl), Warmup{ now + kWarmupLifetime, now - start });
+}
+
+void NetworkPredictorQt::responseReceived(const GURL &url, const network::mojom::URLResponseHead &head)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    const net::LoadTimingInfo::ConnectTiming &connectTiming = head.load_timing.connect_timing;
+    const bool freshConnection = !head.load_timing.socket_reused && !connectTiming.connect_start.is_null();
+    if (freshConnection) {
+        m_connectTime += connectTiming.connect_end - connectTiming.connect_start;
+        ++m_connectCount;
+    }
+
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (!m_resolvedHosts.isEmpty()) {
+        const auto it = m_resolvedHosts.constFind(QString::fromStdString(url.host()));
+        if (it != m_resolvedHosts.cend()) {
+            if (it->expiry > now) {
+                // Whatever the lookup took now, if anything, was not saved.
+                base::TimeDelta lookupTime;
+                if (!connectTiming.domain_lookup_start.is_null())
+                    lookupTime = connectTiming.domain_lookup_end - connectTiming.domain_lookup_start;
+                ++m_statistics.dnsPrefetchHits;
+                m_statistics.dnsTimeSaved += std::max(it->duration - lookupTime, base::TimeDelta());
+            }
+            m_resolvedHosts.erase(it);
+        }
+    }
+
+    if (!m_preconnectedOrigins.isEmpty()) {
+        const auto it = m_preconnectedOrigins.constFind(
+                QString::fromStdString(url::Origin::Create(url).Serialize()));
+        if (it != m_preconnectedOrigins.cend()) {
+            if (it->expiry > now && head.load_timing.socket_reused) {
+                ++m_statistics.preconnectHits;
+                if (m_connectCount)
+                    m_statistics.preconnectTimeSaved += m_connectTime / int64_t(m_connectCount);
+            }
+            m_preconnectedOrigins.erase(it);
+        }
+    }
+
+    if (!m_prefetchedUrls.isEmpty()) {
+        const auto it = m_prefetchedUrls.constFind(toQt(url));
+        if (it != m_prefetchedUrls.cend()) {
+            if (it->expiry > now && head.was_fetched_via_cache) {
+                ++m_statistics.prefetchHits;
+                m_statistics.prefetchTimeSaved += it->duration;
+            }
+            m_prefetchedUrls.erase(it);
+        }
+    }
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,117 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:significant reason:default
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef NETWORK_PREDICTOR_QT_H
+#define NETWORK_PREDICTOR_QT_H
+
+#include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
+
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "services/network/public/mojom/url_response_head.mojom-forward.h"
+#include "url/gurl.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+
+#include <memory>
+
+namespace network {
+class SimpleHostResolver;
+class SimpleURLLoader;
+namespace mojom {
+class NetworkContext;
+}
+}
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+
+// Warms up the network context of a profile for requests the application expects: resolves
+// host names, opens connections and loads resources into the HTTP cache.
+//
+// Every warm-up is first passed to the profile's request interceptor, which may block or
+// redirect it. Prefetches are loaded through the same interceptors as requests of pages.
+//
+// The responses of later requests are matched against the warm-ups to count how many of them
+// were used and to estimate the time they saved.
+class NetworkPredictorQt
+{
+public:
+    struct Statistics
+    {
+        quint64 preconnects = 0;
+        quint64 preconnectHits = 0;
+        quint64 dnsPrefetches = 0;
+        quint64 dnsPrefetchFailures = 0;
+        quint64 dnsPrefetchHits = 0;
+        quint64 prefetches = 0;
+        quint64 prefetchFailures = 0;
+        quint64 prefetchHits = 0;
+        quint64 blocked = 0;
+        base::TimeDelta preconnectTimeSaved;
+        base::TimeDelta dnsTimeSaved;
+        base::TimeDelta prefetchTimeSaved;
+    };
+
+    explicit NetworkPredictorQt(ProfileAdapter *profileAdapter);
+    ~NetworkPredictorQt();
+
+    void preconnect(const QUrl &origin, int count);
+    void prefetchDns(const QString &host);
+    void prefetch(const QUrl &url, const QUrl &firstPartyUrl);
+
+    // Called for every response received by a page of the profile.
+    void responseReceived(const GURL &url, const network::mojom::URLResponseHead &head);
+
+    const Statistics &statistics() const { return m_statistics; }
+
+private:
+    struct Warmup
+    {
+        base::TimeTicks expiry;
+        // The time the warm-up itself took, if known.
+        base::TimeDelta duration;
+    };
+
+    network::mojom::NetworkContext *networkContext();
+    bool intercept(QUrl &url);
+    void expireWarmups();
+    void dnsPrefetchFinished(const QString &host, base::TimeTicks start, int result);
+    void prefetchFinished(network::SimpleURLLoader *loader, const GURL &url, base::TimeTicks start);
+
+    ProfileAdapter *m_profileAdapter;
+    // Recreated when the network context of the profile is reset.
+    raw_ptr<network::mojom::NetworkContext> m_resolverContext = nullptr;
+    std::unique_ptr<network::SimpleHostResolver> m_hostResolver;
+    QHash<network::SimpleURLLoader *, std::unique_ptr<network::SimpleURLLoader>> m_loaders;
+
+    QHash<QString, Warmup> m_resolvedHosts;
+    QHash<QString, Warmup> m_preconnectedOrigins;
+    QHash<QUrl, Warmup> m_prefetchedUrls;
+    // Fresh connections observed in responses, to estimate what a preconnect saves.
+    base::TimeDelta m_connectTime;
+    quint64 m_connectCount = 0;
+
+    Statistics m_statistics;
+    base::WeakPtrFactory<NetworkPredictorQt> m_weakPtrFactory{ this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // NETWORK_PREDICTOR_QT_H
@@ -7,25 +7,33 @@
 #include <utility>
 
 #include "base/functional/bind.h"
+#include "content/browser/renderer_host/render_frame_host_impl.h"
 #include "content/browser/web_contents/web_contents_impl.h"
 #include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/content_switches.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
 #include "net/base/filename_util.h"
 #include "net/http/http_status_code.h"
 #include "services/network/public/cpp/cors/cors.h"
 #include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "services/network/public/mojom/early_hints.mojom.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/url_util.h"
 #include "url/url_util_qt.h"
 
 #include "api/qwebengineurlrequestinfo_p.h"
+#include "profile_qt.h"
 #include "type_conversion.h"
 #include "web_contents_adapter.h"
 #include "web_contents_adapter_client.h"
 #include "web_contents_view_qt.h"
+#include "net/network_predictor_qt.h"
 #include "net/resource_request_body_qt.h"
+#include "net/shared_http_cache_qt.h"
 
 // originally based on aw_proxying_url_loader_factory.cc:
 // Copyright 2018 The Chromium Authors. All rights reserved.
@@ -95,6 +103,102 @@ static QHash<QByteArray, QByteArray> toQt(const net::HttpRequestHeaders &headers
     return hash;
 }
 
+// Copies a response body from the network to the client, and keeps a copy of it for the
+// shared HTTP cache as long as it is not too large.
+class ResponseBodyTee
+{
+public:
+    ResponseBodyTee(mojo::ScopedDataPipeConsumerHandle source,
+                    mojo::ScopedDataPipeProducerHandle destination,
+                    base::OnceClosure finished);
+
+    // Whether the whole body was passed on to the client.
+    bool finished() const { return !m_source.is_valid(); }
+    // The body, if it was passed on completely and is small enough to be stored.
+    std::optional<std::string> takeBody();
+
+private:
+    void OnReady(MojoResult result, const mojo::HandleSignalsState &state);
+    void Finish(bool succeeded);
+
+    mojo::ScopedDataPipeConsumerHandle m_source;
+    mojo::ScopedDataPipeProducerHandle m_destination;
+    mojo::SimpleWatcher m_sourceWatcher;
+    mojo::SimpleWatcher m_destinationWatcher;
+    base::OnceClosure m_finished;
+    std::string m_body;
+    bool m_keep = true;
+};
+
+ResponseBodyTee::ResponseBodyTee(mojo::ScopedDataPipeConsumerHandle source,
+                                 mojo::ScopedDataPipeProducerHandle destination,
+                                 base::OnceClosure finished)
+    : m_source(std::move(source))
+    , m_destination(std::move(destination))
+    , m_sourceWatcher(FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL)
+    , m_destinationWatcher(FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL)
+    , m_finished(std::move(finished))
+{
+    const auto callback = base::BindRepeating(&ResponseBodyTee::OnReady, base::Unretained(this));
+    m_sourceWatcher.Watch(m_source.get(), MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+                          callback);
+    m_destinationWatcher.Watch(m_destination.get(),
+                               MOJO_HANDLE_SIGNAL_WRITABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED, callback);
+    m_sourceWatcher.ArmOrNotify();
+}
+
+std::optional<std::string> ResponseBodyTee::takeBody()
+{
+    if (!finished() || !m_keep)
+        return std::nullopt;
+    return std::move(m_body);
+}
+
+void ResponseBodyTee::OnReady(MojoResult, const mojo::HandleSignalsState &)
+{
+    while (true) {
+        base::span<const uint8_t> buffer;
+        MojoResult result = m_source->BeginReadData(MOJO_BEGIN_READ_DATA_FLAG_NONE, buffer);
+        if (result == MOJO_RESULT_SHOULD_WAIT) {
+            m_sourceWatcher.ArmOrNotify();
+            return;
+        }
+        if (result != MOJO_RESULT_OK) {
+            // The network closes the pipe once it has written the whole body.
+            Finish(result == MOJO_RESULT_FAILED_PRECONDITION);
+            return;
+        }
+        size_t written = 0;
+        result = m_destination->WriteData(buffer, MOJO_WRITE_DATA_FLAG_NONE, written);
+        if (result != MOJO_RESULT_OK) {
+            m_source->EndReadData(0);
+            if (result == MOJO_RESULT_SHOULD_WAIT)
+                m_destinationWatcher.ArmOrNotify();
+            else
+                Finish(false); // The client stopped reading.
+            return;
+        }
+        if (m_keep && m_body.size() + written <= SharedHttpCacheQt::kMaxBodySize) {
+            m_body.append(reinterpret_cast<const char *>(buffer.data()), written);
+        } else {
+            m_keep = false;
+            m_body.clear();
+        }
+        m_source->EndReadData(written);
+    }
+}
+
+void ResponseBodyTee::Finish(bool succeeded)
+{
+    m_keep = m_keep && succeeded;
+    m_sourceWatcher.Cancel();
+    m_destinationWatcher.Cancel();
+    m_source.reset();
+    // Tells the client it has the whole body.
+    m_destination.reset();
+    std::move(m_finished).Run();
+}
+
 // Handles intercepted, in-progress requests/responses, so that they can be
 // controlled and modified accordingly.
 class InterceptedRequest : public network::mojom::URLLoader
@@ -131,6 +235,13 @@ public:
 private:
     void InterceptOnUIThread();
     void ContinueAfterIntercept();
+    void StartTargetLoader();
+
+    // Serves the request from the shared HTTP cache of the profile if it has it. Returns false
+    // if the request has to go to the network.
+    bool LookupSharedHttpCache();
+    void OnSharedHttpCacheLookup(std::optional<SharedHttpCacheQt::Entry> entry);
+    void OnSharedHttpCacheTeeFinished();
 
     // This is called when the original URLLoaderClient has a connection error.
     void OnURLLoaderClientError();
@@ -168,6 +279,15 @@ private:
     ResourceRequestBody request_body_;
     network::mojom::URLResponseHeadPtr current_response_;
 
+    // Set while the response to the request may be stored in the shared HTTP cache.
+    QByteArray shared_cache_key_;
+    url::Origin shared_cache_top_frame_origin_;
+    url::Origin shared_cache_frame_origin_;
+    // Copies the body to be stored while the client reads it. The client is only told the
+    // request completed once it has the whole body, which would be cut off otherwise.
+    std::unique_ptr<ResponseBodyTee> shared_cache_tee_;
+    std::optional<network::URLLoaderCompletionStatus> shared_cache_pending_status_;
+
     const net::MutableNetworkTrafficAnnotationTag traffic_annotation_;
 
     struct RequestInfoDeleter
@@ -410,19 +530,108 @@ void InterceptedRequest::ContinueAfterIntercept()
     }
 
     if (!target_loader_ && target_factory_) {
-        loader_error_seen_ = false;
-        target_factory_->CreateLoaderAndStart(target_loader_.BindNewPipeAndPassReceiver(), request_id_,
-                                              options_, request_, proxied_client_receiver_.BindNewPipeAndPassRemote(),
-                                              traffic_annotation_);
+        if (LookupSharedHttpCache())
+            return;
+        StartTargetLoader();
     }
 }
 
+void InterceptedRequest::StartTargetLoader()
+{
+    loader_error_seen_ = false;
+    target_factory_->CreateLoaderAndStart(target_loader_.BindNewPipeAndPassReceiver(), request_id_,
+                                          options_, request_, proxied_client_receiver_.BindNewPipeAndPassRemote(),
+                                          traffic_annotation_);
+}
+
+bool InterceptedRequest::LookupSharedHttpCache()
+{
+    shared_cache_key_.clear();
+    SharedHttpCacheQt *cache = profile_adapter_ ? profile_adapter_->sharedHttpCache() : nullptr;
+    auto *frame_tree_node = content::FrameTreeNode::GloballyFindByID(frame_tree_node_id_);
+    if (!cache || !frame_tree_node)
+        return false;
+
+    content::RenderFrameHostImpl *frame = frame_tree_node->current_frame_host();
+    // The network service blocks responses that do not satisfy the embedder policy of the page,
+    // which a response from the shared cache would not be checked against.
+    if (frame->cross_origin_embedder_policy().value
+        != network::mojom::CrossOriginEmbedderPolicyValue::kNone)
+        return false;
+    shared_cache_top_frame_origin_ = frame->GetOutermostMainFrame()->GetLastCommittedOrigin();
+    shared_cache_frame_origin_ = frame->GetLastCommittedOrigin();
+    shared_cache_key_ = SharedHttpCacheQt::keyFor(request_, shared_cache_top_frame_origin_,
+                                                  shared_cache_frame_origin_);
+    if (shared_cache_key_.isEmpty() || !cache->contains(shared_cache_key_))
+        return false;
+
+    cache->lookup(shared_cache_key_, request_,
+                  base::BindOnce(&InterceptedRequest::OnSharedHttpCacheLookup, weak_factory_.GetWeakPtr()));
+    return true;
+}
+
+void InterceptedRequest::OnSharedHttpCacheLookup(std::optional<SharedHttpCacheQt::Entry> entry)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    mojo::ScopedDataPipeProducerHandle producer_handle;
+    mojo::ScopedDataPipeConsumerHandle consumer_handle;
+    if (!entry || mojo::CreateDataPipe(entry->body.size(), producer_handle, consumer_handle) != MOJO_RESULT_OK) {
+        StartTargetLoader();
+        return;
+    }
+    // Already stored, there is nothing to store from this response.
+    shared_cache_key_.clear();
+
+    network::mojom::URLResponseHeadPtr head = createResponse(request_);
+    head->headers = entry->headers;
+    head->headers->GetMimeTypeAndCharset(&head->mime_type, &head->charset);
+    head->content_length = entry->body.size();
+    head->request_time = entry->requestTime;
+    head->response_time = entry->responseTime;
+    head->request_start = base::TimeTicks::Now();
+    head->response_start = head->request_start;
+    head->was_fetched_via_cache = true;
+    head->network_accessed = false;
+    current_response_ = head.Clone();
+    target_client_->OnReceiveResponse(std::move(head), std::move(consumer_handle), std::nullopt);
+
+    // The pipe was created large enough to hold the whole body.
+    MojoResult result = MOJO_RESULT_OK;
+    if (!entry->body.empty()) {
+        size_t written = 0;
+        result = producer_handle->WriteData(base::as_byte_span(entry->body),
+                                            MOJO_WRITE_DATA_FLAG_ALL_OR_NONE, written);
+    }
+    network::URLLoaderCompletionStatus status(result == MOJO_RESULT_OK ? net::OK : net::ERR_FAILED);
+    status.exists_in_cache = true;
+    status.decoded_body_length = entry->body.size();
+    CallOnComplete(status, true);
+}
+
 // URLLoaderClient methods.
 
 void InterceptedRequest::OnReceiveResponse(network::mojom::URLResponseHeadPtr head, mojo::ScopedDataPipeConsumerHandle handle, std::optional<mojo_base::BigBuffer> buffer)
 {
     current_response_ = head.Clone();
 
+    if (profile_adapter_) {
+        if (NetworkPredictorQt *predictor = profile_adapter_->networkPredictor())
+            predictor->responseReceived(request_.url, *head);
+        SharedHttpCacheQt *cache = profile_adapter_->sharedHttpCache();
+        // Off-the-record profiles may use the shared cache, but leave no trace in it.
+        mojo::ScopedDataPipeProducerHandle producer_handle;
+        mojo::ScopedDataPipeConsumerHandle consumer_handle;
+        if (cache && !shared_cache_key_.isEmpty() && !profile_adapter_->isOffTheRecord() && handle
+            && cache->shouldStore(shared_cache_key_, request_, *head)
+            && mojo::CreateDataPipe(nullptr, producer_handle, consumer_handle) == MOJO_RESULT_OK) {
+            shared_cache_tee_ = std::make_unique<ResponseBodyTee>(
+                    std::move(handle), std::move(producer_handle),
+                    base::BindOnce(&InterceptedRequest::OnSharedHttpCacheTeeFinished,
+                                   base::Unretained(this)));
+            handle = std::move(consumer_handle);
+        }
+    }
+
     target_client_->OnReceiveResponse(std::move(head), std::move(handle), std::move(buffer));
 }
 
@@ -430,6 +639,7 @@ void InterceptedRequest::OnReceiveRedirect(const net::RedirectInfo &redirect_inf
 {
     // TODO(timvolodine): handle redirect override.
     current_response_ = head.Clone();
+    shared_cache_key_.clear();
     target_client_->OnReceiveRedirect(redirect_info, std::move(head));
     request_.url = redirect_info.new_url;
     request_.method = redirect_info.new_method;
@@ -450,12 +660,31 @@ void InterceptedRequest::OnTransferSizeUpdated(int32_t transfer_size_diff)
 
 void InterceptedRequest::OnComplete(const network::URLLoaderCompletionStatus &status)
 {
+    if (shared_cache_tee_) {
+        if (!shared_cache_tee_->finished()) {
+            shared_cache_pending_status_ = status;
+            return;
+        }
+        std::optional<std::string> body = shared_cache_tee_->takeBody();
+        shared_cache_tee_.reset();
+        SharedHttpCacheQt *cache = profile_adapter_ ? profile_adapter_->sharedHttpCache() : nullptr;
+        if (cache && body && status.error_code == net::OK
+            && status.decoded_body_length == int64_t(body->size()))
+            cache->store(shared_cache_key_, *current_response_, std::move(*body));
+    }
+
     // Only wait for the original loader to possibly have a custom error if the
     // target loader succeeded. If the target loader failed, then it was a race as
     // to whether that error or the safe browsing error would be reported.
     CallOnComplete(status, status.error_code == net::OK);
 }
 
+void InterceptedRequest::OnSharedHttpCacheTeeFinished()
+{
+    if (shared_cache_pending_status_)
+        OnComplete(*std::exchange(shared_cache_pending_status_, std::nullopt));
+}
+
 // URLLoader methods.
 
 void InterceptedRequest::FollowRedirect(const std::vector<std::string> &removed_headers,
@@ -514,6 +743,7 @@ void InterceptedRequest::CallOnComplete(const network::URLLoaderCompletionStatus
         // request.
         proxied_client_receiver_.reset();
         target_loader_.reset();
+        shared_cache_tee_.reset();
 
         // Don't delete |this| yet, in case the |proxied_loader_receiver_|'s
         // error_handler is called with a reason to indicate an error which we want
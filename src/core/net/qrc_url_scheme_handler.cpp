@@ -6,17 +6,88 @@
 
 #include <QtWebEngineCore/qwebengineurlrequestjob.h>
 
-#include <QFile>
-#include <QFileInfo>
+#include <QBuffer>
+#include <QCache>
+#include <QCryptographicHash>
 #include <QMimeDatabase>
 #include <QMimeType>
-
-#include <memory>
+#include <QMutex>
+#include <QResource>
 
 using namespace Qt::StringLiterals;
 
 namespace QtWebEngineCore {
 
+// Limits the memory held by decompressed resources, uncompressed ones are only referenced.
+static constexpr qsizetype kMaxDecompressedCacheSize = 32 * 1024 * 1024;
+
+namespace {
+struct ResourceCache
+{
+    QMutex mutex;
+    QCache<QString, std::shared_ptr<const QrcUrlSchemeHandler::Resource>> cache{
+        kMaxDecompressedCacheSize
+    };
+};
+} // namespace
+
+Q_GLOBAL_STATIC(ResourceCache, resourceCache)
+
+static std::shared_ptr<const QrcUrlSchemeHandler::Resource> loadResource(const QResource &qresource,
+                                                                         const QString &path)
+{
+    auto resource = std::make_shared<QrcUrlSchemeHandler::Resource>();
+    resource->mappedData = qresource.data();
+    if (qresource.compressionAlgorithm() == QResource::NoCompression)
+        resource->data = QByteArray::fromRawData(reinterpret_cast<const char *>(qresource.data()),
+                                                 qresource.size());
+    else
+        resource->data = qresource.uncompressedData();
+
+    QMimeType mimeType = QMimeDatabase().mimeTypeForFileNameAndData(path, resource->data);
+    if (mimeType.name() == "application/x-extension-html"_L1)
+        resource->mimeType = "text/html";
+    else
+        resource->mimeType = mimeType.name().toStdString();
+
+    // rcc records the modification time of the source file, only hash the contents if it didn't.
+    resource->lastModified = qresource.lastModified();
+    QByteArray etag;
+    if (resource->lastModified.isValid())
+        etag = QByteArray::number(resource->data.size(), 16) + '-'
+                + QByteArray::number(resource->lastModified.toMSecsSinceEpoch(), 16);
+    else
+        etag = QCryptographicHash::hash(resource->data, QCryptographicHash::Md5).toHex();
+    resource->etag = '"' + etag.toStdString() + '"';
+    return resource;
+}
+
+std::shared_ptr<const QrcUrlSchemeHandler::Resource> QrcUrlSchemeHandler::resource(const QString &path)
+{
+    // Looking up the resource is cheap compared to decompressing it and detecting its MIME type,
+    // and tells whether the resource was unregistered or replaced since it was cached.
+    QResource qresource(u':' + path);
+    if (!qresource.isValid() || qresource.isDir() || qresource.uncompressedSize() == 0)
+        return nullptr;
+
+    ResourceCache *cache = resourceCache();
+    {
+        QMutexLocker locker(&cache->mutex);
+        if (auto *cached = cache->cache.object(path)) {
+            if ((*cached)->mappedData == qresource.data())
+                return *cached;
+            cache->cache.remove(path);
+        }
+    }
+
+    auto resource = loadResource(qresource, path);
+    const qsizetype cost = qresource.compressionAlgorithm() == QResource::NoCompression
+            ? 1 : qMax(resource->data.size(), qsizetype(1));
+    QMutexLocker locker(&cache->mutex);
+    cache->cache.insert(path, new std::shared_ptr<const Resource>(resource), cost);
+    return resource;
+}
+
 void QrcUrlSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job)
 {
     const QByteArray requestMethod = job->requestMethod();
@@ -27,19 +98,16 @@ void QrcUrlSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job)
 
     const QUrl requestUrl = job->requestUrl();
     const QString requestPath = requestUrl.path();
-    auto file = std::make_unique<QFile>(u':' + requestPath, job);
-    if (!file->exists() || file->size() == 0) {
+    std::shared_ptr<const Resource> resource = QrcUrlSchemeHandler::resource(requestPath);
+    if (!resource) {
         qWarning("QResource '%s' not found or is empty", qUtf8Printable(requestPath));
         job->fail(QWebEngineUrlRequestJob::UrlNotFound);
         return;
     }
-    QFileInfo fileInfo(*file);
-    QMimeDatabase mimeDatabase;
-    QMimeType mimeType = mimeDatabase.mimeTypeForFile(fileInfo);
-    if (mimeType.name() == "application/x-extension-html"_L1)
-        job->reply("text/html", file.release());
-    else
-        job->reply(mimeType.name().toUtf8(), file.release());
+    // The buffer shares the cached data, which stays valid while the resource is registered.
+    auto *buffer = new QBuffer(job);
+    buffer->setData(resource->data);
+    job->reply(QByteArray::fromStdString(resource->mimeType), buffer);
 }
 
 } // namespace QtWebEngineCore
@@ -8,11 +8,31 @@
 #include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
 #include <QtWebEngineCore/qwebengineurlschemehandler.h>
 
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdatetime.h>
+
+#include <memory>
+#include <string>
+
 namespace QtWebEngineCore {
 
 class QrcUrlSchemeHandler final : public QWebEngineUrlSchemeHandler
 {
 public:
+    // The decompressed contents and metadata of a resource, shared between all requests for it.
+    // For uncompressed resources, data refers directly to the mapped resource.
+    struct Resource
+    {
+        const uchar *mappedData = nullptr;
+        QByteArray data;
+        std::string mimeType;
+        std::string etag;
+        QDateTime lastModified;
+    };
+
+    // Thread-safe, used from the IO thread by CustomURLLoader.
+    static std::shared_ptr<const Resource> resource(const QString &path);
+
     void requestStarted(QWebEngineUrlRequestJob *) override;
 };
 
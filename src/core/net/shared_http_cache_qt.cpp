@@ -0,0 +1,465 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:critical reason:network-protocol
+
+#include "shared_http_cache_qt.h"
+
+#include "base/functional/bind.h"
+#include "base/pickle.h"
+#include "base/strings/string_util.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/load_flags.h"
+#include "net/base/schemeful_site.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "services/network/public/cpp/cors/cors.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "third_party/blink/public/common/mime_util/mime_util.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/origin.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+#include <algorithm>
+
+using namespace Qt::StringLiterals;
+
+namespace QtWebEngineCore {
+
+static constexpr int kFormatVersion = 1;
+// Once the bodies take more space than this, the least recently used entries are removed
+// until they fit into kEvictionTargetSize.
+static constexpr qint64 kMaxTotalSize = 256 * 1024 * 1024;
+static constexpr qint64 kEvictionTargetSize = kMaxTotalSize / 4 * 3;
+
+static QString indexDirectory(const QString &directory)
+{
+    return directory + "/index"_L1;
+}
+
+static QString bodyDirectory(const QString &directory)
+{
+    return directory + "/bodies"_L1;
+}
+
+static QByteArray hashOf(QByteArrayView data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+}
+
+// Other resource types are either unlikely to be shared, or protected by checks of the
+// network service on their responses that a cached copy would bypass.
+static bool isEligibleResourceType(blink::mojom::ResourceType type)
+{
+    switch (type) {
+    case blink::mojom::ResourceType::kImage:
+    case blink::mojom::ResourceType::kScript:
+    case blink::mojom::ResourceType::kStylesheet:
+    case blink::mojom::ResourceType::kFontResource:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Only types a page may load from any origin are served, like the opaque response blocking
+// of the network service allows them.
+static bool isSafeMimeType(blink::mojom::ResourceType type, const std::string &mimeType)
+{
+    switch (type) {
+    case blink::mojom::ResourceType::kImage:
+        return base::StartsWith(mimeType, "image/", base::CompareCase::INSENSITIVE_ASCII);
+    case blink::mojom::ResourceType::kScript:
+        return blink::IsSupportedJavascriptMimeType(mimeType);
+    case blink::mojom::ResourceType::kStylesheet:
+        return base::EqualsCaseInsensitiveASCII(mimeType, "text/css");
+    case blink::mojom::ResourceType::kFontResource:
+        return base::StartsWith(mimeType, "font/", base::CompareCase::INSENSITIVE_ASCII)
+                || base::StartsWith(mimeType, "application/font-", base::CompareCase::INSENSITIVE_ASCII)
+                || base::StartsWith(mimeType, "application/x-font-", base::CompareCase::INSENSITIVE_ASCII);
+    default:
+        return false;
+    }
+}
+
+// Whether the response is public and does not depend on who loaded it.
+static bool isPublicResponse(const net::HttpResponseHeaders &headers)
+{
+    if (headers.response_code() != 200 || headers.HasHeader("Set-Cookie")
+        // The network service checks these against the page that loads the response, which a
+        // copy from the shared cache would skip.
+        || headers.HasHeader("Cross-Origin-Resource-Policy")
+        || headers.HasHeader("Cross-Origin-Embedder-Policy")
+        || headers.HasHeader("Cross-Origin-Embedder-Policy-Report-Only")
+        || !headers.HasHeaderValue("Cache-Control", "public")
+        || headers.HasHeaderValue("Cache-Control", "private")
+        || headers.HasHeaderValue("Cache-Control", "no-store")
+        || headers.HasHeaderValue("Cache-Control", "no-cache"))
+        return false;
+    // Bodies are stored decoded, so they can only vary on the encoding.
+    const std::optional<std::string> vary = headers.GetNormalizedHeader("Vary");
+    return !vary || base::EqualsCaseInsensitiveASCII(*vary, "accept-encoding");
+}
+
+static void loadIndex(const QString &directory, QSet<QByteArray> *index, qint64 *size)
+{
+    QDirIterator entries(indexDirectory(directory), QDir::Files);
+    while (entries.hasNext())
+        index->insert(entries.nextFileInfo().fileName().toLatin1());
+    QDirIterator bodies(bodyDirectory(directory), QDir::Files);
+    while (bodies.hasNext())
+        *size += bodies.nextFileInfo().size();
+}
+
+// The fields of an index file in front of the response headers.
+struct IndexHeader
+{
+    std::string key;
+    int64_t requestTime = 0;
+    int64_t responseTime = 0;
+    std::string bodyHash;
+    uint64_t bodySize = 0;
+};
+
+static bool readIndexHeader(base::PickleIterator *it, IndexHeader *header)
+{
+    int version = 0;
+    return it->ReadInt(&version) && version == kFormatVersion && it->ReadString(&header->key)
+            && it->ReadInt64(&header->requestTime) && it->ReadInt64(&header->responseTime)
+            && it->ReadString(&header->bodyHash) && it->ReadUInt64(&header->bodySize);
+}
+
+static std::optional<SharedHttpCacheQt::Entry> readEntry(const QString &directory,
+                                                          const QByteArray &key)
+{
+    QFile file(indexDirectory(directory) + u'/' + QLatin1StringView(hashOf(key)));
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+    const QByteArray data = file.readAll();
+    const base::Pickle pickle = base::Pickle::WithUnownedBuffer(
+            base::as_bytes(base::span(data.constData(), size_t(data.size()))));
+    base::PickleIterator it(pickle);
+
+    IndexHeader header;
+    if (!readIndexHeader(&it, &header) || header.key != key.toStdString())
+        return std::nullopt;
+
+    SharedHttpCacheQt::Entry entry;
+    entry.headers = net::HttpResponseHeaders::TryToCreateFromPickle(&it);
+    if (!entry.headers)
+        return std::nullopt;
+    entry.requestTime =
+            base::Time::FromDeltaSinceWindowsEpoch(base::Microseconds(header.requestTime));
+    entry.responseTime =
+            base::Time::FromDeltaSinceWindowsEpoch(base::Microseconds(header.responseTime));
+
+    QFile body(bodyDirectory(directory) + u'/' + QString::fromStdString(header.bodyHash));
+    if (!body.open(QIODevice::ReadOnly) || quint64(body.size()) != header.bodySize)
+        return std::nullopt;
+    entry.body = body.readAll().toStdString();
+
+    // The modification time of the index file tells eviction when the entry was last used.
+    // A cache directory that cannot be written just loses that information.
+    file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    return entry;
+}
+
+// Removes the least recently used entries until the bodies take at most targetSize, as well
+// as the bodies no entry refers to anymore. Returns the names of the removed index files and
+// the size of the remaining bodies.
+static std::pair<QSet<QByteArray>, qint64> evictEntries(const QString &directory,
+                                                        qint64 targetSize)
+{
+    struct StoredEntry
+    {
+        QString path;
+        QDateTime lastUsed;
+        QString bodyHash;
+    };
+    std::vector<StoredEntry> entries;
+    QHash<QString, int> bodyReferences;
+    QDirIterator index(indexDirectory(directory), QDir::Files);
+    while (index.hasNext()) {
+        const QFileInfo info = index.nextFileInfo();
+        QFile file(info.filePath());
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        const QByteArray data = file.readAll();
+        const base::Pickle pickle = base::Pickle::WithUnownedBuffer(
+                base::as_bytes(base::span(data.constData(), size_t(data.size()))));
+        base::PickleIterator it(pickle);
+        IndexHeader header;
+        // Unreadable entries are never served, so they go first.
+        StoredEntry entry{ info.filePath(), QDateTime(), QString() };
+        if (readIndexHeader(&it, &header)) {
+            entry.lastUsed = info.lastModified();
+            entry.bodyHash = QString::fromStdString(header.bodyHash);
+            ++bodyReferences[entry.bodyHash];
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    qint64 size = 0;
+    QHash<QString, qint64> bodySizes;
+    QDirIterator bodies(bodyDirectory(directory), QDir::Files);
+    while (bodies.hasNext()) {
+        const QFileInfo info = bodies.nextFileInfo();
+        if (!bodyReferences.contains(info.fileName())) {
+            QFile::remove(info.filePath());
+            continue;
+        }
+        bodySizes.insert(info.fileName(), info.size());
+        size += info.size();
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const StoredEntry &a, const StoredEntry &b) {
+        if (a.bodyHash.isEmpty() != b.bodyHash.isEmpty())
+            return a.bodyHash.isEmpty();
+        return a.lastUsed < b.lastUsed;
+    });
+    QSet<QByteArray> removed;
+    for (const StoredEntry &entry : entries) {
+        if (size <= targetSize && !entry.bodyHash.isEmpty())
+            break;
+        if (!QFile::remove(entry.path))
+            continue;
+        removed.insert(QFileInfo(entry.path).fileName().toLatin1());
+        // Bodies are only removed with the last entry that uses them.
+        if (!entry.bodyHash.isEmpty() && --bodyReferences[entry.bodyHash] == 0
+            && QFile::remove(bodyDirectory(directory) + u'/' + entry.bodyHash))
+            size -= bodySizes.value(entry.bodyHash);
+    }
+    return { removed, size };
+}
+
+// Returns the number of bytes the entry added to the stored bodies, which is zero if another
+// entry already stored the same body.
+static std::optional<qint64> writeEntry(const QString &directory, const QByteArray &key,
+                                        const SharedHttpCacheQt::Entry &entry)
+{
+    if (!QDir().mkpath(indexDirectory(directory)) || !QDir().mkpath(bodyDirectory(directory)))
+        return std::nullopt;
+
+    // Bodies are named by their content, an existing one is the same.
+    const QByteArray bodyHash = hashOf(QByteArrayView(entry.body));
+    const QString bodyPath = bodyDirectory(directory) + u'/' + QLatin1StringView(bodyHash);
+    qint64 added = 0;
+    if (!QFile::exists(bodyPath)) {
+        QSaveFile body(bodyPath);
+        if (!body.open(QIODevice::WriteOnly)
+            || body.write(entry.body.data(), qint64(entry.body.size())) != qint64(entry.body.size())
+            || !body.commit())
+            return std::nullopt;
+        added = qint64(entry.body.size());
+    }
+
+    base::Pickle pickle;
+    pickle.WriteInt(kFormatVersion);
+    pickle.WriteString(key.toStdString());
+    pickle.WriteInt64(entry.requestTime.ToDeltaSinceWindowsEpoch().InMicroseconds());
+    pickle.WriteInt64(entry.responseTime.ToDeltaSinceWindowsEpoch().InMicroseconds());
+    pickle.WriteString(bodyHash.toStdString());
+    pickle.WriteUInt64(entry.body.size());
+    entry.headers->Persist(&pickle,
+                           net::HttpResponseHeaders::PERSIST_SANS_COOKIES
+                                   | net::HttpResponseHeaders::PERSIST_SANS_CHALLENGES
+                                   | net::HttpResponseHeaders::PERSIST_SANS_HOP_BY_HOP
+                                   | net::HttpResponseHeaders::PERSIST_SANS_NON_CACHEABLE
+                                   | net::HttpResponseHeaders::PERSIST_SANS_RANGES
+                                   | net::HttpResponseHeaders::PERSIST_SANS_SECURITY_STATE);
+
+    QSaveFile index(indexDirectory(directory) + u'/' + QLatin1StringView(hashOf(key)));
+    if (!index.open(QIODevice::WriteOnly)
+        || index.write(static_cast<const char *>(pickle.data()), qint64(pickle.size()))
+                != qint64(pickle.size())
+        || !index.commit())
+        return std::nullopt;
+    return added;
+}
+
+std::shared_ptr<SharedHttpCacheQt> SharedHttpCacheQt::forDirectory(const QString &directory)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    static QHash<QString, std::weak_ptr<SharedHttpCacheQt>> caches;
+    const QString path = QDir::cleanPath(QDir(directory).absolutePath());
+    std::shared_ptr<SharedHttpCacheQt> cache = caches.value(path).lock();
+    if (!cache) {
+        cache = std::make_shared<SharedHttpCacheQt>(path);
+        caches.insert(path, cache);
+    }
+    return cache;
+}
+
+SharedHttpCacheQt::SharedHttpCacheQt(const QString &directory)
+    : m_directory(directory)
+    , m_taskRunner(base::ThreadPool::CreateSequencedTaskRunner(
+              { base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+                base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN }))
+{
+    auto *index = new QSet<QByteArray>;
+    auto *size = new qint64(0);
+    m_taskRunner->PostTaskAndReply(
+            FROM_HERE, base::BindOnce(&loadIndex, m_directory, index, size),
+            base::BindOnce(
+                    [](base::WeakPtr<SharedHttpCacheQt> cache, QSet<QByteArray> *index, qint64 *size) {
+                        if (cache)
+                            cache->indexLoaded(std::move(*index), *size);
+                    },
+                    m_weakPtrFactory.GetWeakPtr(), base::Owned(index), base::Owned(size)));
+}
+
+SharedHttpCacheQt::~SharedHttpCacheQt() = default;
+
+void SharedHttpCacheQt::indexLoaded(QSet<QByteArray> index, qint64 size)
+{
+    m_index = std::move(index);
+    m_size = size;
+    evictIfNeeded();
+}
+
+QByteArray SharedHttpCacheQt::keyFor(const network::ResourceRequest &request,
+                                     const url::Origin &topFrameOrigin,
+                                     const url::Origin &frameOrigin)
+{
+    if (request.method != net::HttpRequestHeaders::kGetMethod || !request.url.SchemeIsHTTPOrHTTPS()
+        || !isEligibleResourceType(blink::mojom::ResourceType(request.resource_type))
+        || topFrameOrigin.opaque() || frameOrigin.opaque())
+        return QByteArray();
+    // Requests asking to bypass or revalidate cached responses go to the network.
+    if (request.load_flags
+        & (net::LOAD_BYPASS_CACHE | net::LOAD_VALIDATE_CACHE | net::LOAD_DISABLE_CACHE))
+        return QByteArray();
+    if (request.headers.HasHeader(net::HttpRequestHeaders::kRange)
+        || request.headers.HasHeader(net::HttpRequestHeaders::kAuthorization)
+        || request.headers.HasHeader(net::HttpRequestHeaders::kCacheControl)
+        || request.headers.HasHeader(net::HttpRequestHeaders::kPragma))
+        return QByteArray();
+
+    GURL::Replacements removeRef;
+    removeRef.ClearRef();
+    const std::string key = net::SchemefulSite(topFrameOrigin).Serialize() + ' '
+            + net::SchemefulSite(frameOrigin).Serialize() + ' '
+            + request.url.ReplaceComponents(removeRef).spec();
+    return QByteArray::fromStdString(key);
+}
+
+bool SharedHttpCacheQt::contains(const QByteArray &key) const
+{
+    return m_index && m_index->contains(hashOf(key));
+}
+
+void SharedHttpCacheQt::lookup(const QByteArray &key, const network::ResourceRequest &request,
+                               base::OnceCallback<void(std::optional<Entry>)> callback)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    const auto resourceType = blink::mojom::ResourceType(request.resource_type);
+    // The response is checked for CORS by the network service, unless it is served from here.
+    const bool needsCors = network::cors::IsCorsEnabledRequestMode(request.mode);
+    const bool withCredentials = request.credentials_mode == network::mojom::CredentialsMode::kInclude;
+
+    m_taskRunner->PostTaskAndReplyWithResult(
+            FROM_HERE, base::BindOnce(&readEntry, m_directory, key),
+            base::BindOnce(
+                    [](base::WeakPtr<SharedHttpCacheQt> cache, const QByteArray &key,
+                       blink::mojom::ResourceType resourceType, bool needsCors, bool withCredentials,
+                       base::OnceCallback<void(std::optional<Entry>)> callback,
+                       std::optional<Entry> entry) {
+                        if (entry && entry->headers->RequiresValidation(entry->requestTime, entry->responseTime,
+                                                                        base::Time::Now())
+                                        != net::VALIDATION_NONE) {
+                            // Stale, let the next response store it again.
+                            if (cache && cache->m_index)
+                                cache->m_index->remove(hashOf(key));
+                            entry.reset();
+                        }
+                        std::string mimeType;
+                        if (entry && (!entry->headers->GetMimeType(&mimeType)
+                                      || !isSafeMimeType(resourceType, mimeType)))
+                            entry.reset();
+                        if (entry && needsCors
+                            && (withCredentials
+                                || entry->headers->GetNormalizedHeader("Access-Control-Allow-Origin") != "*"))
+                            entry.reset();
+                        std::move(callback).Run(std::move(entry));
+                    },
+                    m_weakPtrFactory.GetWeakPtr(), key, resourceType, needsCors, withCredentials,
+                    std::move(callback)));
+}
+
+bool SharedHttpCacheQt::shouldStore(const QByteArray &key, const network::ResourceRequest &request,
+                                    const network::mojom::URLResponseHead &head) const
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    // Nothing is stored while an eviction makes room.
+    if (!m_index || m_evicting || contains(key) || m_pendingKeys.contains(key))
+        return false;
+    // A server marking a response public allows shared caches to serve it to other users, even
+    // if the request carried cookies, so the copy the page got is the one stored.
+    return head.headers && isPublicResponse(*head.headers)
+            && isSafeMimeType(blink::mojom::ResourceType(request.resource_type), head.mime_type)
+            && head.content_length <= int64_t(kMaxBodySize)
+            && head.headers->RequiresValidation(head.request_time, head.response_time,
+                                                base::Time::Now())
+                    == net::VALIDATION_NONE;
+}
+
+void SharedHttpCacheQt::store(const QByteArray &key, const network::mojom::URLResponseHead &head,
+                              std::string body)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (!m_index || m_evicting || contains(key) || m_pendingKeys.contains(key)
+        || body.size() > kMaxBodySize)
+        return;
+
+    Entry entry;
+    entry.headers = base::MakeRefCounted<net::HttpResponseHeaders>(head.headers->raw_headers());
+    // The body was decoded by the network service.
+    entry.headers->RemoveHeader("Content-Encoding");
+    entry.headers->RemoveHeader("Content-Length");
+    entry.requestTime = head.request_time;
+    entry.responseTime = head.response_time;
+    entry.body = std::move(body);
+
+    m_pendingKeys.insert(key);
+    m_taskRunner->PostTaskAndReplyWithResult(
+            FROM_HERE, base::BindOnce(&writeEntry, m_directory, key, std::move(entry)),
+            base::BindOnce(&SharedHttpCacheQt::entryWritten, m_weakPtrFactory.GetWeakPtr(), key));
+}
+
+void SharedHttpCacheQt::entryWritten(const QByteArray &key, std::optional<qint64> addedSize)
+{
+    m_pendingKeys.remove(key);
+    if (!addedSize)
+        return;
+    m_index->insert(hashOf(key));
+    m_size += *addedSize;
+    evictIfNeeded();
+}
+
+void SharedHttpCacheQt::evictIfNeeded()
+{
+    if (m_size <= kMaxTotalSize || m_evicting)
+        return;
+    m_evicting = true;
+    m_taskRunner->PostTaskAndReplyWithResult(
+            FROM_HERE, base::BindOnce(&evictEntries, m_directory, kEvictionTargetSize),
+            base::BindOnce(&SharedHttpCacheQt::entriesEvicted, m_weakPtrFactory.GetWeakPtr()));
+}
+
+void SharedHttpCacheQt::entriesEvicted(std::pair<QSet<QByteArray>, qint64> result)
+{
+    m_evicting = false;
+    // Entries written before the eviction ran are included in the size it reports, and the
+    // ones written after it are added again once they are.
+    for (const QByteArray &removed : std::as_const(result.first))
+        m_index->remove(removed);
+    m_size = result.second;
+}
+
+} // namespace QtWebEngineCore
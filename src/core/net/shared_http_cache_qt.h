@@ -0,0 +1,122 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+// Qt-Security score:critical reason:network-protocol
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef SHARED_HTTP_CACHE_QT_H
+#define SHARED_HTTP_CACHE_QT_H
+
+#include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
+
+#include "base/functional/callback_forward.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "services/network/public/mojom/url_response_head.mojom-forward.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace net {
+class HttpResponseHeaders;
+}
+
+namespace network {
+struct ResourceRequest;
+}
+
+namespace url {
+class Origin;
+}
+
+namespace QtWebEngineCore {
+
+// A disk cache of public HTTP responses shared by the profiles that use the same directory,
+// consulted by their pages before their own HTTP cache.
+//
+// Only subresources that do not depend on the user are eligible: responses marked public and
+// without cookies, which HTTP allows shared caches to serve to anyone. Their bodies are copied
+// while the page that loaded them reads them. Like the HTTP cache of a profile, entries are
+// partitioned by the sites of the top-level and the requesting frame. Response bodies are
+// stored once by their hash, no matter how many entries use them. The least recently used
+// entries are removed when the bodies grow too large.
+//
+// Entries are never revalidated, stale ones are loaded from the network again. Responses with
+// cross-origin resource or embedder policies are not stored, and pages with an embedder policy
+// do not use the cache, since the network service enforces them on the responses it loads.
+class SharedHttpCacheQt
+{
+public:
+    struct Entry
+    {
+        scoped_refptr<net::HttpResponseHeaders> headers;
+        std::string body;
+        base::Time requestTime;
+        base::Time responseTime;
+    };
+
+    // Larger bodies are not stored.
+    static constexpr size_t kMaxBodySize = 5 * 1024 * 1024;
+
+    // Returns the cache using directory, shared with all profiles using it.
+    static std::shared_ptr<SharedHttpCacheQt> forDirectory(const QString &directory);
+
+    explicit SharedHttpCacheQt(const QString &directory);
+    ~SharedHttpCacheQt();
+
+    const QString &directory() const { return m_directory; }
+
+    // Returns the key of the request, or an empty key if it cannot use the cache.
+    static QByteArray keyFor(const network::ResourceRequest &request,
+                             const url::Origin &topFrameOrigin, const url::Origin &frameOrigin);
+
+    bool contains(const QByteArray &key) const;
+    // Reads the entry of key, if it is fresh and can be used by request.
+    void lookup(const QByteArray &key, const network::ResourceRequest &request,
+                base::OnceCallback<void(std::optional<Entry>)> callback);
+    // Whether the response to request may be stored, its body is then passed to store().
+    bool shouldStore(const QByteArray &key, const network::ResourceRequest &request,
+                     const network::mojom::URLResponseHead &head) const;
+    // Stores the response with its decoded body.
+    void store(const QByteArray &key, const network::mojom::URLResponseHead &head,
+               std::string body);
+
+private:
+    void indexLoaded(QSet<QByteArray> index, qint64 size);
+    void entryWritten(const QByteArray &key, std::optional<qint64> addedSize);
+    void evictIfNeeded();
+    void entriesEvicted(std::pair<QSet<QByteArray>, qint64> result);
+
+    const QString m_directory;
+    scoped_refptr<base::SequencedTaskRunner> m_taskRunner;
+
+    // File names of the stored entries, nothing is served until they are read.
+    std::optional<QSet<QByteArray>> m_index;
+    // Size of the stored bodies, each counted once no matter how many entries use it.
+    qint64 m_size = 0;
+    bool m_evicting = false;
+    QSet<QByteArray> m_pendingKeys;
+
+    base::WeakPtrFactory<SharedHttpCacheQt> m_weakPtrFactory{ this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // SHARED_HTTP_CACHE_QT_H
@@ -3,6 +3,7 @@
 
 #include "permission_manager_qt.h"
 
+#include "base/functional/bind.h"
 #include "base/threading/thread_restrictions.h"
 #include "content/browser/renderer_host/render_view_host_delegate.h"
 #include "content/browser/web_contents/web_contents_impl.h"
@@ -22,6 +23,9 @@
 #include "components/prefs/pref_service.h"
 
 #include <QtWebEngineCore/private/qwebenginepermission_p.h>
+#include <QJsonObject>
+#include <QJsonValue>
+#include "pref_service_adapter.h"
 #include "type_conversion.h"
 #include "web_contents_delegate_qt.h"
 #include "web_engine_settings.h"
@@ -30,6 +34,10 @@ using namespace Qt::StringLiterals;
 
 namespace QtWebEngineCore {
 
+// Delay before changed permissions are written to the preference store, so that many changes
+// in a row end up in a single write.
+constexpr base::TimeDelta kPermissionsWriteDelay = base::Milliseconds(500);
+
 static QWebEnginePermission::PermissionType toQt(blink::PermissionType type)
 {
     switch (type) {
@@ -221,14 +229,16 @@ static blink::mojom::PermissionStatus getStatusFromSettings(blink::PermissionTyp
     }
 }
 
-PermissionManagerQt::PermissionManagerQt(ProfileAdapter *profileAdapter)
+PermissionManagerQt::PermissionManagerQt(ProfileAdapter *profileAdapter, base::OnceClosure loadedCallback)
     : m_requestIdCount(0)
     , m_transientWriteCount(0)
+    , m_loadedCallback(std::move(loadedCallback))
     , m_profileAdapter(profileAdapter)
     , m_persistence(true)
 {
+    const bool async = !m_loadedCallback.is_null();
     PrefServiceFactory factory;
-    factory.set_async(false);
+    factory.set_async(async);
     factory.set_command_line_prefs(base::MakeRefCounted<ChromeCommandLinePrefStore>(
             base::CommandLine::ForCurrentProcess()));
 
@@ -238,10 +248,17 @@ PermissionManagerQt::PermissionManagerQt(ProfileAdapter *profileAdapter)
 
     auto policy = profileAdapter->persistentPermissionsPolicy();
     if (!profileAdapter->isOffTheRecord() && policy == ProfileAdapter::PersistentPermissionsPolicy::StoreOnDisk &&
-            !userPrefStorePath.isEmpty() && profileAdapter->ensureDataPathExists()) {
+            !userPrefStorePath.isEmpty() && (async || profileAdapter->ensureDataPathExists())) {
         userPrefStorePath += QDir::separator();
         userPrefStorePath += "permissions.json"_L1;
-        factory.set_user_prefs(base::MakeRefCounted<JsonPrefStore>(toFilePath(userPrefStorePath)));
+        if (async) {
+            // The data path is created by the first task of the sequence.
+            factory.set_user_prefs(base::MakeRefCounted<JsonPrefStore>(
+                    toFilePath(userPrefStorePath), nullptr,
+                    PrefServiceAdapter::createStoreTaskRunner(*profileAdapter)));
+        } else {
+            factory.set_user_prefs(base::MakeRefCounted<JsonPrefStore>(toFilePath(userPrefStorePath)));
+        }
     } else {
         factory.set_user_prefs(new InMemoryPrefStore);
     }
@@ -265,10 +282,26 @@ PermissionManagerQt::PermissionManagerQt(ProfileAdapter *profileAdapter)
     if (policy == ProfileAdapter::PersistentPermissionsPolicy::AskEveryTime)
         m_persistence = false;
 
-    {
+    if (async) {
+        m_prefService = factory.Create(prefRegistry);
+        if (m_prefService->GetInitializationStatus() == PrefService::INITIALIZATION_STATUS_WAITING) {
+            m_prefService->AddPrefInitObserver(base::BindOnce(
+                    [](PermissionManagerQt *manager, bool) { manager->persistentPermissionsLoaded(); },
+                    base::Unretained(this)));
+            return;
+        }
+    } else {
         base::ScopedAllowBlocking allowBlock;
         m_prefService = factory.Create(prefRegistry);
     }
+    persistentPermissionsLoaded();
+}
+
+void PermissionManagerQt::persistentPermissionsLoaded()
+{
+    loadPersistentPermissions();
+    if (m_loadedCallback)
+        std::move(m_loadedCallback).Run();
 }
 
 PermissionManagerQt::~PermissionManagerQt()
@@ -496,20 +529,18 @@ QList<QWebEnginePermission> PermissionManagerQt::listPermissions(
         if (!QWebEnginePermission::isPersistent(type))
             continue;
 
-        auto *pref = m_prefService->FindPreference(permissionTypeString(type));
-        if (!pref)
+        auto typeIt = m_persistentPermissions.find(type);
+        if (typeIt == m_persistentPermissions.end())
             continue;
 
-        auto *prefDict = pref->GetValue()->GetIfDict();
-        Q_ASSERT(prefDict);
-
-        for (auto &&entry : *prefDict) {
-            if (!originSpec.empty() && entry.first != originSpec)
-                continue;
-
+        const auto &permissions = typeIt->second;
+        auto it = originSpec.empty() ? permissions.begin() : permissions.find(originSpec);
+        for (; it != permissions.end(); ++it) {
             auto *pvt = new QWebEnginePermissionPrivate(
-                toQt(GURL(std::string_view(entry.first))), type, m_profileAdapter.get());
+                toQt(GURL(std::string_view(it->first))), type, m_profileAdapter.get());
             returnList.push_back(QWebEnginePermission(pvt));
+            if (!originSpec.empty())
+                break;
         }
     }
 
@@ -591,10 +622,94 @@ void PermissionManagerQt::onCrossOriginNavigation(content::RenderFrameHost *rend
 void PermissionManagerQt::commit()
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    m_writeTimer.Stop();
+    writePersistentPermissions();
     // Make sure modified permissions are written to disk
     m_prefService->CommitPendingWrite();
 }
 
+void PermissionManagerQt::loadPersistentPermissions()
+{
+    for (auto type : m_permissionTypes) {
+        auto &permissions = m_persistentPermissions[type];
+        auto *pref = m_prefService->FindPreference(permissionTypeString(type));
+        if (!pref)
+            continue;
+
+        auto *prefDict = pref->GetValue()->GetIfDict();
+        Q_ASSERT(prefDict);
+        for (auto &&entry : *prefDict) {
+            if (auto granted = entry.second.GetIfBool())
+                permissions.emplace(entry.first, *granted);
+        }
+    }
+}
+
+void PermissionManagerQt::schedulePersistentPermissionsWrite(QWebEnginePermission::PermissionType permissionType)
+{
+    m_dirtyPermissionTypes.insert(permissionType);
+    if (!m_writeTimer.IsRunning()) {
+        m_writeTimer.Start(FROM_HERE, kPermissionsWriteDelay,
+                           base::BindOnce(&PermissionManagerQt::writePersistentPermissions,
+                                          base::Unretained(this)));
+    }
+}
+
+void PermissionManagerQt::writePersistentPermissions()
+{
+    if (m_dirtyPermissionTypes.empty())
+        return;
+
+    for (auto type : std::exchange(m_dirtyPermissionTypes, {})) {
+        base::Value::Dict dict;
+        for (const auto &[origin, granted] : m_persistentPermissions[type])
+            dict.Set(origin, granted);
+        m_prefService->SetDict(permissionTypeString(type), std::move(dict));
+    }
+    m_prefService->SchedulePendingLossyWrites();
+}
+
+QJsonObject PermissionManagerQt::exportPermissions() const
+{
+    QJsonObject result;
+    for (const auto &[type, permissions] : m_persistentPermissions) {
+        if (!QWebEnginePermission::isPersistent(type) || permissions.empty())
+            continue;
+        QJsonObject origins;
+        for (const auto &[origin, granted] : permissions)
+            origins.insert(QString::fromStdString(origin), granted);
+        result.insert(QString::fromStdString(permissionTypeString(type)), origins);
+    }
+    return result;
+}
+
+qsizetype PermissionManagerQt::importPermissions(const QJsonObject &permissions)
+{
+    qsizetype imported = 0;
+    for (auto type : m_permissionTypes) {
+        if (!QWebEnginePermission::isPersistent(type))
+            continue;
+        const QJsonValue origins = permissions.value(QString::fromStdString(permissionTypeString(type)));
+        if (!origins.isObject())
+            continue;
+
+        const QJsonObject originsObject = origins.toObject();
+        for (auto it = originsObject.constBegin(); it != originsObject.constEnd(); ++it) {
+            const QUrl origin(it.key());
+            if (!it.value().isBool() || !toGurl(origin).is_valid())
+                continue;
+            // Goes through the regular path so that pending requests and subscribers are
+            // informed; the actual write is batched with all other changes.
+            setPermission(origin, type,
+                          it.value().toBool() ? QWebEnginePermission::State::Granted
+                                              : QWebEnginePermission::State::Denied,
+                          content::GlobalRenderFrameHostToken());
+            ++imported;
+        }
+    }
+    return imported;
+}
+
 void PermissionManagerQt::RequestPermissions(
         content::RenderFrameHost *frameHost,
         const content::PermissionRequestDescription &requestDescription,
@@ -696,19 +811,15 @@ blink::mojom::PermissionStatus PermissionManagerQt::GetPermissionStatus(
     if (permissionTypeQt == QWebEnginePermission::PermissionType::Unsupported)
         return blink::mojom::PermissionStatus::DENIED;
 
-    permissionTypeBlink = toBlink(toQt(permissionTypeBlink)); // Filter out merged/unsupported permissions (e.g. clipboard)
-    auto *pref = m_prefService->FindPreference(permissionTypeString(permissionTypeQt));
-    if (!pref)
+    auto typeIt = m_persistentPermissions.find(permissionTypeQt);
+    if (typeIt == m_persistentPermissions.end())
         return blink::mojom::PermissionStatus::ASK; // Permission type not in database
 
-    const auto *permissionsDict = pref->GetValue()->GetIfDict();
-    Q_ASSERT(permissionsDict);
-
-    const auto requestedPermission = permissionsDict->FindBool(requesting_origin.DeprecatedGetOriginAsURL().spec());
-    if (!requestedPermission)
+    const auto it = typeIt->second.find(requesting_origin.DeprecatedGetOriginAsURL().spec());
+    if (it == typeIt->second.end())
         return blink::mojom::PermissionStatus::ASK; // Origin is not in the current permission type's database
 
-    if (requestedPermission.value())
+    if (it->second)
         return blink::mojom::PermissionStatus::GRANTED;
     return blink::mojom::PermissionStatus::DENIED;
 }
@@ -798,8 +909,10 @@ void PermissionManagerQt::ResetPermission(
     if (permissionType == QWebEnginePermission::PermissionType::Unsupported)
         return;
 
-    ScopedDictPrefUpdate updater(m_prefService.get(), permissionTypeString(permissionType));
-    updater.Get().Remove(requesting_origin.spec());
+    auto typeIt = m_persistentPermissions.find(permissionType);
+    if (typeIt == m_persistentPermissions.end() || !typeIt->second.erase(requesting_origin.spec()))
+        return;
+    schedulePersistentPermissionsWrite(permissionType);
 }
 
 blink::mojom::PermissionStatus PermissionManagerQt::getTransientPermissionStatus(
@@ -834,13 +947,12 @@ void PermissionManagerQt::setPersistentPermission(
     if (permissionTypeQt == QWebEnginePermission::PermissionType::Unsupported)
         return;
 
-    if (!m_prefService->FindPreference(permissionTypeString(permissionTypeQt)))
+    auto typeIt = m_persistentPermissions.find(permissionTypeQt);
+    if (typeIt == m_persistentPermissions.end())
         return;
 
-    ScopedDictPrefUpdate updater(m_prefService.get(), permissionTypeString(permissionTypeQt));
-    updater.Get().Set(requesting_origin.spec(), granted);
-
-    m_prefService->SchedulePendingLossyWrites();
+    typeIt->second.insert_or_assign(requesting_origin.spec(), granted);
+    schedulePersistentPermissionsWrite(permissionTypeQt);
 }
 
 void PermissionManagerQt::setTransientPermission(
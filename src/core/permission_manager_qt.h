@@ -5,6 +5,7 @@
 #define PERMISSION_MANAGER_QT_H
 
 #include "base/functional/callback.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/global_routing_id.h"
 #include "content/public/browser/media_stream_request.h"
 #include "content/public/browser/permission_controller_delegate.h"
@@ -15,8 +16,11 @@
 #include "web_contents_adapter_client.h"
 
 #include <map>
+#include <set>
 #include <tuple>
 
+QT_FORWARD_DECLARE_CLASS(QJsonObject)
+
 class PrefService;
 
 namespace QtWebEngineCore {
@@ -24,7 +28,9 @@ namespace QtWebEngineCore {
 class PermissionManagerQt : public content::PermissionControllerDelegate
 {
 public:
-    PermissionManagerQt(ProfileAdapter *adapter);
+    // If loadedCallback is set, the persistent permissions are read in the background, and
+    // loadedCallback is run once they are available.
+    PermissionManagerQt(ProfileAdapter *adapter, base::OnceClosure loadedCallback = {});
     ~PermissionManagerQt();
 
     static content::GlobalRenderFrameHostToken deserializeToken(int childId, const std::string &serializedToken);
@@ -44,6 +50,8 @@ public:
     QWebEnginePermission::State getPermissionState(const QUrl &origin, const QWebEnginePermission::PermissionType permissionType,
         const content::GlobalRenderFrameHostToken &frameToken);
     QList<QWebEnginePermission> listPermissions(const QUrl &origin, const QWebEnginePermission::PermissionType permissionType);
+    QJsonObject exportPermissions() const;
+    qsizetype importPermissions(const QJsonObject &permissions);
 
     void requestMediaPermissions(
             content::RenderFrameHost *render_frame_host,
@@ -53,6 +61,8 @@ public:
     void onCrossOriginNavigation(content::RenderFrameHost *render_frame_host);
 
     void commit();
+    // Returns the callback passed to the constructor if loading has not finished yet.
+    base::OnceClosure takeLoadedCallback() { return std::move(m_loadedCallback); }
 
     // content::PermissionManager implementation:
     blink::mojom::PermissionStatus GetPermissionStatus(
@@ -125,6 +135,11 @@ private:
         const GURL& requesting_origin,
         content::GlobalRenderFrameHostToken token);
 
+    void loadPersistentPermissions();
+    void persistentPermissionsLoaded();
+    void schedulePersistentPermissionsWrite(QWebEnginePermission::PermissionType permissionType);
+    void writePersistentPermissions();
+
     std::vector<Request> m_requests;
     std::vector<MultiRequest> m_multiRequests;
     std::vector<QWebEnginePermission::PermissionType> m_permissionTypes;
@@ -133,6 +148,12 @@ private:
     int m_requestIdCount;
     int m_transientWriteCount;
     std::unique_ptr<PrefService> m_prefService;
+    // In-memory copy of the persistent store: granted state by origin, per permission type.
+    // Changes are written back to m_prefService in batches, see schedulePersistentPermissionsWrite().
+    std::map<QWebEnginePermission::PermissionType, std::map<std::string, bool>> m_persistentPermissions;
+    std::set<QWebEnginePermission::PermissionType> m_dirtyPermissionTypes;
+    base::OneShotTimer m_writeTimer;
+    base::OnceClosure m_loadedCallback;
     QPointer<QtWebEngineCore::ProfileAdapter> m_profileAdapter;
     bool m_persistence;
 };
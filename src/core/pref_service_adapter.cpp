@@ -9,6 +9,10 @@
 #include "web_engine_library_info.h"
 
 #include "base/base_paths.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "chrome/browser/prefs/chrome_command_line_pref_store.h"
 #include "content/public/browser/browser_thread.h"
@@ -61,16 +65,27 @@ using namespace Qt::StringLiterals;
 
 namespace QtWebEngineCore {
 
-void PrefServiceAdapter::setup(const ProfileAdapter &profileAdapter)
+void PrefServiceAdapter::setup(const ProfileAdapter &profileAdapter, base::OnceClosure loadedCallback)
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (loadedCallback)
+        m_loadedCallback = std::move(loadedCallback);
+    const bool async = !m_loadedCallback.is_null();
+    m_loaded = false;
+
     PrefServiceFactory factory;
+    factory.set_async(async);
     factory.set_command_line_prefs(base::MakeRefCounted<ChromeCommandLinePrefStore>(
             base::CommandLine::ForCurrentProcess()));
 
     QString userPrefStorePath;
     userPrefStorePath += profileAdapter.dataPath();
-    if (!profileAdapter.isOffTheRecord() && !userPrefStorePath.isEmpty() &&
+    if (async && !profileAdapter.isOffTheRecord() && !userPrefStorePath.isEmpty()) {
+        userPrefStorePath += QDir::separator();
+        userPrefStorePath += "user_prefs.json"_L1;
+        factory.set_user_prefs(base::MakeRefCounted<JsonPrefStore>(
+                toFilePath(userPrefStorePath), nullptr, createStoreTaskRunner(profileAdapter)));
+    } else if (!profileAdapter.isOffTheRecord() && !userPrefStorePath.isEmpty() &&
             const_cast<ProfileAdapter *>(&profileAdapter)->ensureDataPathExists()) {
         userPrefStorePath += QDir::separator();
         userPrefStorePath += "user_prefs.json"_L1;
@@ -150,18 +165,55 @@ void PrefServiceAdapter::setup(const ProfileAdapter &profileAdapter)
     registry->RegisterDictionaryPref(prefs::kDevToolsSyncedPreferencesSyncDisabled);
     registry->RegisterDictionaryPref(prefs::kDevToolsSyncedPreferencesSyncEnabled);
 
+    if (async) {
+        m_prefService = factory.Create(registry);
+        if (m_prefService->GetInitializationStatus() == PrefService::INITIALIZATION_STATUS_WAITING) {
+            m_prefService->AddPrefInitObserver(base::BindOnce(
+                    [](PrefServiceAdapter *adapter, bool) { adapter->loaded(); }, base::Unretained(this)));
+        } else {
+            loaded();
+        }
+        return;
+    }
+
     {
         base::ScopedAllowBlocking allowBlock;
         m_prefService = factory.Create(registry);
     }
+    loaded();
+}
 
+void PrefServiceAdapter::loaded()
+{
 #if QT_CONFIG(webengine_spellchecker)
     // Ignore stored values for these options to preserve backwards compatibility.
     m_prefService->ClearPref(spellcheck::prefs::kSpellCheckEnable);
     m_prefService->ClearPref(spellcheck::prefs::kSpellCheckDictionaries);
 #endif // QT_CONFIG(webengine_spellchecker)
 
+    m_loaded = true;
+#if QT_CONFIG(webengine_spellchecker)
+    if (m_pendingSpellCheckLanguages)
+        setSpellCheckLanguages(*std::exchange(m_pendingSpellCheckLanguages, std::nullopt));
+    if (m_pendingSpellCheckEnabled)
+        setSpellCheckEnabled(*std::exchange(m_pendingSpellCheckEnabled, std::nullopt));
+#endif // QT_CONFIG(webengine_spellchecker)
+
     m_prefService->SchedulePendingLossyWrites();
+    if (m_loadedCallback)
+        std::move(m_loadedCallback).Run();
+}
+
+// static
+scoped_refptr<base::SequencedTaskRunner> PrefServiceAdapter::createStoreTaskRunner(const ProfileAdapter &adapter)
+{
+    auto taskRunner = base::ThreadPool::CreateSequencedTaskRunner(
+            { base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+              base::TaskShutdownBehavior::BLOCK_SHUTDOWN });
+    taskRunner->PostTask(FROM_HERE,
+                         base::BindOnce(base::IgnoreResult(&base::CreateDirectory),
+                                        toFilePath(adapter.dataPath())));
+    return taskRunner;
 }
 
 void PrefServiceAdapter::commit()
@@ -190,6 +242,10 @@ std::string PrefServiceAdapter::mediaDeviceIdSalt() const
 
 void PrefServiceAdapter::setSpellCheckLanguages(const QStringList &languages)
 {
+    if (!m_loaded) {
+        m_pendingSpellCheckLanguages = languages;
+        return;
+    }
     StringListPrefMember dictionaries_pref;
     dictionaries_pref.Init(spellcheck::prefs::kSpellCheckDictionaries, m_prefService.get());
     std::vector<std::string> dictionaries;
@@ -202,6 +258,8 @@ void PrefServiceAdapter::setSpellCheckLanguages(const QStringList &languages)
 
 QStringList PrefServiceAdapter::spellCheckLanguages() const
 {
+    if (m_pendingSpellCheckLanguages)
+        return *m_pendingSpellCheckLanguages;
     QStringList spellcheck_dictionaries;
     const auto &list = m_prefService->GetList(spellcheck::prefs::kSpellCheckDictionaries);
     for (const auto &dictionary : list) {
@@ -213,6 +271,10 @@ QStringList PrefServiceAdapter::spellCheckLanguages() const
 
 void PrefServiceAdapter::setSpellCheckEnabled(bool enabled)
 {
+    if (!m_loaded) {
+        m_pendingSpellCheckEnabled = enabled;
+        return;
+    }
     if (enabled == m_prefService->GetBoolean(spellcheck::prefs::kSpellCheckEnable))
         return;
 
@@ -224,6 +286,8 @@ void PrefServiceAdapter::setSpellCheckEnabled(bool enabled)
 
 bool PrefServiceAdapter::isSpellCheckEnabled() const
 {
+    if (m_pendingSpellCheckEnabled)
+        return *m_pendingSpellCheckEnabled;
     return m_prefService->GetBoolean(spellcheck::prefs::kSpellCheckEnable);
 }
 
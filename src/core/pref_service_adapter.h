@@ -4,9 +4,17 @@
 #ifndef PREF_SERVICE_ADAPTER_H
 #define PREF_SERVICE_ADAPTER_H
 
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
 #include "components/prefs/pref_service.h"
 #include "qtwebenginecoreglobal_p.h"
 
+#include <optional>
+
+namespace base {
+class SequencedTaskRunner;
+}
+
 namespace QtWebEngineCore {
 
 class ProfileAdapter;
@@ -20,8 +28,14 @@ public:
 
     PrefServiceAdapter() = default;
 
-    void setup(const ProfileAdapter &adapter);
+    // With a loadedCallback, the stored preferences are read in the background and the
+    // callback is called once they are available. A setup while that is pending also reads
+    // in the background and completes it.
+    void setup(const ProfileAdapter &adapter, base::OnceClosure loadedCallback = {});
     void commit();
+    // Returns a new sequence for reading and writing the stores of the profile in the
+    // background. Its first task creates the data path.
+    static scoped_refptr<base::SequencedTaskRunner> createStoreTaskRunner(const ProfileAdapter &adapter);
     PrefService *prefService();
     const PrefService *prefService() const;
     std::string mediaDeviceIdSalt() const;
@@ -34,7 +48,16 @@ public:
 #endif // QT_CONFIG(webengine_spellchecker)
 
 private:
+    void loaded();
+
     std::unique_ptr<PrefService> m_prefService;
+    base::OnceClosure m_loadedCallback;
+    bool m_loaded = false;
+#if QT_CONFIG(webengine_spellchecker)
+    // Set before the stored preferences were read, which would replace them.
+    std::optional<QStringList> m_pendingSpellCheckLanguages;
+    std::optional<bool> m_pendingSpellCheckEnabled;
+#endif // QT_CONFIG(webengine_spellchecker)
 };
 
 }
@@ -21,6 +21,8 @@
 #include <QtGui/qpagesize.h>
 #include <QWebEngineSettings>
 
+#include "base/containers/span.h"
+#include "base/files/file.h"
 #include "base/values.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/task/thread_pool.h"
@@ -33,39 +35,61 @@
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/render_frame_host.h"
-#include "printing/metafile_skia.h"
 #include "printing/mojom/print.mojom-shared.h"
 #include "printing/print_job_constants.h"
 #include "printing/units.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 
+#include <algorithm>
+
 namespace {
 
 static const qreal kMicronsToMillimeter = 1000.0f;
 
+// Wraps the mapped metafile without copying it. The mapping is kept alive for as long as the
+// returned byte array exists, so code handing the data out to users must detach it first.
 static QSharedPointer<QByteArray> GetStdVectorFromHandle(const base::ReadOnlySharedMemoryRegion &handle)
 {
-    base::ReadOnlySharedMemoryMapping map = handle.Map();
-    if (!map.IsValid())
+    auto map = std::make_unique<base::ReadOnlySharedMemoryMapping>(handle.Map());
+    if (!map->IsValid())
         return QSharedPointer<QByteArray>(new QByteArray);
 
-    const char* data = static_cast<const char*>(map.memory());
-    return QSharedPointer<QByteArray>(new QByteArray(data, map.size()));
+    const char *data = static_cast<const char *>(map->memory());
+    QByteArray *array = new QByteArray(QByteArray::fromRawData(data, map->size()));
+    return QSharedPointer<QByteArray>(array, [mapping = map.release()](QByteArray *array) {
+        delete array;
+        delete mapping;
+    });
 }
 
+// Size of the blocks the PDF file is written in; progress is reported after each block.
+static const size_t kPdfWriteChunkSize = 1024 * 1024;
+
 // Write the PDF file to disk.
+// The document is written straight from the shared memory mapping in blocks, instead of first
+// copying it into a MetafileSkia, so saving does not hold a second copy of the document.
 static void SavePdfFile(scoped_refptr<base::RefCountedSharedMemoryMapping> data,
                         const base::FilePath &path,
-                        QtWebEngineCore::PrintViewManagerQt::PrintToPDFFileCallback saveCallback)
+                        QtWebEngineCore::PrintViewManagerQt::PrintToPDFFileCallback saveCallback,
+                        QtWebEngineCore::PrintViewManagerQt::PrintToPDFProgressCallback progressCallback)
 {
     DCHECK_GT(data->size(), 0U);
 
-    printing::MetafileSkia metafile;
-    metafile.InitFromData(*data);
-
     base::File file(path,
                     base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
-    bool success = file.IsValid() && metafile.SaveTo(&file);
+    bool success = file.IsValid();
+    const base::span<const uint8_t> bytes = base::span(*data);
+    size_t written = 0;
+    while (success && written < bytes.size()) {
+        const size_t chunk = std::min(kPdfWriteChunkSize, bytes.size() - written);
+        success = file.WriteAtCurrentPosAndCheck(bytes.subspan(written, chunk));
+        if (success) {
+            written += chunk;
+            if (!progressCallback.is_null())
+                content::GetUIThreadTaskRunner({})->PostTask(FROM_HERE,
+                               base::BindOnce(progressCallback, written, bytes.size()));
+        }
+    }
     content::GetUIThreadTaskRunner({})->PostTask(FROM_HERE,
                    base::BindOnce(std::move(saveCallback), success));
 }
@@ -159,7 +183,8 @@ void PrintViewManagerQt::PrintToPDFFileWithCallback(const QPageLayout &pageLayou
                                                     const QPageRanges &pageRanges,
                                                     bool printInColor, const QString &filePath,
                                                     quint64 frameId,
-                                                    PrintToPDFFileCallback callback)
+                                                    PrintToPDFFileCallback callback,
+                                                    PrintToPDFProgressCallback progressCallback)
 {
     if (callback.is_null())
         return;
@@ -172,6 +197,7 @@ void PrintViewManagerQt::PrintToPDFFileWithCallback(const QPageLayout &pageLayou
 
     m_pdfOutputPath = toFilePath(filePath);
     m_pdfSaveCallback = std::move(callback);
+    m_pdfProgressCallback = std::move(progressCallback);
     if (!PrintToPDFInternal(pageLayout, pageRanges, printInColor, frameId)) {
         content::GetUIThreadTaskRunner({})->PostTask(FROM_HERE,
                        base::BindOnce(std::move(m_pdfSaveCallback), false));
@@ -292,6 +318,7 @@ void PrintViewManagerQt::resetPdfState()
     m_pdfOutputPath.clear();
     m_pdfPrintCallback.Reset();
     m_pdfSaveCallback.Reset();
+    m_pdfProgressCallback.Reset();
     m_printSettings.clear();
 }
 
@@ -411,6 +438,7 @@ void PrintViewManagerQt::MetafileReadyForPrinting(printing::mojom::DidPreviewDoc
     // Create local copies so we can reset the state and take a new pdf print job.
     PrintToPDFCallback pdf_print_callback = std::move(m_pdfPrintCallback);
     PrintToPDFFileCallback pdf_save_callback = std::move(m_pdfSaveCallback);
+    PrintToPDFProgressCallback pdf_progress_callback = std::move(m_pdfProgressCallback);
     base::FilePath pdfOutputPath = m_pdfOutputPath;
 
     resetPdfState();
@@ -422,7 +450,8 @@ void PrintViewManagerQt::MetafileReadyForPrinting(printing::mojom::DidPreviewDoc
     } else {
         auto data_bytes = base::RefCountedSharedMemoryMapping::CreateFromWholeRegion(params->content->metafile_data_region);
         base::ThreadPool::PostTask(FROM_HERE, { base::MayBlock() },
-                                   base::BindOnce(&SavePdfFile, std::move(data_bytes), pdfOutputPath, std::move(pdf_save_callback)));
+                                   base::BindOnce(&SavePdfFile, std::move(data_bytes), pdfOutputPath,
+                                                  std::move(pdf_save_callback), std::move(pdf_progress_callback)));
     }
 }
 
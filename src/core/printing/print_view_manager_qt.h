@@ -40,11 +40,13 @@ public:
 
     typedef base::OnceCallback<void(QSharedPointer<QByteArray> result)> PrintToPDFCallback;
     typedef base::OnceCallback<void(bool success)> PrintToPDFFileCallback;
+    typedef base::RepeatingCallback<void(qint64 bytesWritten, qint64 bytesTotal)> PrintToPDFProgressCallback;
 
     // Method to print a page to a Pdf document with page size \a pageSize in location \a filePath.
     void PrintToPDFFileWithCallback(const QPageLayout &pageLayout, const QPageRanges &pageRanges,
                                     bool printInColor, const QString &filePath, quint64 frameId,
-                                    PrintToPDFFileCallback callback);
+                                    PrintToPDFFileCallback callback,
+                                    PrintToPDFProgressCallback progressCallback = {});
     void PrintToPDFWithCallback(const QPageLayout &pageLayout, const QPageRanges &pageRanges,
                                 bool printInColor, quint64 frameId, PrintToPDFCallback callback);
 
@@ -84,6 +86,7 @@ private:
     base::FilePath m_pdfOutputPath;
     PrintToPDFCallback m_pdfPrintCallback;
     PrintToPDFFileCallback m_pdfSaveCallback;
+    PrintToPDFProgressCallback m_pdfProgressCallback;
     base::Value::Dict m_printSettings;
 
     friend class content::WebContentsUserData<PrintViewManagerQt>;
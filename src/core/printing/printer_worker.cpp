@@ -6,11 +6,111 @@
 
 #include "printing/pdfium_document_wrapper_qt.h"
 
+#include <QHash>
+#include <QMutex>
 #include <QPainter>
 #include <QPagedPaintDevice>
+#include <QSaveFile>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <deque>
+#include <memory>
 
 namespace QtWebEngineCore {
 
+namespace {
+
+// Number of pages rendered ahead of the page currently being painted.
+constexpr int kPrefetchPages = 4;
+
+// Upper bound for the memory used to keep rendered pages around for further uncollated
+// document copies. Pages that do not fit are rendered again for every copy.
+constexpr qsizetype kRetainedPagesBudget = 256 * 1024 * 1024;
+
+struct PageJob
+{
+    int index;
+    QSize size;
+};
+
+// Renders pages on a dedicated thread ahead of the painter. PDFium is not thread-safe, so all
+// rendering of a document happens on this one thread; the printer thread only paints and spools
+// the finished images, which overlaps the two instead of alternating between them.
+class PageRasterizer
+{
+public:
+    PageRasterizer(PdfiumDocumentWrapperQt &pdfium, std::vector<PageJob> jobs)
+        : m_pdfium(pdfium), m_jobs(std::move(jobs))
+    {
+        m_thread.reset(QThread::create([this]() { run(); }));
+        m_thread->start();
+    }
+
+    ~PageRasterizer()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_cancelled = true;
+            m_consumed.wakeAll();
+        }
+        m_thread->wait();
+    }
+
+    // Returns the next page in job order, blocking until it is rendered.
+    QImage takeNext()
+    {
+        QMutexLocker locker(&m_mutex);
+        while (m_queue.empty() && !m_finished)
+            m_produced.wait(&m_mutex);
+        if (m_queue.empty())
+            return QImage();
+        QImage image = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_consumed.wakeAll();
+        return image;
+    }
+
+private:
+    void run()
+    {
+        for (const PageJob &job : m_jobs) {
+            {
+                QMutexLocker locker(&m_mutex);
+                while (m_queue.size() >= kPrefetchPages && !m_cancelled)
+                    m_consumed.wait(&m_mutex);
+                if (m_cancelled)
+                    break;
+            }
+
+            QImage image = m_pdfium.pageAsQImage(job.index, job.size.width(), job.size.height());
+
+            QMutexLocker locker(&m_mutex);
+            if (image.isNull())
+                break;
+            m_queue.push_back(std::move(image));
+            m_produced.wakeAll();
+        }
+
+        QMutexLocker locker(&m_mutex);
+        m_finished = true;
+        m_produced.wakeAll();
+    }
+
+    PdfiumDocumentWrapperQt &m_pdfium;
+    const std::vector<PageJob> m_jobs;
+    std::unique_ptr<QThread> m_thread;
+
+    QMutex m_mutex;
+    QWaitCondition m_produced;
+    QWaitCondition m_consumed;
+    std::deque<QImage> m_queue;
+    bool m_cancelled = false;
+    bool m_finished = false;
+};
+
+} // namespace
+
 PrinterWorker::PrinterWorker(QSharedPointer<QByteArray> data, QPagedPaintDevice *device)
     : m_data(data), m_device(device)
 {
@@ -18,6 +118,19 @@ PrinterWorker::PrinterWorker(QSharedPointer<QByteArray> data, QPagedPaintDevice
 
 PrinterWorker::~PrinterWorker() { }
 
+bool PrinterWorker::savePdf()
+{
+    QSaveFile file(m_pdfOutputFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning("Failure to print on device: Could not open %ls for writing.",
+                 qUtf16Printable(m_pdfOutputFileName));
+        return false;
+    }
+    if (file.write(*m_data) != m_data->size())
+        return false;
+    return file.commit();
+}
+
 void PrinterWorker::print()
 {
     if (!m_data->size()) {
@@ -39,6 +152,12 @@ void PrinterWorker::print()
         Q_EMIT resultReady(ok);
     };
 
+    // The document generated by Chromium already has the requested page layout and ranges
+    // applied, so PDF output can take it as is and keep its vector content. Reversed page
+    // order and multiple copies still need to go through the painter.
+    if (!m_pdfOutputFileName.isEmpty() && m_firstPageFirst && m_documentCopies == 1)
+        return finish(savePdf());
+
     PdfiumDocumentWrapperQt pdfiumWrapper(m_data->constData(), m_data->size());
 
     const int fromPage = m_firstPageFirst ? 0 : pdfiumWrapper.pageCount() - 1;
@@ -52,31 +171,65 @@ void PrinterWorker::print()
 
     qreal resolution = m_deviceResolution / 72.0; // pdfium uses points so 1/72 inch
 
+    // Determine the layout of every page up front, so the rasterizer thread is the only
+    // user of the document once printing starts. The layout is read back from the device,
+    // which applies the minimum margins and page sizes of the printer.
+    struct PageInfo
+    {
+        QPageSize pageSize;
+        QPageLayout::Orientation orientation;
+    };
+    QHash<int, PageInfo> pages;
+    std::vector<PageJob> jobs;
+    for (int i = fromPage; i != toPage; m_firstPageFirst ? i++ : i--) {
+        // Page size (A4, A5, etc...)
+        QSizeF pageSizePoints = pdfiumWrapper.pageSize(i);
+        QPageSize pageSize(pageSizePoints, QPageSize::Point, QString(),
+                           QPageSize::FuzzyOrientationMatch);
+
+        // Page orientation
+        bool isLandscape = pageSizePoints.width() > pageSizePoints.height();
+        QPageLayout::Orientation orientation = isLandscape ? QPageLayout::Landscape
+                                                           : QPageLayout::Portrait;
+
+        m_device->setPageSize(pageSize);
+        m_device->setPageOrientation(orientation);
+        // Margins: they are determined at PDF generation; don't apply them here again
+        m_device->setPageMargins(QMarginsF());
+
+        QSizeF documentSize = pageSizePoints * resolution;
+        QRectF paintRect = m_device->pageLayout().paintRectPixels(m_deviceResolution);
+        documentSize = documentSize.scaled(paintRect.size(), Qt::KeepAspectRatio);
+
+        pages.insert(i, PageInfo{ pageSize, orientation });
+        jobs.push_back(PageJob{ i, documentSize.toSize() });
+    }
+
+    // Pages kept for further uncollated document copies.
+    QHash<int, QImage> retainedPages;
+    qsizetype retainedBytes = 0;
+
     QPainter painter;
 
     for (int printedDocuments = 0; printedDocuments < m_documentCopies; printedDocuments++) {
         if (printedDocuments > 0)
             m_device->newPage();
 
-        for (int i = fromPage; i != toPage; m_firstPageFirst ? i++ : i--) {
-            // Page size (A4, A5, etc...)
-            QSizeF pageSizePoints = pdfiumWrapper.pageSize(i);
-            QPageSize pageSize(pageSizePoints, QPageSize::Point, QString(),
-                               QPageSize::FuzzyOrientationMatch);
-            m_device->setPageSize(pageSize);
-
-            // Page orientation
-            bool isLandscape = pageSizePoints.width() > pageSizePoints.height();
-            m_device->setPageOrientation(isLandscape ? QPageLayout::Landscape
-                                                      : QPageLayout::Portrait);
+        std::vector<PageJob> pendingJobs;
+        for (const PageJob &job : jobs) {
+            if (!retainedPages.contains(job.index))
+                pendingJobs.push_back(job);
+        }
+        PageRasterizer rasterizer(pdfiumWrapper, std::move(pendingJobs));
+        const bool retainPages = printedDocuments + 1 < m_documentCopies;
 
-            // Margins: they are determined at PDF generation; don't apply them here again
+        for (const PageJob &job : jobs) {
+            const int i = job.index;
+            const PageInfo &info = pages[i];
+            m_device->setPageSize(info.pageSize);
+            m_device->setPageOrientation(info.orientation);
             m_device->setPageMargins(QMarginsF());
 
-            QSizeF documentSize = pageSizePoints * resolution;
-            QRectF paintRect = m_device->pageLayout().paintRectPixels(m_deviceResolution);
-            documentSize = documentSize.scaled(paintRect.size(), Qt::KeepAspectRatio);
-
             // setPageOrientation has to be called before qpainter.begin() or before
             // qprinter.newPage() so correct metrics is used, therefore call begin now for only
             // first page
@@ -88,14 +241,22 @@ void PrinterWorker::print()
             if (i != fromPage)
                 m_device->newPage();
 
+            // Each page is rendered once and painted for all collated copies.
+            QImage currentImage = retainedPages.value(i);
+            if (currentImage.isNull()) {
+                currentImage = rasterizer.takeNext();
+                if (currentImage.isNull())
+                    return finish(false);
+                if (retainPages && retainedBytes + currentImage.sizeInBytes() <= kRetainedPagesBudget) {
+                    retainedBytes += currentImage.sizeInBytes();
+                    retainedPages.insert(i, currentImage);
+                }
+            }
+
             for (int printedPages = 0; printedPages < pageCopies; printedPages++) {
                 if (printedPages > 0)
                     m_device->newPage();
 
-                QImage currentImage =
-                        pdfiumWrapper.pageAsQImage(i, documentSize.width(), documentSize.height());
-                if (currentImage.isNull())
-                    return finish(false);
                 painter.drawImage(0, 0, currentImage);
             }
         }
@@ -20,6 +20,7 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/qsharedpointer.h>
+#include <QtCore/qstring.h>
 
 QT_BEGIN_NAMESPACE
 class QPagedPaintDevice;
@@ -38,6 +39,9 @@ public:
     bool m_firstPageFirst;
     int m_documentCopies;
     bool m_collateCopies;
+    // If set, the device writes to this PDF file and the document is saved to it
+    // unchanged instead of being rasterized.
+    QString m_pdfOutputFileName;
 
 public Q_SLOTS:
     void print();
@@ -48,6 +52,8 @@ Q_SIGNALS:
 private:
     Q_DISABLE_COPY(PrinterWorker)
 
+    bool savePdf();
+
     QSharedPointer<QByteArray> m_data;
     QPagedPaintDevice *m_device;
 };
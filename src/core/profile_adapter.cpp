@@ -4,7 +4,9 @@
 #include "profile_adapter.h"
 
 #include "base/files/file_util.h"
+#include "base/functional/bind.h"
 #include "base/task/cancelable_task_tracker.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/version_info/version_info.h"
 #include "components/embedder_support/user_agent_utils.h"
@@ -17,7 +19,9 @@
 #include "content/public/browser/browsing_data_remover.h"
 #include "content/public/browser/download_manager.h"
 #include "content/public/browser/storage_partition.h"
+#include "services/network/public/mojom/clear_data_filter.mojom.h"
 #include "services/network/public/mojom/network_context.mojom.h"
+#include "url/origin.h"
 #include "url/url_util.h"
 
 #include "api/qwebengineextensionmanager.h"
@@ -26,6 +30,8 @@
 #include "download_manager_delegate_qt.h"
 #include "favicon_driver_qt.h"
 #include "favicon_service_factory_qt.h"
+#include "net/network_predictor_qt.h"
+#include "net/shared_http_cache_qt.h"
 #include "permission_manager_qt.h"
 #include "profile_adapter_client.h"
 #include "profile_io_data_qt.h"
@@ -36,6 +42,7 @@
 #include "web_contents_adapter.h"
 #include "web_contents_adapter_client.h"
 #include "web_contents_delegate_qt.h"
+#include "web_contents_pool.h"
 #include "web_engine_context.h"
 
 #include <QCoreApplication>
@@ -96,7 +103,8 @@ ProfileAdapter::ProfileAdapter(const QString &storageName, const QString &dataPa
                                PersistentCookiesPolicy persistentCookiesPolicy,
                                int httpCacheMaximumSize,
                                PersistentPermissionsPolicy persistentPermissionPolicy,
-                               const QList<QSslCertificate> &additionalTrustedCertificates)
+                               const QList<QSslCertificate> &additionalTrustedCertificates,
+                               bool loadAsynchronously)
     : m_name(storageName)
     , m_offTheRecord(storageName.isEmpty())
     , m_dataPath(dataPath.isEmpty() && !m_name.isEmpty() ? buildLocationFromStandardPath(
@@ -116,25 +124,56 @@ ProfileAdapter::ProfileAdapter(const QString &storageName, const QString &dataPa
     , m_httpCacheMaxSize(m_name.isEmpty() ? 0 : httpCacheMaximumSize)
 {
     WebEngineContext::current()->addProfileAdapter(this);
+    // The preferences and the permissions are read in the background, the profile is ready
+    // once both are.
+    if (loadAsynchronously && !m_offTheRecord)
+        m_pendingLoads = 2;
+    auto loadedCallback = [this]() -> base::OnceClosure {
+        if (isReady())
+            return {};
+        return base::BindOnce(&ProfileAdapter::loadFinished, base::Unretained(this));
+    };
     // creation of profile requires webengine context
-    m_profile.reset(new ProfileQt(this));
+    m_profile.reset(new ProfileQt(this, loadedCallback()));
     // initialize permissions store
-    profile()->GetPermissionControllerDelegate();
+    m_profile->setupPermissionsManager(loadedCallback());
     // fixme: this should not be here
     m_profile->m_profileIOData->initializeOnUIThread();
     m_customUrlSchemeHandlers.insert(QByteArrayLiteral("qrc"), &m_qrcHandler);
     m_cancelableTaskTracker.reset(new base::CancelableTaskTracker());
 
-#if QT_CONFIG(webengine_extensions)
-    m_extensionManager.reset(new QWebEngineExtensionManager(m_profile->extensionManager()));
-#endif
+    if (isReady())
+        m_profile->DoFinalInit();
+}
+
+void ProfileAdapter::loadFinished()
+{
+    Q_ASSERT(m_pendingLoads > 0);
+    if (--m_pendingLoads)
+        return;
     m_profile->DoFinalInit();
+    for (const auto &callback : std::exchange(m_readyWaiters, {}))
+        callback();
+    for (auto *client : std::as_const(m_clients))
+        client->profileReady();
+}
+
+void ProfileAdapter::callWhenReady(std::function<void()> callback)
+{
+    if (isReady())
+        callback();
+    else
+        m_readyWaiters.append(std::move(callback));
 }
 
 ProfileAdapter::~ProfileAdapter()
 {
     m_cancelableTaskTracker->TryCancelAll();
     m_profile->NotifyWillBeDestroyed();
+    // Pages released below must not hand their WebContents to a pool that is going away.
+    m_webContentsPool.reset();
+    m_networkPredictor.reset();
+    m_sharedHttpCache.reset();
     releaseAllWebContentsAdapterClients();
 
     WebEngineContext::current()->removeProfileAdapter(this);
@@ -340,6 +379,48 @@ void ProfileAdapter::setDownloadPath(const QString &path)
     m_downloadPath = path.isEmpty() ? QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) : path;
 }
 
+void ProfileAdapter::setDownloadProgressInterval(int milliseconds)
+{
+    m_downloadProgressInterval = qMax(0, milliseconds);
+}
+
+int ProfileAdapter::webContentsPoolCapacity() const
+{
+    return m_webContentsPool ? m_webContentsPool->capacity() : 0;
+}
+
+void ProfileAdapter::setWebContentsPoolCapacity(int capacity)
+{
+    if (capacity <= 0) {
+        m_webContentsPool.reset();
+        return;
+    }
+    if (m_webContentsPool)
+        m_webContentsPool->setCapacity(capacity);
+    else
+        m_webContentsPool = std::make_unique<WebContentsPool>(capacity);
+}
+
+NetworkPredictorQt *ProfileAdapter::ensureNetworkPredictor()
+{
+    if (!m_networkPredictor)
+        m_networkPredictor = std::make_unique<NetworkPredictorQt>(this);
+    return m_networkPredictor.get();
+}
+
+QString ProfileAdapter::sharedHttpCachePath() const
+{
+    return m_sharedHttpCache ? m_sharedHttpCache->directory() : QString();
+}
+
+void ProfileAdapter::setSharedHttpCachePath(const QString &path)
+{
+    if (path.isEmpty())
+        m_sharedHttpCache.reset();
+    else
+        m_sharedHttpCache = SharedHttpCacheQt::forDirectory(path);
+}
+
 QString ProfileAdapter::cachePath() const
 {
     if (m_offTheRecord)
@@ -662,6 +743,22 @@ QList<QWebEnginePermission> ProfileAdapter::listPermissions(const QUrl &origin,
     return static_cast<PermissionManagerQt*>(profile()->GetPermissionControllerDelegate())->listPermissions(origin, permissionType);
 }
 
+QJsonObject ProfileAdapter::exportPermissions() const
+{
+    if (persistentPermissionsPolicy() == ProfileAdapter::PersistentPermissionsPolicy::AskEveryTime)
+        return QJsonObject();
+
+    return static_cast<PermissionManagerQt*>(m_profile->GetPermissionControllerDelegate())->exportPermissions();
+}
+
+qsizetype ProfileAdapter::importPermissions(const QJsonObject &permissions)
+{
+    if (persistentPermissionsPolicy() == ProfileAdapter::PersistentPermissionsPolicy::AskEveryTime)
+        return 0;
+
+    return static_cast<PermissionManagerQt*>(profile()->GetPermissionControllerDelegate())->importPermissions(permissions);
+}
+
 QString ProfileAdapter::httpAcceptLanguageWithoutQualities() const
 {
     QString out;
@@ -820,6 +917,69 @@ void ProfileAdapter::clearHttpCache()
     m_profile->m_profileIOData->clearHttpCache();
 }
 
+void ProfileAdapter::requestHttpCacheEntries(std::function<void(const QList<HttpCacheFiles::Entry> &)> callback)
+{
+    if (httpCacheType() != DiskHttpCache) {
+        callback({});
+        return;
+    }
+    base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, { base::MayBlock(), base::TaskPriority::USER_VISIBLE },
+            base::BindOnce(&HttpCacheFiles::entries, httpCachePath()),
+            base::BindOnce([](std::function<void(const QList<HttpCacheFiles::Entry> &)> callback,
+                              QList<HttpCacheFiles::Entry> entries) { callback(entries); },
+                           std::move(callback)));
+}
+
+void ProfileAdapter::removeHttpCacheEntries(const QList<QUrl> &origins, const QDateTime &lastUsedBefore,
+                                            std::function<void()> callback)
+{
+    network::mojom::ClearDataFilterPtr filter;
+    if (!origins.isEmpty()) {
+        filter = network::mojom::ClearDataFilter::New();
+        filter->type = network::mojom::ClearDataFilter::Type::DELETE_MATCHES;
+        for (const QUrl &origin : origins)
+            filter->origins.push_back(url::Origin::Create(toGurl(origin)));
+    }
+    const base::Time end = lastUsedBefore.isValid() ? toTime(lastUsedBefore) : base::Time::Max();
+    m_profile->GetDefaultStoragePartition()->GetNetworkContext()->ClearHttpCache(
+            base::Time(), end, std::move(filter),
+            base::BindOnce([](std::function<void()> callback) {
+                if (callback)
+                    callback();
+            }, std::move(callback)));
+}
+
+void ProfileAdapter::removeHttpCacheEntriesWithPrefix(const QString &urlPrefix,
+                                                      std::function<void(qsizetype)> callback)
+{
+    if (httpCacheType() != DiskHttpCache) {
+        if (callback)
+            callback(0);
+        return;
+    }
+    m_profile->m_profileIOData->removeHttpCacheEntriesWithPrefix(urlPrefix, std::move(callback));
+}
+
+void ProfileAdapter::importHttpCache(const QString &snapshotDirectory, std::function<void(bool)> callback)
+{
+    // Only a disk cache that is not in use yet can be replaced, otherwise the import is kept
+    // for the next time the cache is opened.
+    const QString cachePath = httpCachePath();
+    if (httpCacheType() != DiskHttpCache || cachePath.isEmpty()) {
+        if (callback)
+            callback(false);
+        return;
+    }
+    base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, { base::MayBlock(), base::TaskPriority::USER_VISIBLE },
+            base::BindOnce(&HttpCacheFiles::stageImport, snapshotDirectory, cachePath),
+            base::BindOnce([](std::function<void(bool)> callback, bool staged) {
+                if (callback)
+                    callback(staged);
+            }, std::move(callback)));
+}
+
 void ProfileAdapter::setSpellCheckLanguages(const QStringList &languages)
 {
 #if QT_CONFIG(webengine_spellchecker)
@@ -1040,9 +1200,22 @@ void ProfileAdapter::requestIconForIconURL(const QUrl &iconUrl,
                            touchIconsEnabled),
             m_cancelableTaskTracker.get());
 }
+
+void ProfileAdapter::initializeExtensions()
+{
+    m_profile->initializeExtensions();
+#if QT_CONFIG(webengine_extensions)
+    if (!m_extensionManager)
+        m_extensionManager.reset(new QWebEngineExtensionManager(m_profile->extensionManager()));
+#endif
+}
+
 #if QT_CONFIG(webengine_extensions)
 QWebEngineExtensionManager *ProfileAdapter::extensionManager()
 {
+    // Extensions are only loaded on first use, which needs the stored preferences.
+    if (!m_extensionManager && isReady())
+        initializeExtensions();
     return m_extensionManager.get();
 }
 #endif
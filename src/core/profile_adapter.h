@@ -31,8 +31,10 @@
 #include <QtWebEngineCore/qwebengineurlrequestinterceptor.h>
 #include <QtWebEngineCore/qwebengineurlschemehandler.h>
 #include <QtWebEngineCore/qwebenginepermission.h>
+#include "net/http_cache_files_qt.h"
 #include "net/qrc_url_scheme_handler.h"
 
+QT_FORWARD_DECLARE_CLASS(QJsonObject)
 QT_FORWARD_DECLARE_CLASS(QObject)
 
 namespace base {
@@ -47,11 +49,14 @@ namespace QtWebEngineCore {
 
 class UserNotificationController;
 class DownloadManagerDelegateQt;
+class NetworkPredictorQt;
 class ProfileAdapterClient;
 class ProfileQt;
+class SharedHttpCacheQt;
 class UserResourceControllerHost;
 class VisitedLinksManagerQt;
 class WebContentsAdapterClient;
+class WebContentsPool;
 
 class Q_WEBENGINECORE_EXPORT ProfileAdapter : public QObject
 {
@@ -97,7 +102,8 @@ public:
             int httpCacheMaximumSize = 0,
             PersistentPermissionsPolicy persistentPermissionPolicy =
                     PersistentPermissionsPolicy::StoreOnDisk,
-            const QList<QSslCertificate> &additionalTrustedCertificates = {});
+            const QList<QSslCertificate> &additionalTrustedCertificates = {},
+            bool loadAsynchronously = false);
     virtual ~ProfileAdapter();
 
     static ProfileAdapter* createDefaultProfileAdapter();
@@ -128,6 +134,11 @@ public:
     ProfileQt *profile();
     bool ensureDataPathExists();
 
+    // False while the stores of a profile created with loadAsynchronously are being read.
+    bool isReady() const { return m_pendingLoads == 0; }
+    // Calls callback once the profile is ready, for pages created before that.
+    void callWhenReady(std::function<void()> callback);
+
     QString storageName() const { return m_name; }
     void setStorageName(const QString &storageName);
 
@@ -140,11 +151,26 @@ public:
     QString downloadPath() const { return m_downloadPath; }
     void setDownloadPath(const QString &path);
 
+    int downloadProgressInterval() const { return m_downloadProgressInterval; }
+    void setDownloadProgressInterval(int milliseconds);
+
+    int webContentsPoolCapacity() const;
+    void setWebContentsPoolCapacity(int capacity);
+    WebContentsPool *webContentsPool() const { return m_webContentsPool.get(); }
+
+    // Only exists once the application asked for a network warm-up.
+    NetworkPredictorQt *networkPredictor() const { return m_networkPredictor.get(); }
+    NetworkPredictorQt *ensureNetworkPredictor();
+
     QString cachePath() const;
     void setCachePath(const QString &path);
 
     QString httpCachePath() const;
 
+    QString sharedHttpCachePath() const;
+    void setSharedHttpCachePath(const QString &path);
+    SharedHttpCacheQt *sharedHttpCache() const { return m_sharedHttpCache.get(); }
+
     QString httpUserAgent() const;
     void setHttpUserAgent(const QString &userAgent);
 
@@ -159,6 +185,7 @@ public:
     void addWebContentsAdapterClient(WebContentsAdapterClient *client);
     void removeWebContentsAdapterClient(WebContentsAdapterClient *client);
     void releaseAllWebContentsAdapterClients();
+    QList<WebContentsAdapterClient *> webContentsAdapterClients() const { return m_webContentsAdapterClients; }
 
     HttpCacheType httpCacheType() const;
     void setHttpCacheType(ProfileAdapter::HttpCacheType);
@@ -192,6 +219,8 @@ public:
         int childId = -1, const std::string &serializedToken = std::string());
     QList<QWebEnginePermission> listPermissions(const QUrl &origin = QUrl(),
         QWebEnginePermission::PermissionType permissionType = QWebEnginePermission::PermissionType::Unsupported);
+    QJsonObject exportPermissions() const;
+    qsizetype importPermissions(const QJsonObject &permissions);
 
     QString httpAcceptLanguageWithoutQualities() const;
     QString httpAcceptLanguage() const;
@@ -204,7 +233,16 @@ public:
     void resetClientHints();
 
     void clearHttpCache();
+    void requestHttpCacheEntries(std::function<void(const QList<HttpCacheFiles::Entry> &)> callback);
+    void removeHttpCacheEntries(const QList<QUrl> &origins, const QDateTime &lastUsedBefore,
+                                std::function<void()> callback);
+    void removeHttpCacheEntriesWithPrefix(const QString &urlPrefix,
+                                          std::function<void(qsizetype)> callback);
+    void importHttpCache(const QString &snapshotDirectory, std::function<void(bool)> callback);
+    // Loads the extensions of a ready profile, done when its first page is initialized.
+    void initializeExtensions();
 #if QT_CONFIG(webengine_extensions)
+    // Null until the profile is ready.
     QWebEngineExtensionManager *extensionManager();
 #endif
 #if QT_CONFIG(ssl)
@@ -230,10 +268,14 @@ private:
     void resetVisitedLinksManager();
     bool persistVisitedLinks() const;
     void reinitializeHistoryService();
+    void loadFinished();
 
     QString m_name;
     bool m_offTheRecord;
     QScopedPointer<ProfileQt> m_profile;
+    std::unique_ptr<WebContentsPool> m_webContentsPool;
+    std::unique_ptr<NetworkPredictorQt> m_networkPredictor;
+    std::shared_ptr<SharedHttpCacheQt> m_sharedHttpCache;
     QScopedPointer<VisitedLinksManagerQt> m_visitedLinksManager;
     QScopedPointer<DownloadManagerDelegateQt> m_downloadManagerDelegate;
     QScopedPointer<UserResourceControllerHost> m_userResourceController;
@@ -245,6 +287,7 @@ private:
 
     QString m_dataPath;
     QString m_downloadPath;
+    int m_downloadProgressInterval = 0;
     QString m_cachePath;
     QString m_httpUserAgent;
     HttpCacheType m_httpCacheType;
@@ -262,6 +305,8 @@ private:
     QList<WebContentsAdapterClient *> m_webContentsAdapterClients;
     bool m_pushServiceEnabled;
     int m_httpCacheMaxSize;
+    int m_pendingLoads = 0;
+    QList<std::function<void()>> m_readyWaiters;
     QrcUrlSchemeHandler m_qrcHandler;
     std::unique_ptr<base::CancelableTaskTracker> m_cancelableTaskTracker;
 #if QT_CONFIG(webengine_extensions)
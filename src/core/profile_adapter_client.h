@@ -111,6 +111,7 @@ public:
     virtual void removeWebContentsAdapterClient(WebContentsAdapterClient *adapter) = 0;
     virtual WebEngineSettings *coreSettings() const = 0;
     virtual void clearHttpCacheCompleted() = 0;
+    virtual void profileReady() { }
 
     static QString downloadInterruptReasonToString(DownloadInterruptReason reason);
 };
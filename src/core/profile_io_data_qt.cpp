@@ -3,7 +3,11 @@
 
 #include "profile_io_data_qt.h"
 
+#include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_restrictions.h"
 #include "content/browser/storage_partition_impl.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/browsing_data_remover.h"
 #include "content/public/browser/resource_context.h"
@@ -13,6 +17,7 @@
 
 #include "net/client_cert_qt.h"
 #include "net/client_cert_store_data.h"
+#include "net/http_cache_files_qt.h"
 #include "net/cookie_monster_delegate_qt.h"
 #include "net/system_network_context_manager.h"
 #include "profile_adapter_client.h"
@@ -170,6 +175,26 @@ void ProfileIODataQt::OnNetworkContextCreated(content::StoragePartition *storage
         client->clearHttpCacheCompleted();
 }
 
+void ProfileIODataQt::removeHttpCacheEntriesWithPrefix(const QString &urlPrefix,
+                                                       std::function<void(qsizetype)> callback)
+{
+    Q_ASSERT(content::BrowserThread::CurrentlyOn(content::BrowserThread::UI));
+    if (!m_networkContextConfigured) {
+        m_pendingHttpCacheRemovals.append({ urlPrefix, std::move(callback) });
+        return;
+    }
+    // The cache backend may have any of the entries open, and a backend of a reset network
+    // context may still be closing, so the files are left alone until the cache is opened
+    // again by the next process.
+    base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, { base::MayBlock(), base::TaskPriority::USER_VISIBLE },
+            base::BindOnce(&HttpCacheFiles::stageRemoval, m_profileAdapter->httpCachePath(), urlPrefix),
+            base::BindOnce([](std::function<void(qsizetype)> callback, bool staged) {
+                if (callback)
+                    callback(staged ? -1 : 0);
+            }, std::move(callback)));
+}
+
 bool ProfileIODataQt::canGetCookies(const QUrl &firstPartyUrl, const QUrl &url) const
 {
     return m_cookieDelegate->canGetCookies(firstPartyUrl, url);
@@ -191,6 +216,12 @@ std::unique_ptr<net::ClientCertStore> ProfileIODataQt::CreateClientCertStore()
 #endif
 }
 
+static void reportHttpCacheRemoval(std::function<void(qsizetype)> callback, qsizetype removed)
+{
+    if (callback)
+        callback(removed);
+}
+
 void ProfileIODataQt::ConfigureNetworkContextParams(bool in_memory,
                                                     const base::FilePath &relative_partition_path,
                                                     network::mojom::NetworkContextParams *network_context_params,
@@ -219,8 +250,24 @@ void ProfileIODataQt::ConfigureNetworkContextParams(bool in_memory,
         network_context_params->file_paths->http_server_properties_file_name = base::FilePath::FromASCII("Network Persistent State");
         network_context_params->file_paths->transport_security_persister_file_name = base::FilePath::FromASCII("TransportSecurity");
         network_context_params->file_paths->trust_token_database_name = base::FilePath::FromASCII("Trust Tokens");
-        if (m_httpCacheType == ProfileAdapter::DiskHttpCache && !m_httpCachePath.isEmpty())
+        if (m_httpCacheType == ProfileAdapter::DiskHttpCache && !m_httpCachePath.isEmpty()) {
+            // An imported cache can only replace the directory, and entries can only be
+            // removed, before the cache backend has ever opened it in this process.
+            if (!m_networkContextConfigured) {
+                base::ScopedAllowBlocking allowBlock;
+                if (HttpCacheFiles::hasStagedImport(m_httpCachePath))
+                    HttpCacheFiles::applyImport(m_httpCachePath);
+                HttpCacheFiles::applyStagedRemovals(m_httpCachePath);
+                for (auto &[urlPrefix, callback] : m_pendingHttpCacheRemovals) {
+                    const qsizetype removed =
+                            HttpCacheFiles::removeEntriesWithPrefix(m_httpCachePath, urlPrefix);
+                    content::GetUIThreadTaskRunner({})->PostTask(
+                            FROM_HERE, base::BindOnce(&reportHttpCacheRemoval, std::move(callback), removed));
+                }
+                m_pendingHttpCacheRemovals.clear();
+            }
             network_context_params->file_paths->http_cache_directory = toFilePath(m_httpCachePath);
+        }
         if (m_persistentCookiesPolicy != ProfileAdapter::NoPersistentCookies) {
             network_context_params->file_paths->cookie_database_name = base::FilePath::FromASCII("Cookies");
             network_context_params->restore_old_session_cookies = m_persistentCookiesPolicy == ProfileAdapter::ForcePersistentCookies;
@@ -228,6 +275,13 @@ void ProfileIODataQt::ConfigureNetworkContextParams(bool in_memory,
         }
     }
 
+    // Without a disk cache there was nothing to remove.
+    for (auto &[urlPrefix, callback] : m_pendingHttpCacheRemovals) {
+        content::GetUIThreadTaskRunner({})->PostTask(
+                FROM_HERE, base::BindOnce(&reportHttpCacheRemoval, std::move(callback), qsizetype(0)));
+    }
+    m_pendingHttpCacheRemovals.clear();
+    m_networkContextConfigured = true;
     network_context_params->enforce_chrome_ct_policy = false;
 
     // Should be initialized with existing per-profile CORS access lists.
@@ -69,6 +69,8 @@ public:
 
     void clearHttpCache(); // runs on ui thread
     bool isClearHttpCacheInProgress() const { return m_clearHttpCacheState != Completed; }
+    void removeHttpCacheEntriesWithPrefix(const QString &urlPrefix,
+                                          std::function<void(qsizetype)> callback); // runs on ui thread
 
     void ConfigureNetworkContextParams(bool in_memory,
                                        const base::FilePath &relative_partition_path,
@@ -111,6 +113,9 @@ private:
     BrowsingDataRemoverObserverQt m_removerObserver;
     QString m_dataPath;
     ClearHttpCacheState m_clearHttpCacheState = Completed;
+    bool m_networkContextConfigured = false;
+    // Removals requested before the cache was opened, applied right before it is.
+    QList<std::pair<QString, std::function<void(qsizetype)>>> m_pendingHttpCacheRemovals;
     base::WeakPtrFactory<ProfileIODataQt> m_weakPtrFactory; // this should be always the last member
 
     friend class BrowsingDataRemoverObserverQt;
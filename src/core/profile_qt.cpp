@@ -18,6 +18,7 @@
 
 #include "base/base_paths.h"
 #include "base/path_service.h"
+#include "base/functional/bind.h"
 #include "base/files/file_util.h"
 #include "base/task/thread_pool.h"
 #include "base/version_info/version_info.h"
@@ -49,14 +50,14 @@ enum {
     PATH_QT_END = 1999
 };
 
-ProfileQt::ProfileQt(ProfileAdapter *profileAdapter)
+ProfileQt::ProfileQt(ProfileAdapter *profileAdapter, base::OnceClosure prefsLoadedCallback)
     : m_profileIOData(new ProfileIODataQt(this)), m_profileAdapter(profileAdapter)
 {
     profile_metrics::SetBrowserProfileType(this, IsOffTheRecord()
         ? profile_metrics::BrowserProfileType::kIncognito
         : profile_metrics::BrowserProfileType::kRegular);
 
-    setupPrefService();
+    setupPrefService(std::move(prefsLoadedCallback));
     setupStoragePath();
 
     // Mark the context as live. This prevents the use-after-free DCHECK in
@@ -65,10 +66,6 @@ ProfileQt::ProfileQt(ProfileAdapter *profileAdapter)
     // destroyed one. Needs to be called after WebEngineContext initialization.
     BrowserContextDependencyManager::GetInstance()->MarkBrowserContextLive(this);
 
-#if BUILDFLAG(ENABLE_EXTENSIONS)
-    static_cast<extensions::ExtensionSystemQt*>(extensions::ExtensionSystem::Get(this))->InitForRegularProfile(true);
-#endif
-
     initUserAgentMetadata();
 }
 
@@ -219,7 +216,7 @@ content::FileSystemAccessPermissionContext *ProfileQt::GetFileSystemAccessPermis
     return FileSystemAccessPermissionContextFactoryQt::GetForProfile(this);
 }
 
-void ProfileQt::setupPrefService()
+void ProfileQt::setupPrefService(base::OnceClosure loadedCallback)
 {
     const bool recreation = m_prefServiceAdapter.prefService() != nullptr;
     profile_metrics::SetBrowserProfileType(this,
@@ -233,7 +230,7 @@ void ProfileQt::setupPrefService()
         user_prefs::UserPrefs::Remove(this);
         m_prefServiceAdapter.commit();
     }
-    m_prefServiceAdapter.setup(*m_profileAdapter);
+    m_prefServiceAdapter.setup(*m_profileAdapter, std::move(loadedCallback));
     user_prefs::UserPrefs::Set(this, m_prefServiceAdapter.prefService());
 
 #if BUILDFLAG(ENABLE_EXTENSIONS)
@@ -287,9 +284,12 @@ void ProfileQt::setupStoragePath()
 #endif // defined(Q_OS_WIN)
 }
 
-void ProfileQt::setupPermissionsManager()
+void ProfileQt::setupPermissionsManager(base::OnceClosure loadedCallback)
 {
-    m_permissionManager.reset(new PermissionManagerQt(profileAdapter()));
+    // A manager still loading in the background hands its callback over to the new one.
+    if (!loadedCallback && m_permissionManager)
+        loadedCallback = m_permissionManager->takeLoadedCallback();
+    m_permissionManager.reset(new PermissionManagerQt(profileAdapter(), std::move(loadedCallback)));
 }
 
 PrefServiceAdapter &ProfileQt::prefServiceAdapter()
@@ -329,6 +329,16 @@ content::PlatformNotificationService *ProfileQt::GetPlatformNotificationService(
     return m_platformNotificationService.get();
 }
 
+void ProfileQt::initializeExtensions()
+{
+#if BUILDFLAG(ENABLE_EXTENSIONS)
+    // The extension system reads its state from the preferences.
+    Q_ASSERT(m_profileAdapter->isReady());
+    static_cast<extensions::ExtensionSystemQt *>(extensions::ExtensionSystem::Get(this))
+            ->InitForRegularProfile(true);
+#endif
+}
+
 #if QT_CONFIG(webengine_extensions)
 ExtensionManager *ProfileQt::extensionManager()
 {
@@ -23,7 +23,9 @@ class SSLHostStateDelegateQt;
 class ProfileQt : public Profile
 {
 public:
-    explicit ProfileQt(ProfileAdapter *profileAdapter);
+    // If prefsLoadedCallback is set, the stored preferences are read in the background and
+    // prefsLoadedCallback is run once the profile uses them.
+    explicit ProfileQt(ProfileAdapter *profileAdapter, base::OnceClosure prefsLoadedCallback = {});
 
     virtual ~ProfileQt();
 
@@ -65,15 +67,18 @@ public:
 
     // Build/Re-build the preference service. Call when updating the storage
     // data path.
-    void setupPrefService();
+    void setupPrefService(base::OnceClosure loadedCallback = {});
     void setupStoragePath();
-    void setupPermissionsManager();
+    void setupPermissionsManager(base::OnceClosure loadedCallback = {});
 
     PrefServiceAdapter &prefServiceAdapter();
     const PrefServiceAdapter &prefServiceAdapter() const;
 
     void initUserAgentMetadata();
     const blink::UserAgentMetadata &userAgentMetadata();
+    // Sets up the extension system, which loads the installed extensions. Does nothing if it
+    // already is.
+    void initializeExtensions();
 #if QT_CONFIG(webengine_extensions)
     ExtensionManager *extensionManager();
 #endif
@@ -13,6 +13,7 @@
 #include "web_contents_adapter_client.h"
 #include "web_event_factory.h"
 
+#include "base/functional/callback_helpers.h"
 #include "components/input/cursor_manager.h"
 #include "components/input/events_helper.h"
 #include "components/input/render_widget_host_input_event_router.h"
@@ -118,7 +119,7 @@ static display::ScreenInfos screenInfosFromQtForUpdate(QScreen *currentScreen)
     return result;
 }
 
-// An minimal override to support progressing flings
+// An minimal override to support progressing flings and smooth scrolls
 class FlingingCompositor : public ui::Compositor
 {
     RenderWidgetHostViewQt *m_rwhv;
@@ -141,16 +142,21 @@ public:
     {
         if (args.type != viz::BeginFrameArgs::MISSED && !m_rwhv->GetViewRenderInputRouter()->is_currently_scrolling_viewport())
             m_rwhv->host()->ProgressFlingIfNeeded(args.frame_time);
+        if (InputResampler *resampler = m_rwhv->inputResampler())
+            resampler->onBeginFrame(args);
+        if (SmoothScrollController *controller = m_rwhv->smoothScrollController())
+            controller->onBeginFrame(args);
         ui::Compositor::BeginMainFrame(args);
     }
 };
 
-RenderWidgetHostViewQt::RenderWidgetHostViewQt(content::RenderWidgetHost *widget)
+RenderWidgetHostViewQt::RenderWidgetHostViewQt(content::RenderWidgetHost *widget, bool externalBeginFrames)
     : content::RenderWidgetHostViewBase::RenderWidgetHostViewBase(widget)
     , m_taskRunner(base::SingleThreadTaskRunner::GetCurrentDefault())
     , m_gestureProvider(QtGestureProviderConfig(), this)
     , m_frameSinkId(host()->GetFrameSinkId())
     , m_delegateClient(new RenderWidgetHostViewQtDelegateClient(this))
+    , m_externalBeginFrames(externalBeginFrames)
 {
     if (GetTextInputManager())
         GetTextInputManager()->AddObserver(this);
@@ -172,7 +178,8 @@ RenderWidgetHostViewQt::RenderWidgetHostViewQt(content::RenderWidgetHost *widget
                                  contextFactory->AllocateFrameSinkId(),
                                  contextFactory,
                                  m_taskRunner,
-                                 false /* enable_pixel_canvas */));
+                                 false /* enable_pixel_canvas */,
+                                 externalBeginFrames));
     m_uiCompositor->SetAcceleratedWidget(gfx::kNullAcceleratedWidget); // null means offscreen
     m_uiCompositor->SetRootLayer(m_rootLayer.get());
 
@@ -188,6 +195,10 @@ RenderWidgetHostViewQt::RenderWidgetHostViewQt(content::RenderWidgetHost *widget
     host()->render_frame_metadata_provider()->ReportAllFrameSubmissionsForTesting(true);
 
     m_smoothScrollController = std::make_unique<SmoothScrollController>(this);
+    m_inputResampler = std::make_unique<InputResampler>(this);
+
+    // Child frames are observed through registerInputEventObserver().
+    host()->AddInputEventObserver(this);
 
     host()->SetView(this);
 }
@@ -195,6 +206,7 @@ RenderWidgetHostViewQt::RenderWidgetHostViewQt(content::RenderWidgetHost *widget
 RenderWidgetHostViewQt::~RenderWidgetHostViewQt()
 {
     m_smoothScrollController.reset();
+    m_inputResampler.reset();
 
     m_delegate.reset();
 
@@ -209,6 +221,7 @@ RenderWidgetHostViewQt::~RenderWidgetHostViewQt()
     m_touchSelectionController.reset();
     m_touchSelectionControllerClient.reset();
 
+    host()->RemoveInputEventObserver(this);
     host()->render_frame_metadata_provider()->RemoveObserver(this);
     host()->ViewDestroyed();
 }
@@ -225,21 +238,32 @@ void RenderWidgetHostViewQt::setDelegate(RenderWidgetHostViewQtDelegate* delegat
 
 void RenderWidgetHostViewQt::setAdapterClient(WebContentsAdapterClient *adapterClient)
 {
-    Q_ASSERT(!m_adapterClient);
+    Q_ASSERT(!m_adapterClient || !adapterClient);
 
     m_adapterClient = adapterClient;
     QObject::disconnect(m_adapterClientDestroyedConnection);
+    if (!adapterClient)
+        return;
     m_adapterClientDestroyedConnection = QObject::connect(adapterClient->holdingQObject(),
                                                           &QObject::destroyed, [this] {
                                                             m_adapterClient = nullptr; });
 }
 
-void RenderWidgetHostViewQt::OnInputEventAck(const content::RenderWidgetHost &,
+void RenderWidgetHostViewQt::OnInputEvent(const content::RenderWidgetHost &,
+                                          const blink::WebInputEvent &event,
+                                          input::InputEventSource)
+{
+    m_inputLatencyTracker.eventDispatched(event, base::TimeTicks::Now());
+}
+
+void RenderWidgetHostViewQt::OnInputEventAck(const content::RenderWidgetHost &widget,
                                              blink::mojom::InputEventResultSource,
                                              blink::mojom::InputEventResultState state,
                                              const blink::WebInputEvent &event)
 {
-    if (event.GetType() == blink::WebInputEvent::Type::kMouseWheel)
+    m_inputLatencyTracker.eventAcked(event, base::TimeTicks::Now());
+    // Wheel events of our own widget are acknowledged through WheelEventAck() directly.
+    if (event.GetType() == blink::WebInputEvent::Type::kMouseWheel && &widget != host())
         WheelEventAck(static_cast<const blink::WebMouseWheelEvent &>(event), state);
 }
 
@@ -367,14 +391,16 @@ void RenderWidgetHostViewQt::ShowWithVisibility(content::PageVisibilityState pag
 
 void RenderWidgetHostViewQt::Hide()
 {
-    Q_ASSERT(m_delegate);
-    m_delegate->hide();
+    // Pooled web contents have no delegate until they are taken over by another page.
+    if (m_delegate)
+        m_delegate->hide();
+    else
+        m_deferredShow = false;
 }
 
 bool RenderWidgetHostViewQt::IsShowing()
 {
-    Q_ASSERT(m_delegate);
-    return m_delegate->isVisible();
+    return m_delegate && m_delegate->isVisible();
 }
 
 // Retrieve the bounds of the View, in screen coordinates.
@@ -809,6 +835,19 @@ Compositor::Id RenderWidgetHostViewQt::compositorId()
     return m_uiCompositor->frame_sink_id();
 }
 
+// Drives the compositor when it was created without its own begin-frame source. Every call
+// lets the page and the display produce at most one frame.
+void RenderWidgetHostViewQt::issueExternalBeginFrame(base::TimeDelta interval)
+{
+    Q_ASSERT(m_externalBeginFrames);
+    const base::TimeTicks now = base::TimeTicks::Now();
+    viz::BeginFrameArgs args = viz::BeginFrameArgs::Create(
+            BEGINFRAME_FROM_HERE, viz::BeginFrameArgs::kManualSourceId,
+            m_externalBeginFrameSequence++, now, now + interval, interval,
+            viz::BeginFrameArgs::NORMAL);
+    m_uiCompositor->IssueExternalBeginFrame(args, /*force=*/true, base::DoNothing());
+}
+
 void RenderWidgetHostViewQt::notifyShown()
 {
     // Handle possible frame eviction:
@@ -844,6 +883,12 @@ void RenderWidgetHostViewQt::ProcessAckedTouchEvent(const input::TouchEventWithL
 }
 
 void RenderWidgetHostViewQt::processMotionEvent(const ui::MotionEvent &motionEvent)
+{
+    if (!m_inputResampler->queueMotionEvent(motionEvent))
+        dispatchMotionEvent(motionEvent);
+}
+
+void RenderWidgetHostViewQt::dispatchMotionEvent(const ui::MotionEvent &motionEvent)
 {
     auto result = m_gestureProvider.OnTouchEvent(motionEvent);
     if (!result.succeeded)
@@ -882,9 +927,18 @@ bool RenderWidgetHostViewQt::updateScreenInfo()
 
 void RenderWidgetHostViewQt::handleWheelEvent(QWheelEvent *event)
 {
+    if (m_inputResampler->isEnabled()) {
+        blink::WebMouseWheelEvent webEvent = WebEventFactory::toWebWheelEvent(event);
+        m_inputLatencyTracker.eventConverted(event, webEvent.TimeStamp());
+        m_inputResampler->queueWheelEvent(webEvent);
+        return;
+    }
+    m_inputResampler->flush();
+
     if (!m_wheelAckPending) {
         Q_ASSERT(m_pendingWheelEvents.isEmpty());
         blink::WebMouseWheelEvent webEvent = WebEventFactory::toWebWheelEvent(event);
+        m_inputLatencyTracker.eventConverted(event, webEvent.TimeStamp());
         m_wheelAckPending = (webEvent.phase != blink::WebMouseWheelEvent::kPhaseEnded);
         GetMouseWheelPhaseHandler()->AddPhaseIfNeededAndScheduleEndEvent(webEvent, true);
         if (host()->delegate() && host()->delegate()->GetInputEventRouter())
@@ -893,10 +947,36 @@ void RenderWidgetHostViewQt::handleWheelEvent(QWheelEvent *event)
     }
     if (!m_pendingWheelEvents.isEmpty()) {
         // Try to combine with this wheel event with the last pending one.
-        if (WebEventFactory::coalesceWebWheelEvent(m_pendingWheelEvents.last(), event))
+        if (WebEventFactory::coalesceWebWheelEvent(m_pendingWheelEvents.last(), event)) {
+            m_inputLatencyTracker.eventConverted(event, m_pendingWheelEvents.last().TimeStamp());
             return;
+        }
     }
     m_pendingWheelEvents.append(WebEventFactory::toWebWheelEvent(event));
+    m_inputLatencyTracker.eventConverted(event, m_pendingWheelEvents.last().TimeStamp());
+}
+
+void RenderWidgetHostViewQt::dispatchWheelEvent(blink::WebMouseWheelEvent &webEvent)
+{
+    if (!m_wheelAckPending) {
+        Q_ASSERT(m_pendingWheelEvents.isEmpty());
+        m_wheelAckPending = (webEvent.phase != blink::WebMouseWheelEvent::kPhaseEnded);
+        GetMouseWheelPhaseHandler()->AddPhaseIfNeededAndScheduleEndEvent(webEvent, true);
+        if (host()->delegate() && host()->delegate()->GetInputEventRouter())
+            host()->delegate()->GetInputEventRouter()->RouteMouseWheelEvent(this, &webEvent, ui::LatencyInfo());
+        return;
+    }
+    if (!m_pendingWheelEvents.isEmpty() && m_pendingWheelEvents.last().CanCoalesce(webEvent)) {
+        m_pendingWheelEvents.last().Coalesce(webEvent);
+        return;
+    }
+    m_pendingWheelEvents.append(webEvent);
+}
+
+void RenderWidgetHostViewQt::dispatchMouseEvent(blink::WebMouseEvent &webEvent)
+{
+    if (host()->delegate() && host()->delegate()->GetInputEventRouter())
+        host()->delegate()->GetInputEventRouter()->RouteMouseEvent(this, &webEvent, ui::LatencyInfo());
 }
 
 void RenderWidgetHostViewQt::WheelEventAck(const blink::WebMouseWheelEvent &event, blink::mojom::InputEventResultState /*ack_result*/)
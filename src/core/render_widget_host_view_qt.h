@@ -6,8 +6,11 @@
 
 #include "compositor/compositor.h"
 #include "delegated_frame_host_client_qt.h"
+#include "input_latency_tracker.h"
+#include "input_resampler.h"
 #include "render_widget_host_view_qt_delegate.h"
 
+#include "components/viz/common/frame_sinks/begin_frame_args.h"
 #include "components/viz/common/resources/transferable_resource.h"
 #include "components/viz/common/surfaces/parent_local_surface_id_allocator.h"
 #include "components/viz/host/host_frame_sink_client.h"
@@ -44,7 +47,7 @@ class RenderWidgetHostViewQt
     , public content::RenderWidgetHost::InputEventObserver
 {
 public:
-    RenderWidgetHostViewQt(content::RenderWidgetHost* widget);
+    RenderWidgetHostViewQt(content::RenderWidgetHost* widget, bool externalBeginFrames = false);
     ~RenderWidgetHostViewQt();
 
     RenderWidgetHostViewQtDelegate *delegate() { return m_delegate.get(); }
@@ -154,6 +157,8 @@ public:
     void OnLocalSurfaceIdChanged(const cc::RenderFrameMetadata &) override {}
 
     // Overridden from content::RenderWidgetHost::InputEventObserver
+    void OnInputEvent(const content::RenderWidgetHost &, const blink::WebInputEvent &event,
+                      input::InputEventSource) override;
     void OnInputEventAck(const content::RenderWidgetHost &,
                          blink::mojom::InputEventResultSource,
                          blink::mojom::InputEventResultState state,
@@ -168,7 +173,13 @@ public:
     bool updateScreenInfo();
     void handleWheelEvent(QWheelEvent *);
     void processMotionEvent(const ui::MotionEvent &motionEvent);
+    // Deliver input immediately, bypassing the InputResampler.
+    void dispatchMouseEvent(blink::WebMouseEvent &event);
+    void dispatchWheelEvent(blink::WebMouseWheelEvent &event);
+    void dispatchMotionEvent(const ui::MotionEvent &motionEvent);
     void resetInputManagerState() { m_imState = 0; }
+    bool hasExternalBeginFrames() const { return m_externalBeginFrames; }
+    void issueExternalBeginFrame(base::TimeDelta interval);
 
     // Called from WebContentsAdapter.
     gfx::SizeF lastContentsSize() const { return m_lastContentsSize; }
@@ -185,6 +196,9 @@ public:
     void resetTouchSelectionController();
 
     void smoothScrollBy(int dx, int dy, double factor, int posX = -1, int posY = -1);
+    SmoothScrollController *smoothScrollController() const { return m_smoothScrollController.get(); }
+    InputLatencyTracker *inputLatencyTracker() { return &m_inputLatencyTracker; }
+    InputResampler *inputResampler() { return m_inputResampler.get(); }
 
 private:
     friend class DelegatedFrameHostClientQt;
@@ -221,6 +235,8 @@ private:
     std::unique_ptr<ui::Compositor> m_uiCompositor;
     viz::ParentLocalSurfaceIdAllocator m_dfhLocalSurfaceIdAllocator;
     viz::ParentLocalSurfaceIdAllocator m_uiCompositorLocalSurfaceIdAllocator;
+    const bool m_externalBeginFrames;
+    uint64_t m_externalBeginFrameSequence = viz::BeginFrameArgs::kStartingFrameNumber;
 
     // IME
     uint m_imState = 0;
@@ -233,6 +249,9 @@ private:
     // Smooth scroll
     std::unique_ptr<SmoothScrollController> m_smoothScrollController;
 
+    InputLatencyTracker m_inputLatencyTracker;
+    std::unique_ptr<InputResampler> m_inputResampler;
+
     // TouchSelection
     std::unique_ptr<TouchSelectionControllerClientQt> m_touchSelectionControllerClient;
     std::unique_ptr<ui::TouchSelectionController> m_touchSelectionController;
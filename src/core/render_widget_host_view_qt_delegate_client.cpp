@@ -12,6 +12,7 @@
 
 #include "components/input/render_widget_host_input_event_router.h"
 #include "content/browser/renderer_host/render_view_host_impl.h"
+#include "ui/events/base_event_utils.h"
 #include "ui/touch_selection/touch_selection_controller.h"
 
 #include <QDebug>
@@ -65,7 +66,6 @@ QList<TouchPoint> RenderWidgetHostViewQtDelegateClient::mapTouchPointIds(const Q
     return output;
 }
 
-static uint32_t s_eventId = 0;
 class MotionEventQt : public ui::MotionEvent
 {
 public:
@@ -75,7 +75,7 @@ public:
         : touchPoints(touchPoints)
         , eventTime(eventTime)
         , action(action)
-        , eventId(++s_eventId)
+        , eventId(ui::GetNextTouchEventId())
         , flags(flagsFromModifiers(modifiers))
         , index(index)
     {
@@ -197,6 +197,16 @@ Compositor::Id RenderWidgetHostViewQtDelegateClient::compositorId()
     return m_rwhv->compositorId();
 }
 
+bool RenderWidgetHostViewQtDelegateClient::hasExternalBeginFrames() const
+{
+    return m_rwhv->hasExternalBeginFrames();
+}
+
+void RenderWidgetHostViewQtDelegateClient::issueBeginFrame(std::chrono::microseconds interval)
+{
+    m_rwhv->issueExternalBeginFrame(base::Microseconds(interval.count()));
+}
+
 void RenderWidgetHostViewQtDelegateClient::notifyShown()
 {
     m_rwhv->notifyShown();
@@ -207,6 +217,11 @@ void RenderWidgetHostViewQtDelegateClient::notifyHidden()
     m_rwhv->notifyHidden();
 }
 
+void RenderWidgetHostViewQtDelegateClient::frameSwapped()
+{
+    m_rwhv->inputLatencyTracker()->framePresented(base::TimeTicks::Now());
+}
+
 void RenderWidgetHostViewQtDelegateClient::visualPropertiesChanged()
 {
     RenderWidgetHostViewQtDelegate *delegate = m_rwhv->delegate();
@@ -234,6 +249,24 @@ bool RenderWidgetHostViewQtDelegateClient::forwardEvent(QEvent *event)
 {
     Q_ASSERT(m_rwhv->host()->GetView());
 
+    if (auto category = InputLatencyTracker::categoryForEvent(event))
+        m_rwhv->inputLatencyTracker()->eventReceived(*category, base::TimeTicks::Now());
+
+    // Input that is not resampled must not overtake the resampled events that are still
+    // pending. Those that are resampled are ordered by the resampler itself.
+    switch (event->type()) {
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+    case QEvent::TouchUpdate:
+    case QEvent::ShortcutOverride:
+        break;
+    default:
+        if (event->isInputEvent() || event->type() == QEvent::InputMethod
+            || event->type() == QEvent::FocusIn || event->type() == QEvent::FocusOut)
+            m_rwhv->inputResampler()->flush();
+        break;
+    }
+
     switch (event->type()) {
     case QEvent::ShortcutOverride: {
         QKeyEvent *keyEvent = static_cast<QKeyEvent *>(event);
@@ -409,6 +442,7 @@ void RenderWidgetHostViewQtDelegateClient::handlePointerEvent(T *event)
     // Currently WebMouseEvent is a subclass of WebPointerProperties, so basically
     // tablet events are mouse events with extra properties.
     blink::WebMouseEvent webEvent = WebEventFactory::toWebMouseEvent(event);
+    m_rwhv->inputLatencyTracker()->eventConverted(event, webEvent.TimeStamp());
     if ((webEvent.GetType() == blink::WebInputEvent::Type::kMouseDown
          || webEvent.GetType() == blink::WebInputEvent::Type::kMouseUp)
         && webEvent.button == blink::WebMouseEvent::Button::kNoButton) {
@@ -458,8 +492,8 @@ void RenderWidgetHostViewQtDelegateClient::handlePointerEvent(T *event)
 #endif
     }
 
-    if (m_rwhv->host()->delegate() && m_rwhv->host()->delegate()->GetInputEventRouter())
-        m_rwhv->host()->delegate()->GetInputEventRouter()->RouteMouseEvent(m_rwhv, &webEvent, ui::LatencyInfo());
+    if (!m_rwhv->inputResampler()->queueMouseEvent(webEvent))
+        m_rwhv->dispatchMouseEvent(webEvent);
 }
 
 void RenderWidgetHostViewQtDelegateClient::handleMouseEvent(QMouseEvent *event)
@@ -509,6 +543,7 @@ void RenderWidgetHostViewQtDelegateClient::handleKeyEvent(QKeyEvent *event)
         return;
 
     input::NativeWebKeyboardEvent webEvent = WebEventFactory::toWebKeyboardEvent(event);
+    m_rwhv->inputLatencyTracker()->eventConverted(event, webEvent.TimeStamp());
     if (webEvent.GetType() == blink::WebInputEvent::Type::kRawKeyDown && !m_editCommand.empty()) {
         ui::LatencyInfo latency;
         std::vector<blink::mojom::EditCommandPtr> commands;
@@ -554,6 +589,7 @@ void RenderWidgetHostViewQtDelegateClient::handleTouchEvent(QTouchEvent *event)
     if (m_eventsToNowDelta == 0)
         m_eventsToNowDelta = (base::TimeTicks::Now() - eventTimestamp).InMicroseconds();
     eventTimestamp += base::Microseconds(m_eventsToNowDelta);
+    m_rwhv->inputLatencyTracker()->eventConverted(event, eventTimestamp);
 
     auto touchPoints = mapTouchPointIds(event->points());
     // Make sure that POINTER_DOWN action is delivered before MOVE, and MOVE before POINTER_UP
@@ -733,6 +769,7 @@ void RenderWidgetHostViewQtDelegateClient::handleHoverEvent(QHoverEvent *event)
     auto *hostDelegate = m_rwhv->host()->delegate();
     if (hostDelegate && hostDelegate->GetInputEventRouter()) {
         auto webEvent = WebEventFactory::toWebMouseEvent(event);
+        m_rwhv->inputLatencyTracker()->eventConverted(event, webEvent.TimeStamp());
         hostDelegate->GetInputEventRouter()->RouteMouseEvent(m_rwhv, &webEvent, ui::LatencyInfo());
     }
 }
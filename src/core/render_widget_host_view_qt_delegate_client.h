@@ -21,6 +21,8 @@
 #include <QtGui/QCursor>
 #include <QtGui/QTouchEvent>
 
+#include <chrono>
+
 QT_BEGIN_NAMESPACE
 class QEvent;
 class QVariant;
@@ -56,8 +58,12 @@ public:
     void notifyHidden();
     void visualPropertiesChanged();
     bool forwardEvent(QEvent *);
+    // Called after swapping a new frame of the compositor, possibly on the render thread.
+    void frameSwapped();
     QVariant inputMethodQuery(Qt::InputMethodQuery query);
     void closePopup();
+    bool hasExternalBeginFrames() const;
+    void issueBeginFrame(std::chrono::microseconds interval);
 
 private:
     friend class RenderWidgetHostViewQt;
@@ -0,0 +1,136 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "render_widget_host_view_qt_delegate_headless.h"
+
+#include "render_widget_host_view_qt_delegate_client.h"
+
+namespace QtWebEngineCore {
+
+// Used for the begin frames of pages that only render on request.
+static constexpr std::chrono::microseconds kDefaultFrameInterval(16667);
+
+RenderWidgetHostViewQtDelegateHeadless::RenderWidgetHostViewQtDelegateHeadless(
+        RenderWidgetHostViewQtDelegateClient *client)
+    : m_client(client)
+{
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this,
+            &RenderWidgetHostViewQtDelegateHeadless::requestFrame);
+    bind(client->compositorId()); // Compositor::Observer
+}
+
+RenderWidgetHostViewQtDelegateHeadless::~RenderWidgetHostViewQtDelegateHeadless()
+{
+    unbind(); // Compositor::Observer
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::setViewSize(const QSize &size)
+{
+    if (m_size == size)
+        return;
+    m_size = size;
+    m_client->visualPropertiesChanged();
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::setFrameRate(qreal frameRate)
+{
+    m_frameRate = frameRate;
+    if (frameRate > 0)
+        m_frameTimer.start(std::chrono::microseconds(qRound64(1000000 / frameRate)));
+    else
+        m_frameTimer.stop();
+}
+
+// With external begin frames the page only produces a frame when asked to. Otherwise the
+// compositor is held back by not acknowledging its last frame until the next one is due.
+void RenderWidgetHostViewQtDelegateHeadless::requestFrame()
+{
+    if (m_client->hasExternalBeginFrames()) {
+        if (m_visible) {
+            m_client->issueBeginFrame(m_frameRate > 0
+                    ? std::chrono::microseconds(qRound64(1000000 / m_frameRate))
+                    : kDefaultFrameInterval);
+        }
+        return;
+    }
+
+    if (m_swapPending)
+        swapFrame();
+    else
+        m_frameDue = true;
+}
+
+QRectF RenderWidgetHostViewQtDelegateHeadless::viewGeometry() const
+{
+    return QRectF(QPointF(), m_size);
+}
+
+QRect RenderWidgetHostViewQtDelegateHeadless::windowGeometry() const
+{
+    return QRect(QPoint(), m_size);
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::show()
+{
+    m_visible = true;
+    m_client->notifyShown();
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::hide()
+{
+    m_visible = false;
+    m_client->notifyHidden();
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::resize(int width, int height)
+{
+    setViewSize(QSize(width, height));
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::readyToSwap()
+{
+    // Called on the viz thread.
+    QMetaObject::invokeMethod(this, &RenderWidgetHostViewQtDelegateHeadless::onReadyToSwap,
+                              Qt::QueuedConnection);
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::onReadyToSwap()
+{
+    if (m_client->hasExternalBeginFrames() || m_frameDue)
+        swapFrame();
+    else
+        m_swapPending = true;
+}
+
+void RenderWidgetHostViewQtDelegateHeadless::swapFrame()
+{
+    m_swapPending = false;
+    m_frameDue = false;
+
+    QImage image;
+    QRect damageRect;
+    {
+        // Don't hold on to the compositor while calling out, the callback may delete the page.
+        auto comp = compositor();
+        if (!comp)
+            return;
+        comp->swapFrame();
+        m_client->frameSwapped();
+        if (comp->type() != Compositor::Type::Software) {
+            if (!m_warnedAboutNativeCompositor) {
+                qWarning("Headless rendering requires software compositing, no frames will be "
+                         "delivered.");
+                m_warnedAboutNativeCompositor = true;
+            }
+            return;
+        }
+        image = comp->image();
+        damageRect = comp->damageRect();
+    }
+
+    if (m_frameCallback && !image.isNull())
+        m_frameCallback(image, damageRect);
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,96 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef RENDER_WIDGET_HOST_VIEW_QT_DELEGATE_HEADLESS_H
+#define RENDER_WIDGET_HOST_VIEW_QT_DELEGATE_HEADLESS_H
+
+#include "compositor/compositor.h"
+#include "render_widget_host_view_qt_delegate.h"
+
+#include <QtCore/qobject.h>
+#include <QtCore/qtimer.h>
+#include <QtGui/qimage.h>
+
+#include <functional>
+
+namespace QtWebEngineCore {
+
+class RenderWidgetHostViewQtDelegateClient;
+
+// Delegate for pages that are rendered without any window. Frames are taken straight from the
+// software compositor and handed to a callback, at the pace set by the frame rate or by
+// explicit frame requests.
+class Q_WEBENGINECORE_EXPORT RenderWidgetHostViewQtDelegateHeadless
+        : public QObject
+        , public RenderWidgetHostViewQtDelegate
+        , public Compositor::Observer
+{
+    Q_OBJECT
+public:
+    typedef std::function<void(const QImage &, const QRect &)> FrameCallback;
+
+    RenderWidgetHostViewQtDelegateHeadless(RenderWidgetHostViewQtDelegateClient *client);
+    ~RenderWidgetHostViewQtDelegateHeadless() override;
+
+    void setFrameCallback(const FrameCallback &callback) { m_frameCallback = callback; }
+    void setViewSize(const QSize &size);
+    // Zero means that frames are only produced by requestFrame().
+    void setFrameRate(qreal frameRate);
+    void requestFrame();
+
+    // Overridden from RenderWidgetHostViewQtDelegate
+    void initAsPopup(const QRect &) override { }
+    QRectF viewGeometry() const override;
+    QRect windowGeometry() const override;
+    void setKeyboardFocus() override { m_hasFocus = true; }
+    bool hasKeyboardFocus() override { return m_hasFocus; }
+    void lockMouse() override { }
+    void unlockMouse() override { }
+    void show() override;
+    void hide() override;
+    bool isVisible() const override { return m_visible; }
+    QWindow *Window() const override { return nullptr; }
+    void updateCursor(const QCursor &) override { }
+    void resize(int width, int height) override;
+    void move(const QPoint &) override { }
+    void inputMethodStateChanged(bool, bool) override { }
+    void setInputMethodHints(Qt::InputMethodHints) override { }
+    void setClearColor(const QColor &) override { }
+    void adapterClientChanged(WebContentsAdapterClient *) override { }
+    void updateAdapterClientIfNeeded(WebContentsAdapterClient *) override { }
+
+    // Overridden from Compositor::Observer
+    void readyToSwap() override;
+
+private:
+    void onReadyToSwap();
+    void swapFrame();
+
+    RenderWidgetHostViewQtDelegateClient *m_client;
+    FrameCallback m_frameCallback;
+    QTimer m_frameTimer;
+    QSize m_size;
+    qreal m_frameRate = 0;
+    bool m_visible = false;
+    bool m_hasFocus = false;
+    // A frame is waiting for its turn to be delivered.
+    bool m_swapPending = false;
+    // The next frame may be delivered as soon as it is ready.
+    bool m_frameDue = true;
+    bool m_warnedAboutNativeCompositor = false;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // RENDER_WIDGET_HOST_VIEW_QT_DELEGATE_HEADLESS_H
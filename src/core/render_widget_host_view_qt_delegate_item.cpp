@@ -431,6 +431,7 @@ QSGNode *RenderWidgetHostViewQtDelegateItem::updatePaintNode(QSGNode *oldNode, U
     if (comp->type() == Compositor::Type::Native
         && QGuiApplication::platformName() == "offscreen"_L1) {
         comp->swapFrame();
+        m_client->frameSwapped();
         return oldNode;
     }
 
@@ -450,6 +451,7 @@ QSGNode *RenderWidgetHostViewQtDelegateItem::updatePaintNode(QSGNode *oldNode, U
     }
 
     comp->swapFrame();
+    m_client->frameSwapped();
 
     QSize texSize = comp->size();
     QSizeF texSizeInDips = QSizeF(texSize) / comp->devicePixelRatio();
@@ -9,6 +9,7 @@
 
 #include "extensions_renderer_client_qt.h"
 
+#include "isolated_world_ids_qt.h"
 #include "renderer/render_configuration.h"
 #include "resource_request_policy_qt.h"
 
@@ -59,7 +60,7 @@ bool ExtensionsRendererClientQt::IsIncognitoProcess() const
 // (third_party/WebKit/public/web/WebFrame.h) for additional context.
 int ExtensionsRendererClientQt::GetLowestIsolatedWorldId() const
 {
-    return 257;
+    return QtWebEngineCore::kLowestExtensionWorldId;
 }
 
 // static
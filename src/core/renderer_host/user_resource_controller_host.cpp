@@ -162,7 +162,11 @@ void UserResourceControllerHost::clearAllScripts(WebContentsAdapter *adapter)
             (*controller)->ClearScripts();
     } else {
         content::WebContents *contents = adapter->webContents();
-        m_perContentsScripts.remove(contents);
+        // Keep the entry: the WebContentsObserverHelper observing contents stays around until
+        // contents is destroyed, which may be long after this page when it gets recycled.
+        ContentsScriptsMap::iterator it = m_perContentsScripts.find(contents);
+        if (it != m_perContentsScripts.end())
+            it->clear();
         mojo::AssociatedRemote<qtwebengine::mojom::UserResourceControllerRenderFrame>
                 userResourceController;
         GetUserResourceControllerRenderFrame(contents->GetPrimaryMainFrame())
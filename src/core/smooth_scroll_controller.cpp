@@ -4,36 +4,34 @@
 #include "smooth_scroll_controller.h"
 #include "render_widget_host_view_qt.h"
 
+#include "components/viz/common/frame_sinks/begin_frame_args.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "third_party/blink/public/common/input/web_gesture_event.h"
+#include "ui/compositor/compositor.h"
 
-#include <QGuiApplication>
-#include <QScreen>
+#include <QLoggingCategory>
 #include <cmath>
 
 namespace QtWebEngineCore {
 
+Q_WEBENGINE_LOGGING_CATEGORY(lcSmoothScroll, "qt.webengine.smoothscroll")
+
+static constexpr base::TimeDelta kDefaultFrameInterval = base::Microseconds(16667);
+static constexpr std::chrono::milliseconds kFallbackInterval(50);
+
 SmoothScrollController::SmoothScrollController(RenderWidgetHostViewQt *rwhv, QObject *parent)
     : QObject(parent)
     , m_rwhv(rwhv)
 {
-    m_timer.setTimerType(Qt::PreciseTimer);
-    int interval = 16;
-    if (QScreen *screen = QGuiApplication::primaryScreen()) {
-        qreal hz = screen->refreshRate();
-        if (hz > 0)
-            interval = qMax(1, static_cast<int>(std::round(1000.0 / hz)));
-    }
-    m_timer.setInterval(interval);
-    connect(&m_timer, &QTimer::timeout, this, &SmoothScrollController::tick);
+    m_fallbackTimer.setTimerType(Qt::PreciseTimer);
+    m_fallbackTimer.setInterval(kFallbackInterval);
+    connect(&m_fallbackTimer, &QTimer::timeout, this, &SmoothScrollController::onFallbackTimeout);
 }
 
 SmoothScrollController::~SmoothScrollController()
 {
-    if (m_scrolling) {
-        m_timer.stop();
-        m_scrolling = false;
-    }
+    if (m_observedCompositor)
+        m_observedCompositor->RemoveAnimationObserver(this);
 }
 
 void SmoothScrollController::scrollBy(int dx, int dy, double factor, int posX, int posY)
@@ -49,27 +47,58 @@ void SmoothScrollController::scrollBy(int dx, int dy, double factor, int posX, i
         m_subPixelY = 0.0;
         sendGestureScrollBegin(static_cast<float>(-dx), static_cast<float>(-dy));
         m_scrolling = true;
-        m_elapsed.start();
-        m_timer.start();
+        m_metrics = Metrics();
+        m_lastFrameTime = base::TimeTicks();
+        if (ui::Compositor *compositor = m_rwhv->GetCompositor()) {
+            compositor->AddAnimationObserver(this);
+            m_observedCompositor = compositor;
+        }
+        m_fallbackTimer.start();
     }
 }
 
 void SmoothScrollController::stop()
 {
-    if (m_scrolling) {
-        m_timer.stop();
-        sendGestureScrollEnd();
-        m_scrolling = false;
-        m_dx = 0.0;
-        m_dy = 0.0;
-        m_subPixelX = 0.0;
-        m_subPixelY = 0.0;
-    }
+    if (m_scrolling)
+        finish();
 }
 
-void SmoothScrollController::tick()
+void SmoothScrollController::onBeginFrame(const viz::BeginFrameArgs &args)
 {
-    double dt = qMax(1.0, static_cast<double>(m_elapsed.restart()));
+    // Like flings, don't progress on missed frames, the next regular frame catches up.
+    if (!m_scrolling || args.type == viz::BeginFrameArgs::MISSED)
+        return;
+    m_fallbackTimer.start();
+    // Size the step for the time the frame is due, so that the scroll position matches the
+    // time the frame is presented rather than the time the step was computed.
+    const base::TimeDelta interval = args.interval.is_positive() ? args.interval : kDefaultFrameInterval;
+    advance(args.deadline.is_null() ? args.frame_time + interval : args.deadline, interval);
+}
+
+void SmoothScrollController::OnCompositingShuttingDown(ui::Compositor *compositor)
+{
+    compositor->RemoveAnimationObserver(this);
+    m_observedCompositor = nullptr;
+}
+
+void SmoothScrollController::onFallbackTimeout()
+{
+    advance(base::TimeTicks::Now(), kDefaultFrameInterval);
+}
+
+void SmoothScrollController::advance(base::TimeTicks frameTime, base::TimeDelta interval)
+{
+    // The first frame of a scroll moves it by one frame interval.
+    const base::TimeDelta elapsed = m_lastFrameTime.is_null() ? interval : frameTime - m_lastFrameTime;
+    if (!elapsed.is_positive())
+        return;
+    m_lastFrameTime = frameTime;
+
+    ++m_metrics.frames;
+    if (elapsed.InMicrosecondsF() > 1.5 * interval.InMicrosecondsF())
+        ++m_metrics.multiStepFrames;
+
+    double dt = qMax(1.0, elapsed.InMillisecondsF());
     // Time-based decay: same visual speed regardless of refresh rate.
     // At the reference 16ms tick, effectiveFactor == m_factor exactly.
     double effectiveFactor = 1.0 - std::pow(1.0 - m_factor, dt / 16.0);
@@ -96,17 +125,29 @@ void SmoothScrollController::tick()
 
     if (stepX != 0 || stepY != 0)
         sendGestureScrollUpdate(stepX, stepY);
+    else
+        ++m_metrics.zeroDeltaFrames;
 
     // Stop when remaining delta is negligible
-    if (std::abs(m_dx) < 0.01 && std::abs(m_dy) < 0.01) {
-        m_timer.stop();
-        sendGestureScrollEnd();
-        m_scrolling = false;
-        m_dx = 0.0;
-        m_dy = 0.0;
-        m_subPixelX = 0.0;
-        m_subPixelY = 0.0;
+    if (std::abs(m_dx) < 0.01 && std::abs(m_dy) < 0.01)
+        finish();
+}
+
+void SmoothScrollController::finish()
+{
+    m_fallbackTimer.stop();
+    if (m_observedCompositor) {
+        m_observedCompositor->RemoveAnimationObserver(this);
+        m_observedCompositor = nullptr;
     }
+    sendGestureScrollEnd();
+    m_scrolling = false;
+    m_dx = 0.0;
+    m_dy = 0.0;
+    m_subPixelX = 0.0;
+    m_subPixelY = 0.0;
+    qCDebug(lcSmoothScroll, "Scroll finished after %d frames, %d without movement, %d skipping frames",
+            m_metrics.frames, m_metrics.zeroDeltaFrames, m_metrics.multiStepFrames);
 }
 
 gfx::PointF SmoothScrollController::hitTestPosition()
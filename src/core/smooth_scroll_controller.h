@@ -4,38 +4,73 @@
 #ifndef SMOOTH_SCROLL_CONTROLLER_H
 #define SMOOTH_SCROLL_CONTROLLER_H
 
-#include <QElapsedTimer>
 #include <QObject>
 #include <QTimer>
 
+#include "base/time/time.h"
+#include "ui/compositor/compositor_animation_observer.h"
 #include "ui/gfx/geometry/point_f.h"
 
+namespace viz {
+struct BeginFrameArgs;
+}
+
 namespace QtWebEngineCore {
 
 class RenderWidgetHostViewQt;
 
-class SmoothScrollController : public QObject
+// Animates scrolls in steps of one per BeginFrame of the view's compositor. While a scroll
+// runs, the controller is registered as animation observer so that the compositor keeps
+// producing BeginFrames, which RenderWidgetHostViewQt forwards to onBeginFrame().
+class SmoothScrollController : public QObject, public ui::CompositorAnimationObserver
 {
     Q_OBJECT
 public:
+    // Jank metrics of a single scroll, from its first to its last frame.
+    struct Metrics
+    {
+        int frames = 0;
+        // Frames during which the scroll didn't move.
+        int zeroDeltaFrames = 0;
+        // Frames carrying the scrolling of more than one frame interval, because frames
+        // were skipped.
+        int multiStepFrames = 0;
+    };
+
     explicit SmoothScrollController(RenderWidgetHostViewQt *rwhv, QObject *parent = nullptr);
     ~SmoothScrollController();
 
     void scrollBy(int dx, int dy, double factor, int posX = -1, int posY = -1);
     void stop();
+    bool isScrolling() const { return m_scrolling; }
+
+    void onBeginFrame(const viz::BeginFrameArgs &args);
+
+    // The metrics of the running scroll, or of the last one if none is running.
+    const Metrics &metrics() const { return m_metrics; }
+
+    // Overridden from ui::CompositorAnimationObserver
+    void OnAnimationStep(base::TimeTicks) override { }
+    void OnCompositingShuttingDown(ui::Compositor *compositor) override;
 
 private Q_SLOTS:
-    void tick();
+    void onFallbackTimeout();
 
 private:
+    void advance(base::TimeTicks frameTime, base::TimeDelta interval);
+    void finish();
     gfx::PointF hitTestPosition();
     void sendGestureScrollBegin(float deltaXHint, float deltaYHint);
     void sendGestureScrollUpdate(int stepX, int stepY);
     void sendGestureScrollEnd();
 
     RenderWidgetHostViewQt *m_rwhv;
-    QTimer m_timer;
-    QElapsedTimer m_elapsed;
+    ui::Compositor *m_observedCompositor = nullptr;
+    // Keeps the scroll going when the compositor stops producing BeginFrames, for instance
+    // while the view is hidden.
+    QTimer m_fallbackTimer;
+    base::TimeTicks m_lastFrameTime;
+    Metrics m_metrics;
     double m_dx = 0.0;
     double m_dy = 0.0;
     double m_subPixelX = 0.0;
@@ -30,8 +30,16 @@
 
 #include <QTextStream>
 #include <QLibraryInfo>
+#include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 #include <QCoreApplication>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -139,6 +147,111 @@ QString frameworkIcuDataPath()
 }
 #endif
 
+// Returns true if the .bdic file is newer than all of the files it is generated from.
+static bool isUpToDate(const base::FilePath &dic_path, const base::FilePath &file_out_path)
+{
+    const QFileInfo outInfo(toQt(file_out_path.value()));
+    if (!outInfo.exists())
+        return false;
+
+    const QDateTime converted = outInfo.lastModified();
+    for (const base::FilePath &input :
+         { dic_path.ReplaceExtension(FILE_PATH_LITERAL(".aff")), dic_path,
+           dic_path.ReplaceExtension(FILE_PATH_LITERAL(".dic_delta")) }) {
+        const QFileInfo inInfo(toQt(input.value()));
+        if (inInfo.exists() && inInfo.lastModified() > converted)
+            return false;
+    }
+    return true;
+}
+
+// AffReader and DicReader come from Chromium's single-threaded convert_dict tool, which makes no
+// promise about the state they share (ICU code page converters, for one), so only one dictionary
+// is read at a time. Serializing, verifying and writing only touch per-dictionary data.
+Q_CONSTINIT static QMutex readerMutex;
+
+static bool convertDictionary(const base::FilePath &file_in_path,
+                              const base::FilePath &file_out_path, bool incremental,
+                              QTextStream &out)
+{
+    base::FilePath aff_path = file_in_path.ReplaceExtension(FILE_PATH_LITERAL(".aff"));
+    base::FilePath dic_path = file_in_path.ReplaceExtension(FILE_PATH_LITERAL(".dic"));
+
+    if (incremental && isUpToDate(dic_path, file_out_path)) {
+        out << toQt(file_out_path.value()) << " is up to date.\n";
+        return true;
+    }
+
+    QMutexLocker locker(&readerMutex);
+    out << "Reading " << toQt(aff_path.value()) << "\n";
+    convert_dict::AffReader aff_reader(aff_path);
+
+    if (!aff_reader.Read()) {
+        out << "Unable to read the aff file.\n";
+        return false;
+    }
+
+    out << "Reading " << toQt(dic_path.value()) << "\n";
+
+    // DicReader will also read the .dic_delta file.
+    convert_dict::DicReader dic_reader(dic_path);
+    if (!dic_reader.Read(&aff_reader)) {
+        out << "Unable to read the dic file.\n";
+        return false;
+    }
+    locker.unlock();
+
+    hunspell::BDictWriter writer;
+    writer.SetComment(aff_reader.comments());
+    writer.SetAffixRules(aff_reader.affix_rules());
+    writer.SetAffixGroups(aff_reader.GetAffixGroups());
+    writer.SetReplacements(aff_reader.replacements());
+    writer.SetOtherCommands(aff_reader.other_commands());
+    writer.SetWords(dic_reader.words());
+
+    out << "Serializing...\n";
+
+    std::string serialized = writer.GetBDict();
+
+    out << "Verifying...\n";
+
+    if (!VerifyWords(dic_reader.words(), serialized, out)) {
+        out << "ERROR converting, the dictionary does not check out OK.\n";
+        return false;
+    }
+
+    out << "Writing " << toQt(file_out_path.value()) << "\n";
+    // Renderers map the .bdic file while it is in use, so replace it in one step instead of
+    // rewriting it in place.
+    QSaveFile out_file(toQt(file_out_path.value()));
+    if (!out_file.open(QIODevice::WriteOnly)
+        || out_file.write(serialized.data(), serialized.size()) != qint64(serialized.size())
+        || !out_file.commit()) {
+        out << "ERROR writing file\n";
+        return false;
+    }
+    out << "Success. Dictionary converted.\n";
+    return true;
+}
+
+static void printUsage(QTextStream &out)
+{
+    out << "Usage: qwebengine_convert_dict [--incremental] <dic file> <bdic file>\n"
+           "       qwebengine_convert_dict [--jobs <count>] [--incremental] <dic file>... "
+           "<output directory>\n\nExample:\n"
+           "qwebengine_convert_dict ./en-US.dic ./en-US.bdic\nwill read en-US.dic, "
+           "en-US.dic_delta, and en-US.aff from the current directory and generate "
+           "en-US.bdic\n\n"
+           "qwebengine_convert_dict --incremental ./en-US.dic ./de-DE.dic ./out\nwill "
+           "convert both dictionaries in parallel to ./out/en-US.bdic and ./out/de-DE.bdic, "
+           "skipping the ones that are newer than their .dic, .dic_delta and .aff files\n\n"
+           "Options:\n"
+           "  --jobs <count>  Number of dictionaries converted at the same time. Defaults to "
+           "the number of processor cores.\n"
+           "  --incremental   Only convert dictionaries that changed since their last "
+           "conversion.\n\n";
+}
+
 int main(int argc, char *argv[])
 {
     // Required only for making QLibraryInfo::location() return a valid path, when the application
@@ -148,12 +261,32 @@ int main(int argc, char *argv[])
 
     QTextStream out(stdout);
 
-    if (argc != 3) {
-        QTextStream out(stdout);
-        out << "Usage: qwebengine_convert_dict <dic file> <bdic file>\n\nExample:\n"
-               "qwebengine_convert_dict ./en-US.dic ./en-US.bdic\nwill read en-US.dic, "
-               "en-US.dic_delta, and en-US.aff from the current directory and generate "
-               "en-US.bdic\n\n";
+    QStringList files;
+    int jobs = QThread::idealThreadCount();
+    bool incremental = false;
+    const QStringList arguments = QCoreApplication::arguments();
+    for (qsizetype i = 1; i < arguments.size(); ++i) {
+        const QString &argument = arguments.at(i);
+        if (argument == "--incremental"_L1) {
+            incremental = true;
+        } else if (argument == "--jobs"_L1 || argument == "-j"_L1) {
+            bool ok = false;
+            jobs = i + 1 < arguments.size() ? arguments.at(++i).toInt(&ok) : 0;
+            if (!ok || jobs < 1) {
+                printUsage(out);
+                return 1;
+            }
+        } else {
+            files.append(argument);
+        }
+    }
+
+    // Anything but the original '<dic file> <bdic file>' form converts into a directory.
+    const bool batch =
+            files.size() > 2 || (files.size() == 2 && QFileInfo(files.last()).isDir());
+
+    if (files.size() < 2) {
+        printUsage(out);
         return 1;
     }
 #if defined(USE_ICU_FILE)
@@ -200,57 +333,55 @@ int main(int argc, char *argv[])
 
     base::i18n::InitializeICU();
 
-    base::FilePath file_in_path = toFilePath(argv[1]);
-    base::FilePath file_out_path = toFilePath(argv[2]);
-    base::FilePath aff_path = file_in_path.ReplaceExtension(FILE_PATH_LITERAL(".aff"));
-
-    out << "Reading " << toQt(aff_path.value()) << "\n";
-    convert_dict::AffReader aff_reader(aff_path);
-
-    if (!aff_reader.Read()) {
-        out << "Unable to read the aff file.\n";
-        return 1;
+    if (!batch) {
+        if (!convertDictionary(toFilePath(files.at(0)), toFilePath(files.at(1)), incremental,
+                               out))
+            return 1;
+        return 0;
     }
 
-    base::FilePath dic_path = file_in_path.ReplaceExtension(FILE_PATH_LITERAL(".dic"));
-    out << "Reading " << toQt(dic_path.value()) << "\n";
-
-    // DicReader will also read the .dic_delta file.
-    convert_dict::DicReader dic_reader(dic_path);
-    if (!dic_reader.Read(&aff_reader)) {
-        out << "Unable to read the dic file.\n";
+    const QDir outputDir(files.takeLast());
+    if (!outputDir.exists() && !QDir().mkpath(outputDir.path())) {
+        out << "Unable to create the output directory " << outputDir.path() << "\n";
         return 1;
     }
 
-    hunspell::BDictWriter writer;
-    writer.SetComment(aff_reader.comments());
-    writer.SetAffixRules(aff_reader.affix_rules());
-    writer.SetAffixGroups(aff_reader.GetAffixGroups());
-    writer.SetReplacements(aff_reader.replacements());
-    writer.SetOtherCommands(aff_reader.other_commands());
-    writer.SetWords(dic_reader.words());
-
-    out << "Serializing...\n";
-
-    std::string serialized = writer.GetBDict();
-
-    out << "Verifying...\n";
+    struct Job
+    {
+        base::FilePath in;
+        base::FilePath out;
+        QString log;
+        bool ok = false;
+    };
+    std::vector<Job> conversions(files.size());
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        const QString bdic = QFileInfo(files.at(i)).completeBaseName() + ".bdic"_L1;
+        conversions[i].in = toFilePath(files.at(i));
+        conversions[i].out = toFilePath(outputDir.filePath(bdic));
+    }
 
-    if (!VerifyWords(dic_reader.words(), serialized, out)) {
-        out << "ERROR converting, the dictionary does not check out OK.\n";
-        return 1;
+    // Every dictionary is converted on its own thread, see readerMutex for the part that is not
+    // run in parallel. The output of each is collected and printed in order afterwards.
+    QThreadPool pool;
+    pool.setMaxThreadCount(jobs);
+    for (Job &job : conversions) {
+        pool.start([&job, incremental]() {
+            QTextStream log(&job.log);
+            job.ok = convertDictionary(job.in, job.out, incremental, log);
+        });
     }
+    pool.waitForDone();
 
-    out << "Writing " << toQt(file_out_path.value()) << "\n";
-    FILE *out_file = base::OpenFile(file_out_path, "wb");
-    if (!out_file) {
-        out << "ERROR writing file\n";
+    int failed = 0;
+    for (const Job &job : conversions) {
+        out << job.log;
+        if (!job.ok)
+            ++failed;
+    }
+    if (failed) {
+        out << "ERROR: " << failed << " of " << conversions.size()
+            << " dictionaries could not be converted.\n";
         return 1;
     }
-    size_t written = fwrite(&serialized[0], 1, serialized.size(), out_file);
-    Q_ASSERT(written == serialized.size());
-    base::CloseFile(out_file);
-    out << "Success. Dictionary converted.\n";
     return 0;
 }
-
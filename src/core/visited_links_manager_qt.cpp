@@ -9,6 +9,9 @@
 #include "type_conversion.h"
 
 #include <base/files/file_util.h>
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "components/visitedlink/browser/visitedlink_delegate.h"
 #include "components/visitedlink/browser/visitedlink_writer.h"
 
@@ -25,6 +28,10 @@ private:
     GURL m_currentUrl;
 
 };
+
+// Every slice of an import resizes and writes the whole table, they are kept large enough
+// for that to stay rare, and small enough to not block the UI thread for long.
+constexpr size_t kImportSliceSize = 100000;
 } // Anonymous namespace
 
 // Due to the design of the visitedLink component, it seems safer to provide a
@@ -56,6 +63,52 @@ bool VisitedLinksManagerQt::containsUrl(const QUrl &url) const
     return m_visitedLinkWriter->IsVisited(toGurl(url));
 }
 
+QList<bool> VisitedLinksManagerQt::containsUrls(const QList<QUrl> &urls) const
+{
+    QList<bool> result;
+    result.reserve(urls.size());
+    for (const QUrl &url : urls)
+        result.append(m_visitedLinkWriter->IsVisited(toGurl(url)));
+    return result;
+}
+
+void VisitedLinksManagerQt::importUrls(const QList<QUrl> &urls, std::function<void()> callback)
+{
+    base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, { base::TaskPriority::USER_VISIBLE },
+            base::BindOnce([](const QList<QUrl> &urls) {
+                std::vector<GURL> result;
+                result.reserve(urls.size());
+                for (const QUrl &url : urls) {
+                    GURL gurl = toGurl(url);
+                    if (gurl.is_valid())
+                        result.push_back(std::move(gurl));
+                }
+                return result;
+            }, urls),
+            base::BindOnce(&VisitedLinksManagerQt::addImportedUrls, m_weakPtrFactory.GetWeakPtr(),
+                           size_t(0), std::move(callback)));
+}
+
+void VisitedLinksManagerQt::addImportedUrls(size_t offset, std::function<void()> callback,
+                                            std::vector<GURL> urls)
+{
+    const size_t end = std::min(urls.size(), offset + kImportSliceSize);
+    if (offset < end)
+        m_visitedLinkWriter->AddURLs(std::vector<GURL>(urls.begin() + offset, urls.begin() + end));
+    if (end < urls.size()) {
+        // Let the UI thread handle other work between the slices.
+        base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+                FROM_HERE,
+                base::BindOnce(&VisitedLinksManagerQt::addImportedUrls,
+                               m_weakPtrFactory.GetWeakPtr(), end, std::move(callback),
+                               std::move(urls)));
+        return;
+    }
+    if (callback)
+        callback();
+}
+
 VisitedLinksManagerQt::VisitedLinksManagerQt(ProfileQt *profile, bool persistVisitedLinks)
     : m_delegate(new VisitedLinkDelegateQt)
 {
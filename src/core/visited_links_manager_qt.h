@@ -16,9 +16,13 @@
 #define VISITED_LINKS_MANAGER_QT_H
 
 #include "qtwebenginecoreglobal_p.h"
+#include "base/memory/weak_ptr.h"
 #include <QList>
 #include <QScopedPointer>
 
+#include <functional>
+#include <vector>
+
 QT_FORWARD_DECLARE_CLASS(QUrl)
 
 namespace visitedlink {
@@ -42,13 +46,20 @@ public:
     void deleteVisitedLinkDataForUrls(const QList<QUrl> &);
 
     bool containsUrl(const QUrl &) const;
+    QList<bool> containsUrls(const QList<QUrl> &) const;
+
+    // Adds urls to the table. They are converted in the background and added in slices,
+    // callback is called once all are.
+    void importUrls(const QList<QUrl> &urls, std::function<void()> callback);
 
 private:
     void addUrl(const GURL &);
+    void addImportedUrls(size_t offset, std::function<void()> callback, std::vector<GURL> urls);
     friend class WebContentsDelegateQt;
 
     QScopedPointer<visitedlink::VisitedLinkWriter> m_visitedLinkWriter;
     QScopedPointer<VisitedLinkDelegateQt> m_delegate;
+    base::WeakPtrFactory<VisitedLinksManagerQt> m_weakPtrFactory{ this };
 };
 
 } // namespace QtWebEngineCore
@@ -14,16 +14,20 @@
 #include "favicon_driver_qt.h"
 #include "favicon_service_factory_qt.h"
 #include "find_text_helper.h"
+#include "isolated_world_ids_qt.h"
 #include "media_capture_devices_dispatcher.h"
 #include "pdf_util_qt.h"
 #include "permission_manager_qt.h"
 #include "profile_adapter.h"
 #include "profile_qt.h"
 #include "qwebengineloadinginfo.h"
+#include "renderer_host/user_resource_controller_host.h"
 #include "renderer_host/web_engine_page_host.h"
 #include "render_widget_host_view_qt.h"
+#include "smooth_scroll_controller.h"
 #include "type_conversion.h"
 #include "web_contents_delegate_qt.h"
+#include "web_contents_pool.h"
 #include "web_contents_view_qt.h"
 #include "web_engine_context.h"
 #include "web_engine_settings.h"
@@ -54,12 +58,14 @@
 #include "content/public/common/drop_data.h"
 #include "content/public/common/url_constants.h"
 #include "extensions/buildflags/buildflags.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "third_party/blink/public/common/page/page_zoom.h"
 #include "third_party/blink/public/common/page_state/page_state.h"
 #include "third_party/blink/public/common/peerconnection/webrtc_ip_handling_policy.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/mojom/frame/media_player_action.mojom.h"
 #include "third_party/blink/public/mojom/frame/user_activation_notification_type.mojom.h"
+#include "third_party/blink/public/platform/web_isolated_world_ids.h"
 #include "ui/base/clipboard/clipboard_constants.h"
 #include "ui/base/clipboard/custom_data_helper.h"
 #include "ui/gfx/font_render_params.h"
@@ -70,6 +76,7 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QVariant>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMimeData>
 #include <QtCore/QTemporaryDir>
 #include <QtGui/QDrag>
@@ -112,7 +119,8 @@ namespace QtWebEngineCore {
         return; \
     }
 
-static const int kHistoryStreamVersion = 4;
+static const int kHistoryStreamVersion = 5;
+static const int kLegacyHistoryStreamVersion = 4;
 
 static QVariant fromJSValue(const base::Value *result)
 {
@@ -186,6 +194,65 @@ static void callbackOnEvaluateJS(WebContentsAdapter *adapter, quint64 requestId,
     adapter->didRunJavaScript(requestId, result);
 }
 
+// Collects the results of one script run in several frames, see runJavaScriptInFrames().
+// Frames the script is not run in, or that do not answer before the batch finishes, are
+// reported with an invalid result.
+class FrameScriptBatch
+{
+public:
+    FrameScriptBatch(const QList<quint64> &frameIds, const QList<quint64> &liveFrameIds,
+                     const WebContentsAdapter::FrameScriptCallback &callback)
+        : m_callback(callback), m_remaining(liveFrameIds.size())
+    {
+        m_results.reserve(frameIds.size());
+        for (quint64 frameId : frameIds) {
+            if (liveFrameIds.contains(frameId))
+                m_indexes.insert(frameId, m_results.size());
+            m_results.append({ frameId, QVariant() });
+        }
+    }
+
+    // Returns true once every frame has answered.
+    bool addResult(quint64 frameId, const base::Value &result)
+    {
+        auto it = m_indexes.constFind(frameId);
+        if (it == m_indexes.cend())
+            return false;
+        m_results[*it].second = fromJSValue(&result);
+        m_indexes.erase(it);
+        return --m_remaining == 0;
+    }
+
+    void finish()
+    {
+        if (!m_callback)
+            return;
+        auto callback = std::move(m_callback);
+        m_callback = nullptr;
+        callback(m_results);
+    }
+
+private:
+    WebContentsAdapter::FrameScriptCallback m_callback;
+    QList<std::pair<quint64, QVariant>> m_results;
+    QHash<quint64, qsizetype> m_indexes;
+    qsizetype m_remaining;
+};
+
+static void callbackOnEvaluateJSInFrame(QWeakPointer<WebContentsAdapter> weakAdapter,
+                                        quint64 batchId, quint64 frameId, base::Value result)
+{
+    if (auto adapter = weakAdapter.lock())
+        adapter->didRunJavaScriptInFrame(batchId, frameId, result);
+}
+
+static void callbackOnFrameScriptBatchDone(QWeakPointer<WebContentsAdapter> weakAdapter,
+                                           quint64 batchId)
+{
+    if (auto adapter = weakAdapter.lock())
+        adapter->finishFrameScriptBatch(batchId);
+}
+
 #if QT_CONFIG(webengine_printing_and_pdf)
 static void callbackOnPrintingFinished(WebContentsAdapter *adapter, quint64 requestId,
                                        QSharedPointer<QByteArray> result)
@@ -199,6 +266,13 @@ static void callbackOnPdfSavingFinished(WebContentsAdapterClient *adapterClient,
 {
     adapterClient->didPrintPageToPdf(filePath, success);
 }
+
+static void callbackOnPdfSavingProgress(WebContentsAdapterClient *adapterClient,
+                                        const QString &filePath,
+                                        qint64 bytesWritten, qint64 bytesTotal)
+{
+    adapterClient->didPrintPageToPdfProgress(filePath, bytesWritten, bytesTotal);
+}
 #endif
 
 static std::unique_ptr<content::WebContents> createBlankWebContents(WebContentsAdapterClient *adapterClient, content::BrowserContext *browserContext)
@@ -231,48 +305,268 @@ static int navigationListCurrentIndex(content::NavigationController &controller)
     return controller.GetCurrentEntryIndex();
 }
 
-static void serializeNavigationHistory(content::NavigationController &controller, QDataStream &output)
+// The fields of a navigation entry stored in a history stream.
+struct WebContentsAdapter::NavigationEntryRecord
+{
+    QByteArray virtualUrl;
+    QByteArray title;
+    QByteArray pageState;
+    qint32 transitionType = 0;
+    bool hasPostData = false;
+    QByteArray referrerUrl;
+    qint32 referrerPolicy = 0;
+    QByteArray originalRequestUrl;
+    bool isOverridingUserAgent = false;
+    qint64 timestamp = 0;
+    qint32 httpStatusCode = 0;
+    QByteArray iconUrl;
+};
+
+// Compact form of a navigation history. Only the current URL and title are kept in the clear,
+// the entries stay compressed until the history is restored into a WebContents.
+struct WebContentsAdapter::NavigationHistorySnapshot
+{
+    int count = 0;
+    int currentIndex = -1;
+    QUrl currentUrl;
+    QString currentTitle;
+    QByteArray entries;
+    // Filled on demand to answer queries about the entries before they are restored.
+    std::optional<QList<NavigationEntryRecord>> decodedEntries;
+};
+
+static QByteArray toSpec(const GURL &url)
+{
+    return url.is_valid() ? QByteArray::fromStdString(url.spec()) : QByteArray();
+}
+
+// Collects the entries of the navigation list. Entries without a valid virtual URL cannot be
+// restored and are skipped, with *currentIndex adjusted to the remaining entries.
+static QList<WebContentsAdapter::NavigationEntryRecord>
+collectNavigationEntries(content::NavigationController &controller, int *currentIndex)
 {
-    const int currentIndex = navigationListCurrentIndex(controller);
     const int count = navigationListSize(controller);
+    const int current = navigationListCurrentIndex(controller);
     const int pendingIndex = controller.GetPendingEntryIndex();
 
-    output << kHistoryStreamVersion;
-    output << count;
-    output << currentIndex;
-
+    QList<WebContentsAdapter::NavigationEntryRecord> records;
+    records.reserve(count);
+    *currentIndex = -1;
     // Logic taken from SerializedNavigationEntry::WriteToPickle.
     for (int i = 0; i < count; ++i) {
         content::NavigationEntry* entry = (i == pendingIndex)
             ? controller.GetPendingEntry()
             : controller.GetEntryAtIndex(i);
-        if (entry->GetVirtualURL().is_valid()) {
-            if (entry->GetHasPostData())
-                entry->GetPageState().RemovePasswordData();
-            std::string encodedPageState = entry->GetPageState().ToEncodedData();
-            output << toQt(entry->GetVirtualURL());
-            output << toQt(entry->GetTitle());
-            output << QByteArray(encodedPageState.data(), encodedPageState.size());
-            output << static_cast<qint32>(entry->GetTransitionType());
-            output << entry->GetHasPostData();
-            output << toQt(entry->GetReferrer().url);
-            output << static_cast<qint32>(entry->GetReferrer().policy);
-            output << toQt(entry->GetOriginalRequestURL());
-            output << entry->GetIsOverridingUserAgent();
-            output << static_cast<qint64>(entry->GetTimestamp().ToInternalValue());
-            output << entry->GetHttpStatusCode();
-            // kHistoryStreamVersion >= 4
+        if (!entry->GetVirtualURL().is_valid())
+            continue;
+        if (entry->GetHasPostData())
+            entry->GetPageState().RemovePasswordData();
+        const content::FaviconStatus &favicon = entry->GetFavicon();
+        WebContentsAdapter::NavigationEntryRecord record;
+        record.virtualUrl = toSpec(entry->GetVirtualURL());
+        record.title = toQt(entry->GetTitle()).toUtf8();
+        record.pageState = QByteArray::fromStdString(entry->GetPageState().ToEncodedData());
+        record.transitionType = static_cast<qint32>(entry->GetTransitionType());
+        record.hasPostData = entry->GetHasPostData();
+        record.referrerUrl = toSpec(entry->GetReferrer().url);
+        record.referrerPolicy = static_cast<qint32>(entry->GetReferrer().policy);
+        record.originalRequestUrl = toSpec(entry->GetOriginalRequestURL());
+        record.isOverridingUserAgent = entry->GetIsOverridingUserAgent();
+        record.timestamp = static_cast<qint64>(entry->GetTimestamp().ToInternalValue());
+        record.httpStatusCode = static_cast<qint32>(entry->GetHttpStatusCode());
+        record.iconUrl = favicon.valid ? toSpec(favicon.url) : QByteArray();
+        records.append(std::move(record));
+        // A skipped current entry is replaced by the entry before it.
+        if (i <= current)
+            *currentIndex = records.size() - 1;
+    }
+    if (*currentIndex == -1 && !records.isEmpty())
+        *currentIndex = 0;
+    return records;
+}
+
+static void writeNavigationEntryRecord(QDataStream &output,
+                                       const WebContentsAdapter::NavigationEntryRecord &record)
+{
+    output << record.virtualUrl << record.title << record.pageState << record.transitionType;
+    output << record.hasPostData << record.referrerUrl << record.referrerPolicy;
+    output << record.originalRequestUrl << record.isOverridingUserAgent << record.timestamp;
+    output << record.httpStatusCode << record.iconUrl;
+}
+
+static bool readNavigationEntryRecord(QDataStream &input,
+                                      WebContentsAdapter::NavigationEntryRecord *record)
+{
+    input >> record->virtualUrl >> record->title >> record->pageState >> record->transitionType;
+    input >> record->hasPostData >> record->referrerUrl >> record->referrerPolicy;
+    input >> record->originalRequestUrl >> record->isOverridingUserAgent >> record->timestamp;
+    input >> record->httpStatusCode >> record->iconUrl;
+    return input.status() == QDataStream::Ok;
+}
+
+static WebContentsAdapter::NavigationHistorySnapshot
+snapshotNavigationHistory(const QList<WebContentsAdapter::NavigationEntryRecord> &records,
+                          int currentIndex)
+{
+    WebContentsAdapter::NavigationHistorySnapshot snapshot;
+    snapshot.count = records.size();
+    snapshot.currentIndex = currentIndex;
+    if (currentIndex >= 0) {
+        snapshot.currentUrl = QUrl(QString::fromUtf8(records.at(currentIndex).virtualUrl));
+        snapshot.currentTitle = QString::fromUtf8(records.at(currentIndex).title);
+    }
+
+    QByteArray entries;
+    QDataStream output(&entries, QIODevice::WriteOnly);
+    for (const WebContentsAdapter::NavigationEntryRecord &record : records)
+        writeNavigationEntryRecord(output, record);
+    snapshot.entries = qCompress(entries);
+    return snapshot;
+}
+
+// Decodes the compressed entries of a snapshot. Returns false if they are corrupt.
+static bool decodeNavigationEntries(const WebContentsAdapter::NavigationHistorySnapshot &snapshot,
+                                    QList<WebContentsAdapter::NavigationEntryRecord> *records)
+{
+    const QByteArray data = qUncompress(snapshot.entries);
+    if (data.isEmpty() && snapshot.count > 0)
+        return false;
+    QDataStream input(data);
+    records->resize(snapshot.count);
+    for (WebContentsAdapter::NavigationEntryRecord &record : *records) {
+        if (!readNavigationEntryRecord(input, &record)) {
+            records->clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+static const QList<WebContentsAdapter::NavigationEntryRecord> &
+decodedNavigationEntries(WebContentsAdapter::NavigationHistorySnapshot &snapshot)
+{
+    if (!snapshot.decodedEntries) {
+        QList<WebContentsAdapter::NavigationEntryRecord> records;
+        decodeNavigationEntries(snapshot, &records);
+        snapshot.decodedEntries = std::move(records);
+    }
+    return *snapshot.decodedEntries;
+}
+
+static void writeNavigationHistorySnapshot(QDataStream &output,
+                                           const WebContentsAdapter::NavigationHistorySnapshot &snapshot)
+{
+    output << kHistoryStreamVersion;
+    output << snapshot.count;
+    output << snapshot.currentIndex;
+    output << snapshot.currentUrl;
+    output << snapshot.currentTitle;
+    output << snapshot.entries;
+}
+
+// Writes version 4 of the format, which Qt releases before 6.10 can read.
+static void writeLegacyNavigationHistory(QDataStream &output,
+                                         const QList<WebContentsAdapter::NavigationEntryRecord> &records,
+                                         int currentIndex)
+{
+    output << kLegacyHistoryStreamVersion;
+    output << int(records.size());
+    output << currentIndex;
+    for (const WebContentsAdapter::NavigationEntryRecord &record : records) {
+        output << QUrl(QString::fromUtf8(record.virtualUrl));
+        output << QString::fromUtf8(record.title);
+        output << record.pageState;
+        output << record.transitionType;
+        output << record.hasPostData;
+        output << QUrl(QString::fromUtf8(record.referrerUrl));
+        output << record.referrerPolicy;
+        output << QUrl(QString::fromUtf8(record.originalRequestUrl));
+        output << record.isOverridingUserAgent;
+        output << record.timestamp;
+        output << int(record.httpStatusCode);
+        // kHistoryStreamVersion >= 4
+        output << QUrl(QString::fromUtf8(record.iconUrl));
+    }
+}
+
+static bool readNavigationHistorySnapshot(QDataStream &input,
+                                          WebContentsAdapter::NavigationHistorySnapshot *snapshot)
+{
+    input >> snapshot->count >> snapshot->currentIndex;
+    input >> snapshot->currentUrl >> snapshot->currentTitle;
+    input >> snapshot->entries;
+    if (input.status() != QDataStream::Ok || snapshot->count < 0
+        || snapshot->currentIndex < -1 || snapshot->currentIndex >= snapshot->count) {
+        input.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+    // Only the entries are checked here, they are restored when the adapter is initialized.
+    QList<WebContentsAdapter::NavigationEntryRecord> records;
+    if (!decodeNavigationEntries(*snapshot, &records)) {
+        input.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+    return true;
+}
+
+static std::unique_ptr<content::NavigationEntry>
+createRestoredNavigationEntry(const GURL &virtualUrl, const GURL &referrerUrl, qint32 referrerPolicy,
+                              content::BrowserContext *browserContext)
+{
+    return content::NavigationController::CreateNavigationEntry(
+            virtualUrl,
+            content::Referrer(referrerUrl, static_cast<network::mojom::ReferrerPolicy>(referrerPolicy)),
+            std::nullopt, // optional initiator_origin
+            std::nullopt, // optional initiator_base_url
+            // Use a transition type of reload so that we don't incorrectly
+            // increase the typed count.
+            ui::PAGE_TRANSITION_RELOAD,
+            false,
+            // The extra headers are not sync'ed across sessions.
+            std::string(),
+            browserContext,
+            nullptr);
+}
+
+static bool restoreNavigationEntries(const WebContentsAdapter::NavigationHistorySnapshot &snapshot,
+                                     std::vector<std::unique_ptr<content::NavigationEntry>> *entries,
+                                     content::BrowserContext *browserContext)
+{
+    QList<WebContentsAdapter::NavigationEntryRecord> records;
+    if (snapshot.decodedEntries)
+        records = *snapshot.decodedEntries;
+    else if (!decodeNavigationEntries(snapshot, &records))
+        return false;
+
+    std::unique_ptr<content::NavigationEntryRestoreContext> context = content::NavigationEntryRestoreContext::Create();
+
+    entries->reserve(records.size());
+    for (const WebContentsAdapter::NavigationEntryRecord &record : std::as_const(records)) {
+        std::unique_ptr<content::NavigationEntry> entry = createRestoredNavigationEntry(
+                GURL(record.virtualUrl.toStdString()), GURL(record.referrerUrl.toStdString()),
+                record.referrerPolicy, browserContext);
+        entry->SetTitle(toString16(QString::fromUtf8(record.title)));
+        entry->SetPageState(blink::PageState::CreateFromEncodedData(record.pageState.toStdString()), context.get());
+        entry->SetHasPostData(record.hasPostData);
+        entry->SetOriginalRequestURL(GURL(record.originalRequestUrl.toStdString()));
+        entry->SetIsOverridingUserAgent(record.isOverridingUserAgent);
+        entry->SetTimestamp(base::Time::FromInternalValue(record.timestamp));
+        entry->SetHttpStatusCode(record.httpStatusCode);
+        if (!record.iconUrl.isEmpty()) {
+            // See deserializeNavigationHistory().
             content::FaviconStatus &favicon = entry->GetFavicon();
-            output << (favicon.valid ? toQt(favicon.url) : QUrl());
+            favicon.url = GURL(record.iconUrl.toStdString());
+            favicon.valid = true;
         }
+        entries->push_back(std::move(entry));
     }
+    return true;
 }
 
-static void deserializeNavigationHistory(QDataStream &input, int *currentIndex, std::vector<std::unique_ptr<content::NavigationEntry>> *entries, content::BrowserContext *browserContext)
+// Decodes history streams written before kHistoryStreamVersion 5.
+static void deserializeNavigationHistory(QDataStream &input, int version, int *currentIndex, std::vector<std::unique_ptr<content::NavigationEntry>> *entries, content::BrowserContext *browserContext)
 {
-    int version;
-    input >> version;
-    if (version < 3 || version > kHistoryStreamVersion) {
+    if (version < 3 || version > 4) {
         // We do not try to decode history stream versions before 3.
         // Make sure that our history is cleared and mark the rest of the stream as invalid.
         input.setStatus(QDataStream::ReadCorruptData);
@@ -321,19 +615,8 @@ static void deserializeNavigationHistory(QDataStream &input, int *currentIndex,
             return;
         }
 
-        std::unique_ptr<content::NavigationEntry> entry = content::NavigationController::CreateNavigationEntry(
-            toGurl(virtualUrl),
-            content::Referrer(toGurl(referrerUrl), static_cast<network::mojom::ReferrerPolicy>(referrerPolicy)),
-            std::nullopt, // optional initiator_origin
-            std::nullopt, // optional initiator_base_url
-            // Use a transition type of reload so that we don't incorrectly
-            // increase the typed count.
-            ui::PAGE_TRANSITION_RELOAD,
-            false,
-            // The extra headers are not sync'ed across sessions.
-            std::string(),
-            browserContext,
-            nullptr);
+        std::unique_ptr<content::NavigationEntry> entry = createRestoredNavigationEntry(
+                toGurl(virtualUrl), toGurl(referrerUrl), referrerPolicy, browserContext);
 
         entry->SetTitle(toString16(title));
         entry->SetPageState(blink::PageState::CreateFromEncodedData(std::string(pageState.data(), pageState.size())), context.get());
@@ -399,9 +682,22 @@ class LoadRecursionGuard {
 
 QSharedPointer<WebContentsAdapter> WebContentsAdapter::createFromSerializedNavigationHistory(QDataStream &input, WebContentsAdapterClient *adapterClient)
 {
+    int version;
+    input >> version;
+    if (version == kHistoryStreamVersion) {
+        auto snapshot = std::make_unique<NavigationHistorySnapshot>();
+        if (!readNavigationHistorySnapshot(input, snapshot.get()) || snapshot->currentIndex == -1)
+            return QSharedPointer<WebContentsAdapter>();
+
+        // The entries are only restored once the adapter gets initialized, see initialize().
+        auto adapter = QSharedPointer<WebContentsAdapter>::create();
+        adapter->m_pendingHistory = std::move(snapshot);
+        return adapter;
+    }
+
     int currentIndex;
     std::vector<std::unique_ptr<content::NavigationEntry>> entries;
-    deserializeNavigationHistory(input, &currentIndex, &entries, adapterClient->profileAdapter()->profile());
+    deserializeNavigationHistory(input, version, &currentIndex, &entries, adapterClient->profileAdapter()->profile());
 
     if (currentIndex == -1)
         return QSharedPointer<WebContentsAdapter>();
@@ -440,6 +736,58 @@ WebContentsAdapter::~WebContentsAdapter()
     if (m_devToolsFrontend)
         closeDevToolsFrontend();
     Q_ASSERT(!m_devToolsFrontend);
+
+    if (isInitialized() && m_profileAdapter->webContentsPool())
+        recycleWebContents();
+}
+
+bool WebContentsAdapter::canRecycleWebContents() const
+{
+    // Only plain top-level pages are recycled. A WebContents that other pages, DevTools or an
+    // outer page may still refer to, or that is in a state that cannot be reset, is destroyed.
+    return !m_webContents->IsCrashed() && !m_webContents->WasDiscarded()
+            && m_webContents->GetPrimaryMainFrame()->IsRenderFrameLive()
+            && !m_webContents->HasOpener() && !m_webContents->GetOuterWebContents()
+            && m_webContents->GetInnerWebContents().empty()
+            && !m_webContents->IsFullscreen()
+            && !content::DevToolsAgentHost::HasFor(m_webContents.get())
+            && !hasExternalBeginFrames();
+}
+
+// Views that wait for external begin frames would never draw again in another page.
+bool WebContentsAdapter::hasExternalBeginFrames() const
+{
+    auto *rwhv = static_cast<RenderWidgetHostViewQt *>(m_webContents->GetRenderWidgetHostView());
+    return rwhv && rwhv->hasExternalBeginFrames();
+}
+
+void WebContentsAdapter::recycleWebContents()
+{
+    WebContentsPool *pool = m_profileAdapter->webContentsPool();
+    if (pool->isFull() || !canRecycleWebContents()) {
+        pool->recordDiscarded();
+        return;
+    }
+
+    // Detach everything that belongs to this page, like discard() does for its old WebContents.
+    m_profileAdapter->userResourceController()->clearAllScripts(this);
+#if QT_CONFIG(webengine_webchannel)
+    if (m_webChannel)
+        m_webChannel->disconnectFrom(m_webChannelTransport.get());
+    m_webChannelTransport.reset();
+    m_webChannel = nullptr;
+    m_webChannelWorld = 0;
+#endif
+    // Keeps a pointer to the page's client, it is created again for the next one.
+    m_webContents->RemoveUserData(FaviconDriverQt::UserDataKey());
+    m_pageHost.reset();
+    m_webContentsDelegate.reset();
+    // Hiding goes through the view's delegate, so it has to happen before that is detached.
+    m_webContents->WasHidden();
+    WebContentsViewQt::from(static_cast<content::WebContentsImpl *>(m_webContents.get())->GetView())
+            ->resetClient();
+
+    pool->recycle(std::move(m_webContents));
 }
 
 void WebContentsAdapter::setClient(WebContentsAdapterClient *adapterClient)
@@ -467,7 +815,33 @@ void WebContentsAdapter::initialize(content::SiteInstance *site)
     Q_ASSERT(m_adapterClient);
     Q_ASSERT(!isInitialized());
 
-    // Create our own if a WebContents wasn't provided at construction.
+    // The services of the profile and its extensions are only set up once it has loaded.
+    if (!m_profileAdapter->isReady()) {
+        deferInitialization(site);
+        return;
+    }
+    m_profileAdapter->initializeExtensions();
+
+    // Restore a navigation history that was deserialized lazily.
+    if (!m_webContents && m_pendingHistory) {
+        const std::unique_ptr<NavigationHistorySnapshot> snapshot = std::move(m_pendingHistory);
+        std::vector<std::unique_ptr<content::NavigationEntry>> entries;
+        if (restoreNavigationEntries(*snapshot, &entries, m_profileAdapter->profile())) {
+            m_webContents = createBlankWebContents(m_adapterClient, m_profileAdapter->profile());
+            m_webContents->GetController().Restore(snapshot->currentIndex,
+                                                   content::RestoreType::kRestored, &entries);
+        }
+    }
+
+    // Create our own if a WebContents wasn't provided at construction, or take over the one
+    // of a previous page of the profile. A specific SiteInstance needs a new WebContents.
+    WebContentsPool *pool = m_webContents || site ? nullptr : m_profileAdapter->webContentsPool();
+    const base::TimeTicks creationStart = base::TimeTicks::Now();
+    bool reused = false;
+    if (pool) {
+        m_webContents = pool->take();
+        reused = bool(m_webContents);
+    }
     if (!m_webContents) {
         content::WebContents::CreateParams create_params(m_profileAdapter->profile(), site);
         create_params.initially_hidden = true;
@@ -482,6 +856,8 @@ void WebContentsAdapter::initialize(content::SiteInstance *site)
 
     // Let the WebContent's view know about the WebContentsAdapterClient.
     WebContentsViewQt* contentsView = static_cast<WebContentsViewQt*>(static_cast<content::WebContentsImpl*>(m_webContents.get())->GetView());
+    if (reused)
+        contentsView->setFactoryClient(m_adapterClient);
     contentsView->setClient(m_adapterClient);
 
     // This should only be necessary after having restored the history to a new WebContentsAdapter.
@@ -515,6 +891,13 @@ void WebContentsAdapter::initialize(content::SiteInstance *site)
 
     m_webContentsDelegate->RenderViewHostChanged(nullptr, rvh);
 
+    // The RenderView of a recycled WebContents already exists, so the settings of this page
+    // have to be pushed explicitly.
+    if (reused)
+        m_webContents->OnWebPreferencesChanged();
+    if (pool)
+        pool->recordInitialization(reused, base::TimeTicks::Now() - creationStart);
+
     // Make sure the system theme's light/dark mode is propagated to webpages
     QObject::connect(QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged, [](Qt::ColorScheme colorScheme){
         ui::NativeTheme::GetInstanceForWeb()->set_preferred_color_scheme(toWeb(colorScheme));
@@ -524,6 +907,40 @@ void WebContentsAdapter::initialize(content::SiteInstance *site)
     m_adapterClient->initializationFinished();
 }
 
+void WebContentsAdapter::deferInitialization(content::SiteInstance *site)
+{
+    const bool waiting = bool(m_deferredInitialization);
+    // Later calls without a SiteInstance keep the one already asked for.
+    if (!waiting || site) {
+        m_deferredInitialization = [this, site = scoped_refptr<content::SiteInstance>(site)]() {
+            initialize(site.get());
+        };
+    }
+    if (waiting)
+        return;
+    m_profileAdapter->callWhenReady([weakThis = sharedFromThis().toWeakRef()]() {
+        if (QSharedPointer<WebContentsAdapter> adapter = weakThis.toStrongRef())
+            adapter->initializeDeferred();
+    });
+}
+
+void WebContentsAdapter::initializeDeferred()
+{
+    const std::function<void()> initialization = std::exchange(m_deferredInitialization, {});
+    const std::function<void()> load = std::exchange(m_deferredLoad, {});
+    if (!initialization)
+        return;
+    // A load initializes the page for the site of its URL itself.
+    if (load)
+        load();
+    else if (!isInitialized())
+        initialization();
+    if (!isInitialized())
+        return;
+    for (const std::function<void()> &call : std::exchange(m_deferredCalls, {}))
+        call();
+}
+
 void WebContentsAdapter::initializeRenderPrefs()
 {
     blink::RendererPreferences *rendererPrefs = m_webContents->GetMutableRendererPrefs();
@@ -576,6 +993,10 @@ bool WebContentsAdapter::canGoForward() const
 
 bool WebContentsAdapter::canGoToOffset(int offset) const
 {
+    if (m_pendingHistory) {
+        const int index = m_pendingHistory->currentIndex + offset;
+        return index >= 0 && index < m_pendingHistory->count;
+    }
     CHECK_INITIALIZED(false);
     return m_webContents->GetController().CanGoToOffset(offset);
 }
@@ -640,6 +1061,12 @@ void WebContentsAdapter::load(const QWebEngineHttpRequest &request)
 {
     base::RecordAction(base::UserMetricsAction("LoadURL"));
     GURL gurl = toGurl(request.url());
+    if (!isInitialized() && !m_profileAdapter->isReady()) {
+        // Made once the profile has loaded and the page is initialized.
+        m_deferredLoad = [this, request]() { load(request); };
+        deferInitialization(nullptr);
+        return;
+    }
     if (!isInitialized()) {
         scoped_refptr<content::SiteInstance> site =
             content::SiteInstance::CreateForURL(m_profileAdapter->profile(), gurl);
@@ -733,6 +1160,11 @@ void WebContentsAdapter::load(const QWebEngineHttpRequest &request)
 
 void WebContentsAdapter::setContent(const QByteArray &data, const QString &mimeType, const QUrl &baseUrl)
 {
+    if (!isInitialized() && !m_profileAdapter->isReady()) {
+        m_deferredLoad = [this, data, mimeType, baseUrl]() { setContent(data, mimeType, baseUrl); };
+        deferInitialization(nullptr);
+        return;
+    }
     if (!isInitialized())
         loadDefault();
     else
@@ -777,6 +1209,8 @@ void WebContentsAdapter::save(const QString &filePath, int savePageFormat)
 
 QUrl WebContentsAdapter::activeUrl() const
 {
+    if (m_pendingHistory)
+        return m_pendingHistory->currentUrl;
     CHECK_INITIALIZED(QUrl());
     return m_webContentsDelegate->url(webContents());
 }
@@ -813,6 +1247,8 @@ QIcon WebContentsAdapter::icon() const
 
 QString WebContentsAdapter::pageTitle() const
 {
+    if (m_pendingHistory)
+        return m_pendingHistory->currentTitle;
     CHECK_INITIALIZED(QString());
     return m_webContentsDelegate->title();
 }
@@ -926,18 +1362,24 @@ void WebContentsAdapter::navigateToOffset(int offset)
 
 int WebContentsAdapter::navigationEntryCount()
 {
+    if (m_pendingHistory)
+        return m_pendingHistory->count;
     CHECK_INITIALIZED(0);
     return navigationListSize(m_webContents->GetController());
 }
 
 int WebContentsAdapter::currentNavigationEntryIndex()
 {
+    if (m_pendingHistory)
+        return m_pendingHistory->currentIndex;
     CHECK_INITIALIZED(0);
     return navigationListCurrentIndex(m_webContents->GetController());
 }
 
 QUrl WebContentsAdapter::getNavigationEntryOriginalUrl(int index)
 {
+    if (const NavigationEntryRecord *record = pendingNavigationEntry(index))
+        return QUrl(QString::fromUtf8(record->originalRequestUrl));
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetOriginalRequestURL()) : QUrl();
@@ -945,6 +1387,8 @@ QUrl WebContentsAdapter::getNavigationEntryOriginalUrl(int index)
 
 QUrl WebContentsAdapter::getNavigationEntryUrl(int index)
 {
+    if (const NavigationEntryRecord *record = pendingNavigationEntry(index))
+        return QUrl(QString::fromUtf8(record->virtualUrl));
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetURL()) : QUrl();
@@ -952,6 +1396,8 @@ QUrl WebContentsAdapter::getNavigationEntryUrl(int index)
 
 QString WebContentsAdapter::getNavigationEntryTitle(int index)
 {
+    if (const NavigationEntryRecord *record = pendingNavigationEntry(index))
+        return QString::fromUtf8(record->title);
     CHECK_INITIALIZED(QString());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetTitle()) : QString();
@@ -959,6 +1405,8 @@ QString WebContentsAdapter::getNavigationEntryTitle(int index)
 
 QDateTime WebContentsAdapter::getNavigationEntryTimestamp(int index)
 {
+    if (const NavigationEntryRecord *record = pendingNavigationEntry(index))
+        return toQt(base::Time::FromInternalValue(record->timestamp));
     CHECK_INITIALIZED(QDateTime());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetTimestamp()) : QDateTime();
@@ -966,6 +1414,8 @@ QDateTime WebContentsAdapter::getNavigationEntryTimestamp(int index)
 
 QUrl WebContentsAdapter::getNavigationEntryIconUrl(int index)
 {
+    if (const NavigationEntryRecord *record = pendingNavigationEntry(index))
+        return QUrl(QString::fromUtf8(record->iconUrl));
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     if (!entry)
@@ -983,8 +1433,37 @@ void WebContentsAdapter::clearNavigationHistory()
 
 void WebContentsAdapter::serializeNavigationHistory(QDataStream &output)
 {
+    // Streams set to the version of an older Qt get the format that it can read.
+    const bool legacy = output.version() < QDataStream::Qt_6_10;
+    if (m_pendingHistory) {
+        if (legacy)
+            writeLegacyNavigationHistory(output, decodedNavigationEntries(*m_pendingHistory),
+                                         m_pendingHistory->currentIndex);
+        else
+            writeNavigationHistorySnapshot(output, *m_pendingHistory);
+        return;
+    }
     CHECK_INITIALIZED();
-    QtWebEngineCore::serializeNavigationHistory(m_webContents->GetController(), output);
+    int currentIndex;
+    const QList<NavigationEntryRecord> records =
+            collectNavigationEntries(m_webContents->GetController(), &currentIndex);
+    if (legacy)
+        writeLegacyNavigationHistory(output, records, currentIndex);
+    else
+        writeNavigationHistorySnapshot(output, snapshotNavigationHistory(records, currentIndex));
+}
+
+bool WebContentsAdapter::hasPendingNavigationHistory() const
+{
+    return bool(m_pendingHistory);
+}
+
+const WebContentsAdapter::NavigationEntryRecord *WebContentsAdapter::pendingNavigationEntry(int index)
+{
+    if (!m_pendingHistory)
+        return nullptr;
+    const QList<NavigationEntryRecord> &records = decodedNavigationEntries(*m_pendingHistory);
+    return index >= 0 && index < records.size() ? &records.at(index) : nullptr;
 }
 
 void WebContentsAdapter::setZoomFactor(qreal factor)
@@ -1097,6 +1576,93 @@ void WebContentsAdapter::runJavaScript(const QString &javaScript, quint32 worldI
                                               worldId);
 }
 
+// The worlds QtWebEngine reserves for itself must stay below the limit Blink sets for embedders.
+static_assert(kFindMatchRectsWorldId > kLastApplicationWorldId);
+static_assert(kLowestExtensionWorldId < blink::IsolatedWorldId::kEmbedderWorldIdLimit);
+
+// Sends the script to all frames at once, so slow frames only delay the aggregated result up
+// to the timeout instead of adding up.
+void WebContentsAdapter::runJavaScriptInFrames(const QString &javaScript, quint32 worldId,
+                                               const QList<quint64> &frameIds, int timeoutMs,
+                                               const FrameScriptCallback &callback)
+{
+    Q_ASSERT(callback);
+    QList<quint64> liveFrameIds;
+    QList<content::RenderFrameHost *> frames;
+    if (isInitialized()) {
+        for (quint64 frameId : frameIds) {
+            auto *rfh = renderFrameHostFromFrameId(frameId);
+            if (!rfh || !static_cast<content::RenderFrameHostImpl *>(rfh)->GetAssociatedLocalFrame())
+                continue;
+            liveFrameIds.append(frameId);
+            frames.append(rfh);
+        }
+    }
+
+    auto batch = std::make_shared<FrameScriptBatch>(frameIds, liveFrameIds, callback);
+    if (liveFrameIds.isEmpty()) {
+        batch->finish();
+        return;
+    }
+
+    const quint64 batchId = m_nextRequestId++;
+    m_frameScriptBatches.insert(batchId, batch);
+
+    const std::u16string script = toString16(javaScript);
+    const QWeakPointer<WebContentsAdapter> weakThis = sharedFromThis().toWeakRef();
+    for (qsizetype i = 0; i < frames.size(); ++i) {
+        // A frame that goes away before answering drops the callback, which then reports
+        // an empty result instead of holding up the batch.
+        auto resultCallback = mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                base::BindOnce(&callbackOnEvaluateJSInFrame, weakThis, batchId, liveFrameIds.at(i)),
+                base::Value());
+        if (worldId == 0)
+            frames.at(i)->ExecuteJavaScript(script, std::move(resultCallback));
+        else
+            frames.at(i)->ExecuteJavaScriptInIsolatedWorld(script, std::move(resultCallback),
+                                                           worldId);
+    }
+
+    if (timeoutMs > 0) {
+        content::GetUIThreadTaskRunner({})->PostDelayedTask(
+                FROM_HERE, base::BindOnce(&callbackOnFrameScriptBatchDone, weakThis, batchId),
+                base::Milliseconds(timeoutMs));
+    }
+}
+
+void WebContentsAdapter::didRunJavaScriptInFrame(quint64 batchId, quint64 frameId,
+                                                 const base::Value &result)
+{
+    auto it = m_frameScriptBatches.find(batchId);
+    if (it == m_frameScriptBatches.end())
+        return; // timed out
+    // The last result can arrive while its frame is being destroyed, so the batch is
+    // completed from a task of its own.
+    if ((*it)->addResult(frameId, result)) {
+        content::GetUIThreadTaskRunner({})->PostTask(
+                FROM_HERE, base::BindOnce(&callbackOnFrameScriptBatchDone,
+                                          sharedFromThis().toWeakRef(), batchId));
+    }
+}
+
+void WebContentsAdapter::finishFrameScriptBatch(quint64 batchId)
+{
+    if (auto batch = m_frameScriptBatches.take(batchId))
+        batch->finish();
+}
+
+QList<quint64> WebContentsAdapter::allFrameIds() const
+{
+    QList<quint64> frameIds;
+    if (!isInitialized())
+        return frameIds;
+    m_webContents->GetPrimaryMainFrame()->ForEachRenderFrameHost(
+            [&frameIds](content::RenderFrameHost *rfh) {
+                frameIds.append(static_cast<quint64>(rfh->GetFrameTreeNodeId().GetUnsafeValue()));
+            });
+    return frameIds;
+}
+
 void WebContentsAdapter::notifyUserActivation(quint64 frameId)
 {
     if (!isInitialized())
@@ -1150,6 +1716,47 @@ void WebContentsAdapter::smoothScrollBy(int dx, int dy, double factor, int posX,
         rwhv->smoothScrollBy(dx, dy, factor, posX, posY);
 }
 
+QVariantMap WebContentsAdapter::smoothScrollMetrics() const
+{
+    CHECK_INITIALIZED(QVariantMap());
+    auto *rwhv = static_cast<RenderWidgetHostViewQt *>(m_webContents->GetRenderWidgetHostView());
+    if (!rwhv || !rwhv->smoothScrollController())
+        return QVariantMap();
+    const SmoothScrollController *controller = rwhv->smoothScrollController();
+    const SmoothScrollController::Metrics &metrics = controller->metrics();
+    return QVariantMap{
+        { u"scrolling"_s, controller->isScrolling() },
+        { u"frames"_s, metrics.frames },
+        { u"zeroDeltaFrames"_s, metrics.zeroDeltaFrames },
+        { u"multiStepFrames"_s, metrics.multiStepFrames },
+    };
+}
+
+QVariantMap WebContentsAdapter::inputLatencyStatistics() const
+{
+    CHECK_INITIALIZED(QVariantMap());
+    auto *rwhv = static_cast<RenderWidgetHostViewQt *>(m_webContents->GetRenderWidgetHostView());
+    if (!rwhv)
+        return QVariantMap();
+    return rwhv->inputLatencyTracker()->statistics();
+}
+
+void WebContentsAdapter::resetInputLatencyStatistics()
+{
+    CHECK_INITIALIZED();
+    if (auto *rwhv = static_cast<RenderWidgetHostViewQt *>(m_webContents->GetRenderWidgetHostView()))
+        rwhv->inputLatencyTracker()->reset();
+}
+
+QVariantMap WebContentsAdapter::inputResamplingStatistics() const
+{
+    CHECK_INITIALIZED(QVariantMap());
+    auto *rwhv = static_cast<RenderWidgetHostViewQt *>(m_webContents->GetRenderWidgetHostView());
+    if (!rwhv)
+        return QVariantMap();
+    return rwhv->inputResampler()->statistics();
+}
+
 void WebContentsAdapter::didRunJavaScript(quint64 requestId, const base::Value &result)
 {
     Q_ASSERT(requestId);
@@ -1164,6 +1771,9 @@ void WebContentsAdapter::clearJavaScriptCallbacks()
     for (auto varFun : std::as_const(m_javaScriptCallbacks))
         varFun(QVariant());
     m_javaScriptCallbacks.clear();
+    const auto batches = std::exchange(m_frameScriptBatches, {});
+    for (const auto &batch : batches)
+        batch->finish();
 }
 
 quint64 WebContentsAdapter::fetchDocumentMarkup()
@@ -1344,7 +1954,27 @@ void WebContentsAdapter::setInspector(bool inspector)
 
 void WebContentsAdapter::openDevToolsFrontend(QSharedPointer<WebContentsAdapter> frontendAdapter)
 {
-    Q_ASSERT(isInitialized());
+    Q_ASSERT(isInitialized() || m_deferredInitialization);
+    // The page and its developer tools are connected once both are initialized, if the profile
+    // of either is still loading.
+    const bool frontendDeferred = !frontendAdapter->isInitialized()
+            && !frontendAdapter->profileAdapter()->isReady();
+    if (!isInitialized() || frontendDeferred) {
+        if (frontendDeferred)
+            frontendAdapter->deferInitialization(nullptr);
+        m_deferredDevToolsFrontend = frontendAdapter.toWeakRef();
+        WebContentsAdapter *waiting = isInitialized() ? frontendAdapter.data() : this;
+        waiting->m_deferredCalls.append([weakThis = sharedFromThis().toWeakRef(),
+                                         weakFrontend = frontendAdapter.toWeakRef()]() {
+            QSharedPointer<WebContentsAdapter> adapter = weakThis.toStrongRef();
+            QSharedPointer<WebContentsAdapter> frontend = weakFrontend.toStrongRef();
+            // Unless the developer tools were closed or replaced in the meantime.
+            if (adapter && frontend && adapter->m_deferredDevToolsFrontend == frontend)
+                adapter->openDevToolsFrontend(frontend);
+        });
+        return;
+    }
+    m_deferredDevToolsFrontend.clear();
     if (m_devToolsFrontend && frontendAdapter->webContents() &&
             m_devToolsFrontend->frontendDelegate() == frontendAdapter->webContents()->GetDelegate())
         return;
@@ -1365,6 +1995,7 @@ void WebContentsAdapter::openDevToolsFrontend(QSharedPointer<WebContentsAdapter>
 
 void WebContentsAdapter::closeDevToolsFrontend()
 {
+    m_deferredDevToolsFrontend.clear();
     if (m_devToolsFrontend) {
         m_devToolsFrontend->DisconnectFromTarget();
         m_devToolsFrontend->Close();
@@ -1418,12 +2049,14 @@ void WebContentsAdapter::printToPDF(const QPageLayout &pageLayout, const QPageRa
     PrintViewManagerQt::PrintToPDFFileCallback callback = base::BindOnce(&callbackOnPdfSavingFinished,
                                                                          m_adapterClient,
                                                                          filePath);
+    PrintViewManagerQt::PrintToPDFProgressCallback progressCallback =
+            base::BindRepeating(&callbackOnPdfSavingProgress, m_adapterClient, filePath);
     content::WebContents *webContents = m_webContents.get();
     if (content::WebContents *guest = guestWebContents())
         webContents = guest;
     PrintViewManagerQt::FromWebContents(webContents)
             ->PrintToPDFFileWithCallback(pageLayout, pageRanges, true, filePath, frameId,
-                                         std::move(callback));
+                                         std::move(callback), std::move(progressCallback));
 #endif // QT_CONFIG(webengine_printing_and_pdf)
 }
 
@@ -69,6 +69,7 @@ namespace QtWebEngineCore {
 
 class DevToolsFrontendQt;
 class FindTextHelper;
+class FrameScriptBatch;
 class ProfileQt;
 class WebEnginePageHost;
 class WebChannelIPCTransportHost;
@@ -80,6 +81,9 @@ public:
     // Sentinel to indicate a frame doesn't exist, for example with `findFrameByName`
     static constexpr quint64 kInvalidFrameId = -3;
 
+    struct NavigationEntryRecord;
+    struct NavigationHistorySnapshot;
+
     static QSharedPointer<WebContentsAdapter> createFromSerializedNavigationHistory(QDataStream &input, WebContentsAdapterClient *adapterClient);
     WebContentsAdapter();
     WebContentsAdapter(std::unique_ptr<content::WebContents> webContents);
@@ -140,14 +144,26 @@ public:
     QUrl getNavigationEntryIconUrl(int index);
     void clearNavigationHistory();
     void serializeNavigationHistory(QDataStream &output);
+    bool hasPendingNavigationHistory() const;
     void setZoomFactor(qreal);
     qreal currentZoomFactor() const;
     void runJavaScript(const QString &javaScript, quint32 worldId, quint64 frameId,
                        const std::function<void(const QVariant &)> &callback);
+    typedef std::function<void(const QList<std::pair<quint64, QVariant>> &)> FrameScriptCallback;
+    void runJavaScriptInFrames(const QString &javaScript, quint32 worldId,
+                               const QList<quint64> &frameIds, int timeoutMs,
+                               const FrameScriptCallback &callback);
+    QList<quint64> allFrameIds() const;
     void notifyUserActivation(quint64 frameId);
     QString networkQuery(const QString &queryType, const QString &argsJson = QString()) const;
     void smoothScrollBy(int dx, int dy, double factor, int posX = -1, int posY = -1);
+    QVariantMap smoothScrollMetrics() const;
+    QVariantMap inputLatencyStatistics() const;
+    void resetInputLatencyStatistics();
+    QVariantMap inputResamplingStatistics() const;
     void didRunJavaScript(quint64 requestId, const base::Value &result);
+    void didRunJavaScriptInFrame(quint64 batchId, quint64 frameId, const base::Value &result);
+    void finishFrameScriptBatch(quint64 batchId);
     void clearJavaScriptCallbacks();
     quint64 fetchDocumentMarkup();
     quint64 fetchDocumentInnerText();
@@ -262,9 +278,22 @@ private:
     void discard();
     void undiscard();
 
+    void deferInitialization(content::SiteInstance *site);
+    void initializeDeferred();
     void initializeRenderPrefs();
+    bool canRecycleWebContents() const;
+    bool hasExternalBeginFrames() const;
+    void recycleWebContents();
+    const NavigationEntryRecord *pendingNavigationEntry(int index);
 
     ProfileAdapter *m_profileAdapter;
+    std::unique_ptr<NavigationHistorySnapshot> m_pendingHistory;
+    // A page whose profile is still loading is initialized once the profile is ready, then
+    // makes the last load it was asked for and the calls that waited for it.
+    std::function<void()> m_deferredInitialization;
+    std::function<void()> m_deferredLoad;
+    QList<std::function<void()>> m_deferredCalls;
+    QWeakPointer<WebContentsAdapter> m_deferredDevToolsFrontend;
     std::unique_ptr<content::WebContents> m_webContents;
     std::unique_ptr<WebContentsDelegateQt> m_webContentsDelegate;
     std::unique_ptr<WebEnginePageHost> m_pageHost;
@@ -277,6 +306,7 @@ private:
     quint64 m_nextRequestId;
     QQueue<std::tuple<QUrl, bool, int, std::string>> m_pendingMouseLockPermissions;
     QMap<quint64, std::function<void(const QVariant &)>> m_javaScriptCallbacks;
+    QMap<quint64, std::shared_ptr<FrameScriptBatch>> m_frameScriptBatches;
     std::map<quint64, std::function<void(QSharedPointer<QByteArray>)>> m_printCallbacks;
     std::unique_ptr<content::DropData> m_currentDropData;
     uint m_currentDropAction;
@@ -144,6 +144,7 @@ public:
 
     virtual RenderWidgetHostViewQtDelegate* CreateRenderWidgetHostViewQtDelegate(RenderWidgetHostViewQtDelegateClient *client) = 0;
     virtual RenderWidgetHostViewQtDelegate* CreateRenderWidgetHostViewQtDelegateForPopup(RenderWidgetHostViewQtDelegateClient *client) = 0;
+    virtual bool usesExternalBeginFrames() const = 0;
     virtual void initializationFinished() = 0;
     virtual void lifecycleStateChanged(LifecycleState) = 0;
     virtual void recommendedStateChanged(LifecycleState) = 0;
@@ -190,6 +191,8 @@ public:
                             const QPageLayout &layout, const QPageRanges &ranges,
                             quint64 frameId) = 0;
     virtual void didPrintPageToPdf(const QString &filePath, bool success) = 0;
+    virtual void didPrintPageToPdfProgress(const QString &filePath, qint64 bytesWritten,
+                                           qint64 bytesTotal) = 0;
     virtual bool passOnFocus(bool reverse) = 0;
     // returns the last QObject (QWidget/QQuickItem) based object in the accessibility
     // hierarchy before going into the BrowserAccessibility tree
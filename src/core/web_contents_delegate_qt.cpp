@@ -111,6 +111,11 @@ content::WebContents *WebContentsDelegateQt::OpenURLFromTab(content::WebContents
             }
             if (!targetAdapter->isInitialized())
                 targetAdapter->initialize(target_site_instance);
+            if (!targetAdapter->isInitialized()) {
+                // The profile of the new page is still loading, it navigates once that is done.
+                targetAdapter->load(toQt(params.url));
+                return nullptr;
+            }
             target = targetAdapter->webContents();
         } else {
             return target;
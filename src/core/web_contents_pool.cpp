@@ -0,0 +1,207 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "web_contents_pool.h"
+
+#include "base/barrier_closure.h"
+#include "content/public/browser/dom_storage_context.h"
+#include "content/public/browser/host_zoom_map.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/session_storage_namespace.h"
+#include "content/public/browser/session_storage_usage_info.h"
+#include "content/public/browser/storage_partition.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "url/url_constants.h"
+
+namespace QtWebEngineCore {
+
+// Waits for the blank page a recycled WebContents navigates to.
+class WebContentsPool::ResetObserver : public content::WebContentsObserver
+{
+public:
+    ResetObserver(content::WebContents *webContents, WebContentsPool *pool, quint64 id)
+        : content::WebContentsObserver(webContents), m_pool(pool), m_id(id)
+    {
+    }
+
+    void DidStopLoading() override
+    {
+        if (!m_clearing && !web_contents()->IsLoading()
+            && web_contents()->GetController().GetEntryCount() == 1) {
+            m_clearing = true;
+            m_pool->clearSessionStorage(m_id);
+        }
+    }
+
+private:
+    WebContentsPool *m_pool;
+    quint64 m_id;
+    bool m_clearing = false;
+};
+
+WebContentsPool::WebContentsPool(int capacity)
+    : m_capacity(capacity)
+{
+}
+
+WebContentsPool::~WebContentsPool() = default;
+
+void WebContentsPool::setCapacity(int capacity)
+{
+    m_capacity = capacity;
+    trim();
+}
+
+void WebContentsPool::trim()
+{
+    while (int(m_entries.size()) > m_capacity)
+        m_entries.pop_front();
+}
+
+static bool isUsable(content::WebContents *webContents)
+{
+    return !webContents->IsCrashed() && webContents->GetPrimaryMainFrame()->IsRenderFrameLive();
+}
+
+// False while still on its way to the blank page that clears the history of its previous page.
+static bool isReset(content::WebContents *webContents)
+{
+    return !webContents->IsLoading() && webContents->GetController().GetEntryCount() == 1;
+}
+
+bool WebContentsPool::isAvailable(const Entry &entry) const
+{
+    return entry.sessionStorageCleared && isReset(entry.webContents.get());
+}
+
+WebContentsPool::Entry *WebContentsPool::findEntry(quint64 id)
+{
+    for (Entry &entry : m_entries) {
+        if (entry.id == id)
+            return &entry;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<content::WebContents> WebContentsPool::take()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (!isUsable(it->webContents.get())) {
+            it = m_entries.erase(it);
+            continue;
+        }
+        if (!isAvailable(*it)) {
+            ++it;
+            continue;
+        }
+        std::unique_ptr<content::WebContents> result = std::move(it->webContents);
+        m_entries.erase(it);
+        return result;
+    }
+    return nullptr;
+}
+
+int WebContentsPool::availableCount() const
+{
+    int count = 0;
+    for (const Entry &entry : m_entries) {
+        if (isUsable(entry.webContents.get()) && isAvailable(entry))
+            ++count;
+    }
+    return count;
+}
+
+void WebContentsPool::recycle(std::unique_ptr<content::WebContents> webContents)
+{
+    Q_ASSERT(webContents && !webContents->GetDelegate());
+    ++m_statistics.recycled;
+
+    webContents->Stop();
+    webContents->SetAudioMuted(false);
+    if (content::HostZoomMap *zoomMap = content::HostZoomMap::GetForWebContents(webContents.get()))
+        zoomMap->ClearTemporaryZoomLevel(webContents->GetPrimaryMainFrame()->GetGlobalId());
+
+    content::WebContents *contents = webContents.get();
+    Entry entry;
+    entry.id = ++m_nextEntryId;
+    entry.observer = std::make_unique<ResetObserver>(contents, this, entry.id);
+    entry.webContents = std::move(webContents);
+    m_entries.push_back(std::move(entry));
+
+    // Leave the previous document and drop its session history in one navigation. The
+    // WebContents is only handed out again once this has committed, see take().
+    content::NavigationController::LoadURLParams params((GURL(url::kAboutBlankURL)));
+    params.transition_type = ui::PAGE_TRANSITION_AUTO_TOPLEVEL;
+    params.should_clear_history_list = true;
+    contents->GetController().LoadURLWithParams(params);
+
+    trim();
+}
+
+// The session storage namespace belongs to the navigation controller and cannot be replaced,
+// so the data the previous page stored in it is deleted before the next page can read it.
+void WebContentsPool::clearSessionStorage(quint64 id)
+{
+    Entry *entry = findEntry(id);
+    if (!entry)
+        return;
+    content::WebContents *webContents = entry->webContents.get();
+    if (content::HostZoomMap *zoomMap = content::HostZoomMap::GetForWebContents(webContents))
+        zoomMap->ClearTemporaryZoomLevel(webContents->GetPrimaryMainFrame()->GetGlobalId());
+
+    const std::string namespaceId =
+            webContents->GetController().GetDefaultSessionStorageNamespace()->id();
+    webContents->GetPrimaryMainFrame()->GetStoragePartition()->GetDOMStorageContext()
+            ->GetSessionStorageUsage(base::BindOnce(&WebContentsPool::sessionStorageUsageReceived,
+                                                    m_weakPtrFactory.GetWeakPtr(), id,
+                                                    namespaceId));
+}
+
+void WebContentsPool::sessionStorageUsageReceived(
+        quint64 id, const std::string &namespaceId,
+        const std::vector<content::SessionStorageUsageInfo> &usage)
+{
+    Entry *entry = findEntry(id);
+    if (!entry)
+        return;
+
+    std::vector<content::SessionStorageUsageInfo> owned;
+    for (const content::SessionStorageUsageInfo &info : usage) {
+        if (info.namespace_id == namespaceId)
+            owned.push_back(info);
+    }
+    if (owned.empty()) {
+        entry->sessionStorageCleared = true;
+        return;
+    }
+
+    content::DOMStorageContext *context =
+            entry->webContents->GetPrimaryMainFrame()->GetStoragePartition()->GetDOMStorageContext();
+    base::RepeatingClosure done = base::BarrierClosure(
+            owned.size(),
+            base::BindOnce(&WebContentsPool::sessionStorageCleared, m_weakPtrFactory.GetWeakPtr(), id));
+    for (const content::SessionStorageUsageInfo &info : owned)
+        context->DeleteSessionStorage(info, done);
+}
+
+void WebContentsPool::sessionStorageCleared(quint64 id)
+{
+    if (Entry *entry = findEntry(id))
+        entry->sessionStorageCleared = true;
+}
+
+void WebContentsPool::recordInitialization(bool reused, base::TimeDelta duration)
+{
+    if (reused) {
+        ++m_statistics.reused;
+        m_statistics.reuseTime += duration;
+    } else {
+        ++m_statistics.created;
+        m_statistics.creationTime += duration;
+    }
+}
+
+} // namespace QtWebEngineCore
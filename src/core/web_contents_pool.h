@@ -0,0 +1,96 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef WEB_CONTENTS_POOL_H
+#define WEB_CONTENTS_POOL_H
+
+#include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace content {
+class WebContents;
+struct SessionStorageUsageInfo;
+}
+
+namespace QtWebEngineCore {
+
+// Keeps the WebContents of destroyed pages of a profile around, so that new pages can take
+// them over instead of creating a WebContents, a RenderView and their observers from scratch.
+class WebContentsPool
+{
+public:
+    struct Statistics
+    {
+        quint64 created = 0;
+        quint64 reused = 0;
+        quint64 recycled = 0;
+        quint64 discarded = 0;
+        base::TimeDelta creationTime;
+        base::TimeDelta reuseTime;
+    };
+
+    explicit WebContentsPool(int capacity);
+    ~WebContentsPool();
+
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+    bool isFull() const { return int(m_entries.size()) >= m_capacity; }
+
+    // Returns a recycled WebContents that finished resetting, or null.
+    std::unique_ptr<content::WebContents> take();
+    // Number of web contents that take() could hand out right now.
+    int availableCount() const;
+    // Resets and keeps webContents. The caller has already detached everything that refers to
+    // its previous page. Its session storage is cleared once the blank page has loaded.
+    void recycle(std::unique_ptr<content::WebContents> webContents);
+    void recordDiscarded() { ++m_statistics.discarded; }
+    void recordInitialization(bool reused, base::TimeDelta duration);
+
+    const Statistics &statistics() const { return m_statistics; }
+
+private:
+    class ResetObserver;
+    struct Entry
+    {
+        std::unique_ptr<content::WebContents> webContents;
+        std::unique_ptr<ResetObserver> observer;
+        quint64 id = 0;
+        bool sessionStorageCleared = false;
+    };
+
+    void trim();
+    bool isAvailable(const Entry &entry) const;
+    Entry *findEntry(quint64 id);
+    void clearSessionStorage(quint64 id);
+    void sessionStorageUsageReceived(quint64 id, const std::string &namespaceId,
+                                     const std::vector<content::SessionStorageUsageInfo> &usage);
+    void sessionStorageCleared(quint64 id);
+
+    int m_capacity;
+    std::deque<Entry> m_entries;
+    quint64 m_nextEntryId = 0;
+    Statistics m_statistics;
+    base::WeakPtrFactory<WebContentsPool> m_weakPtrFactory{ this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // WEB_CONTENTS_POOL_H
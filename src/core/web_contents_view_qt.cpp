@@ -57,9 +57,23 @@ void WebContentsViewQt::setClient(WebContentsAdapterClient* client)
     }
 }
 
+// Detaches the view from its client and the client's delegate, so that the WebContents can
+// be taken over by another page.
+void WebContentsViewQt::resetClient()
+{
+    m_client = nullptr;
+    m_factoryClient = nullptr;
+
+    if (auto rwhv = static_cast<RenderWidgetHostViewQt *>(m_webContents->GetRenderWidgetHostView())) {
+        rwhv->setAdapterClient(nullptr);
+        rwhv->setDelegate(nullptr);
+    }
+}
+
 content::RenderWidgetHostViewBase* WebContentsViewQt::CreateViewForWidget(content::RenderWidgetHost *render_widget_host)
 {
-    RenderWidgetHostViewQt *view = new RenderWidgetHostViewQt(render_widget_host);
+    RenderWidgetHostViewQt *view = new RenderWidgetHostViewQt(
+            render_widget_host, m_factoryClient && m_factoryClient->usesExternalBeginFrames());
 
     if (m_factoryClient) {
         view->setDelegate(m_factoryClient->CreateRenderWidgetHostViewQtDelegate(view->delegateClient()));
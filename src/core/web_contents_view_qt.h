@@ -33,6 +33,7 @@ public:
 
     void setFactoryClient(WebContentsAdapterClient* client);
     void setClient(WebContentsAdapterClient* client);
+    void resetClient();
     WebContentsAdapterClient *client() { return m_client; }
 
     // content::WebContentsView overrides:
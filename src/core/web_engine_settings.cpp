@@ -24,6 +24,9 @@
 #include <QFont>
 #include <QTimer>
 
+#include <array>
+#include <bitset>
+
 using namespace Qt::StringLiterals;
 
 namespace QtWebEngineCore {
@@ -34,6 +37,31 @@ QHash<QWebEngineSettings::FontSize, int> WebEngineSettings::s_defaultFontSizes;
 
 static const int batchTimerTimeout = 0;
 
+// Snapshots have room for the attributes up to the last one, which has to be updated whenever
+// QWebEngineSettings::WebAttribute is extended. initDefaults() checks that it was.
+constexpr QWebEngineSettings::WebAttribute kLastAttribute = QWebEngineSettings::InputResamplingEnabled;
+constexpr size_t kAttributeCount = kLastAttribute + 1;
+constexpr size_t kFontFamilyCount = QWebEngineSettings::PictographFont + 1;
+constexpr size_t kFontSizeCount = QWebEngineSettings::DefaultFixedFontSize + 1;
+
+// Immutable, fully resolved view of a settings object and all of its ancestors. It replaces
+// walking the parent chain with hash lookups for every single value, and lets settings
+// that do not override anything share the snapshot of their parent.
+struct WebEngineSettings::Snapshot
+{
+    std::array<bool, kAttributeCount> attributes = {};
+    std::bitset<kAttributeCount> explicitAttributes;
+    std::array<QString, kFontFamilyCount> fontFamilies;
+    std::array<int, kFontSizeCount> fontSizes = {};
+    QString defaultEncoding;
+    QWebEngineSettings::UnknownUrlSchemePolicy unknownUrlSchemePolicy =
+            QWebEngineSettings::AllowUnknownUrlSchemesFromUserInteraction;
+    QWebEngineSettings::ImageAnimationPolicy imageAnimationPolicy =
+            QWebEngineSettings::ImageAnimationPolicy::Allow;
+
+    bool operator==(const Snapshot &) const = default;
+};
+
 static inline bool isTouchScreenDetected()
 {
     return ui::GetTouchScreensAvailability() == ui::TouchScreensAvailability::ENABLED;
@@ -68,7 +96,7 @@ WebEngineSettings::WebEngineSettings(WebEngineSettings *_parentSettings)
     m_batchTimer.setSingleShot(true);
     m_batchTimer.setInterval(batchTimerTimeout);
     QObject::connect(&m_batchTimer, &QTimer::timeout, [this]() {
-        doApply();
+        doApply(true);
     });
 }
 
@@ -77,14 +105,17 @@ WebEngineSettings::~WebEngineSettings()
     if (parentSettings)
         parentSettings->childSettings.remove(this);
     // In QML the profile and its settings may be garbage collected before the page and its settings.
-    for (WebEngineSettings *settings : std::as_const(childSettings))
+    for (WebEngineSettings *settings : std::as_const(childSettings)) {
         settings->parentSettings = nullptr;
+        settings->invalidateSnapshot();
+    }
 }
 
 void WebEngineSettings::overrideWebPreferences(content::WebContents *webContents, blink::web_pref::WebPreferences *prefs)
 {
     // Apply our settings on top of those.
     applySettingsToWebPreferences(prefs);
+    m_appliedSnapshot = snapshot();
     // Store the current webPreferences in use if this is the first time we get here
     // as the host process already overides some of the default WebPreferences values
     // before we get here (e.g. number_of_cpu_cores).
@@ -105,26 +136,12 @@ void WebEngineSettings::setAttribute(QWebEngineSettings::WebAttribute attr, bool
 
 bool WebEngineSettings::testAttribute(QWebEngineSettings::WebAttribute attr) const
 {
-    auto it = m_attributes.constFind(attr);
-    if (it != m_attributes.constEnd())
-        return *it;
-
-    if (parentSettings)
-        return parentSettings->testAttribute(attr);
-
-    Q_ASSERT(s_defaultAttributes.contains(attr));
-    return s_defaultAttributes.value(attr);
+    return snapshot()->attributes[attr];
 }
 
 bool WebEngineSettings::isAttributeExplicitlySet(QWebEngineSettings::WebAttribute attr) const
 {
-    if (m_attributes.contains(attr))
-        return true;
-
-    if (parentSettings)
-        return parentSettings->isAttributeExplicitlySet(attr);
-
-    return false;
+    return snapshot()->explicitAttributes.test(attr);
 }
 
 void WebEngineSettings::resetAttribute(QWebEngineSettings::WebAttribute attr)
@@ -141,11 +158,7 @@ void WebEngineSettings::setFontFamily(QWebEngineSettings::FontFamily which, cons
 
 QString WebEngineSettings::fontFamily(QWebEngineSettings::FontFamily which)
 {
-    if (!parentSettings) {
-        Q_ASSERT(s_defaultFontFamilies.contains(which));
-        return m_fontFamilies.value(which, s_defaultFontFamilies.value(which));
-    }
-    return m_fontFamilies.value(which, parentSettings->fontFamily(which));
+    return snapshot()->fontFamilies[which];
 }
 
 void WebEngineSettings::resetFontFamily(QWebEngineSettings::FontFamily which)
@@ -162,11 +175,7 @@ void WebEngineSettings::setFontSize(QWebEngineSettings::FontSize type, int size)
 
 int WebEngineSettings::fontSize(QWebEngineSettings::FontSize type) const
 {
-    if (!parentSettings) {
-        Q_ASSERT(s_defaultFontSizes.contains(type));
-        return m_fontSizes.value(type, s_defaultFontSizes.value(type));
-    }
-    return m_fontSizes.value(type, parentSettings->fontSize(type));
+    return snapshot()->fontSizes[type];
 }
 
 void WebEngineSettings::resetFontSize(QWebEngineSettings::FontSize type)
@@ -183,9 +192,7 @@ void WebEngineSettings::setDefaultTextEncoding(const QString &encoding)
 
 QString WebEngineSettings::defaultTextEncoding() const
 {
-    if (!parentSettings)
-        return m_defaultEncoding;
-    return m_defaultEncoding.isEmpty()? parentSettings->defaultTextEncoding() : m_defaultEncoding;
+    return snapshot()->defaultEncoding;
 }
 
 void WebEngineSettings::setUnknownUrlSchemePolicy(QWebEngineSettings::UnknownUrlSchemePolicy policy)
@@ -202,24 +209,73 @@ void WebEngineSettings::setImageAnimationPolicy(QWebEngineSettings::ImageAnimati
 
 QWebEngineSettings::ImageAnimationPolicy WebEngineSettings::imageAnimationPolicy() const
 {
-    if (m_imageAnimationPolicy != QWebEngineSettings::ImageAnimationPolicy::Inherited)
-        return m_imageAnimationPolicy;
+    return snapshot()->imageAnimationPolicy;
+}
 
-    if (parentSettings)
-        return parentSettings->imageAnimationPolicy();
+QWebEngineSettings::UnknownUrlSchemePolicy WebEngineSettings::unknownUrlSchemePolicy() const
+{
+    return snapshot()->unknownUrlSchemePolicy;
+}
 
-    return QWebEngineSettings::ImageAnimationPolicy::Allow;
+bool WebEngineSettings::hasOverrides() const
+{
+    return !m_attributes.isEmpty() || !m_fontFamilies.isEmpty() || !m_fontSizes.isEmpty()
+            || !m_defaultEncoding.isEmpty()
+            || m_unknownUrlSchemePolicy != QWebEngineSettings::InheritedUnknownUrlSchemePolicy
+            || m_imageAnimationPolicy != QWebEngineSettings::ImageAnimationPolicy::Inherited;
 }
 
-QWebEngineSettings::UnknownUrlSchemePolicy WebEngineSettings::unknownUrlSchemePolicy() const
+std::shared_ptr<const WebEngineSettings::Snapshot> WebEngineSettings::snapshot() const
 {
+    if (m_snapshot)
+        return m_snapshot;
+
+    if (parentSettings && !hasOverrides()) {
+        m_snapshot = parentSettings->snapshot();
+        return m_snapshot;
+    }
+
+    std::shared_ptr<Snapshot> snapshot;
+    if (parentSettings) {
+        snapshot = std::make_shared<Snapshot>(*parentSettings->snapshot());
+    } else {
+        snapshot = std::make_shared<Snapshot>();
+        for (auto it = s_defaultAttributes.cbegin(); it != s_defaultAttributes.cend(); ++it)
+            snapshot->attributes[it.key()] = it.value();
+        for (auto it = s_defaultFontFamilies.cbegin(); it != s_defaultFontFamilies.cend(); ++it)
+            snapshot->fontFamilies[it.key()] = it.value();
+        for (auto it = s_defaultFontSizes.cbegin(); it != s_defaultFontSizes.cend(); ++it)
+            snapshot->fontSizes[it.key()] = it.value();
+        // The root keeps its encoding even when it was cleared.
+        snapshot->defaultEncoding = m_defaultEncoding;
+    }
+
+    for (auto it = m_attributes.cbegin(); it != m_attributes.cend(); ++it) {
+        snapshot->attributes[it.key()] = it.value();
+        snapshot->explicitAttributes.set(it.key());
+    }
+    for (auto it = m_fontFamilies.cbegin(); it != m_fontFamilies.cend(); ++it)
+        snapshot->fontFamilies[it.key()] = it.value();
+    for (auto it = m_fontSizes.cbegin(); it != m_fontSizes.cend(); ++it)
+        snapshot->fontSizes[it.key()] = it.value();
+    if (!m_defaultEncoding.isEmpty())
+        snapshot->defaultEncoding = m_defaultEncoding;
     // value InheritedUnknownUrlSchemePolicy means it is taken from parent, if possible. If there
     // is no parent, then AllowUnknownUrlSchemesFromUserInteraction (the default behavior) is used.
     if (m_unknownUrlSchemePolicy != QWebEngineSettings::InheritedUnknownUrlSchemePolicy)
-        return m_unknownUrlSchemePolicy;
-    if (parentSettings)
-        return parentSettings->unknownUrlSchemePolicy();
-    return QWebEngineSettings::AllowUnknownUrlSchemesFromUserInteraction;
+        snapshot->unknownUrlSchemePolicy = m_unknownUrlSchemePolicy;
+    if (m_imageAnimationPolicy != QWebEngineSettings::ImageAnimationPolicy::Inherited)
+        snapshot->imageAnimationPolicy = m_imageAnimationPolicy;
+
+    m_snapshot = std::move(snapshot);
+    return m_snapshot;
+}
+
+void WebEngineSettings::invalidateSnapshot()
+{
+    m_snapshot.reset();
+    for (WebEngineSettings *settings : std::as_const(childSettings))
+        settings->invalidateSnapshot();
 }
 
 void WebEngineSettings::initDefaults()
@@ -290,6 +346,10 @@ void WebEngineSettings::initDefaults()
                                    isTouchScreenDetected());
         s_defaultAttributes.insert(QWebEngineSettings::BackForwardCacheEnabled, false);
         s_defaultAttributes.insert(QWebEngineSettings::ElementShaderEnabled, false);
+        s_defaultAttributes.insert(QWebEngineSettings::InputResamplingEnabled, false);
+        // Every attribute has a default, so a new one beyond kLastAttribute shows up here.
+        Q_ASSERT_X(size_t(s_defaultAttributes.size()) == kAttributeCount, "initDefaults",
+                   "kLastAttribute is not the last QWebEngineSettings::WebAttribute");
     }
 
     if (s_defaultFontFamilies.isEmpty()) {
@@ -333,12 +393,26 @@ void WebEngineSettings::scheduleApply()
         m_batchTimer.start();
 }
 
-void WebEngineSettings::doApply()
+void WebEngineSettings::doApply(bool onSettingsChange)
 {
+    m_batchTimer.stop();
+
+    // Settings shared by many pages, like the ones of a profile, update all of them from a
+    // single timer. Pages without overrides end up sharing the new snapshot of their parent.
+    for (WebEngineSettings *settings : std::as_const(childSettings))
+        settings->doApply(onSettingsChange);
+
     if (webPreferences.isNull())
         return;
 
-    m_batchTimer.stop();
+    // Nothing to send for a settings change if the effective settings of this page did not
+    // change, for instance because it overrides whatever was changed in its parent.
+    const auto current = snapshot();
+    if (onSettingsChange && m_appliedSnapshot
+        && (m_appliedSnapshot == current || *m_appliedSnapshot == *current))
+        return;
+    m_appliedSnapshot = current;
+
     // Override with our settings when applicable
     applySettingsToWebPreferences(webPreferences.data());
     Q_ASSERT(m_adapter);
@@ -366,68 +440,70 @@ void WebEngineSettings::applySettingsToWebPreferences(blink::web_pref::WebPrefer
         prefs->main_frame_resizes_are_orientation_changes = true;
     }
 
+    const Snapshot &settings = *snapshot();
+
     // Attributes mapping.
-    prefs->loads_images_automatically = testAttribute(QWebEngineSettings::AutoLoadImages);
-    prefs->javascript_enabled = testAttribute(QWebEngineSettings::JavascriptEnabled);
+    prefs->loads_images_automatically = settings.attributes[QWebEngineSettings::AutoLoadImages];
+    prefs->javascript_enabled = settings.attributes[QWebEngineSettings::JavascriptEnabled];
     prefs->javascript_can_access_clipboard =
-            testAttribute(QWebEngineSettings::JavascriptCanAccessClipboard);
-    prefs->tabs_to_links = testAttribute(QWebEngineSettings::LinksIncludedInFocusChain);
-    prefs->local_storage_enabled = testAttribute(QWebEngineSettings::LocalStorageEnabled);
-    prefs->databases_enabled = testAttribute(QWebEngineSettings::LocalStorageEnabled);
+            settings.attributes[QWebEngineSettings::JavascriptCanAccessClipboard];
+    prefs->tabs_to_links = settings.attributes[QWebEngineSettings::LinksIncludedInFocusChain];
+    prefs->local_storage_enabled = settings.attributes[QWebEngineSettings::LocalStorageEnabled];
+    prefs->databases_enabled = settings.attributes[QWebEngineSettings::LocalStorageEnabled];
     prefs->allow_remote_access_from_local_urls =
-            testAttribute(QWebEngineSettings::LocalContentCanAccessRemoteUrls);
-    prefs->spatial_navigation_enabled = testAttribute(QWebEngineSettings::SpatialNavigationEnabled);
+            settings.attributes[QWebEngineSettings::LocalContentCanAccessRemoteUrls];
+    prefs->spatial_navigation_enabled = settings.attributes[QWebEngineSettings::SpatialNavigationEnabled];
     prefs->allow_file_access_from_file_urls =
-            testAttribute(QWebEngineSettings::LocalContentCanAccessFileUrls);
-    prefs->hyperlink_auditing_enabled = testAttribute(QWebEngineSettings::HyperlinkAuditingEnabled);
-    prefs->enable_scroll_animator = testAttribute(QWebEngineSettings::ScrollAnimatorEnabled);
-    prefs->enable_error_page = testAttribute(QWebEngineSettings::ErrorPageEnabled);
-    prefs->plugins_enabled = testAttribute(QWebEngineSettings::PluginsEnabled);
-    prefs->fullscreen_supported = testAttribute(QWebEngineSettings::FullScreenSupportEnabled);
+            settings.attributes[QWebEngineSettings::LocalContentCanAccessFileUrls];
+    prefs->hyperlink_auditing_enabled = settings.attributes[QWebEngineSettings::HyperlinkAuditingEnabled];
+    prefs->enable_scroll_animator = settings.attributes[QWebEngineSettings::ScrollAnimatorEnabled];
+    prefs->enable_error_page = settings.attributes[QWebEngineSettings::ErrorPageEnabled];
+    prefs->plugins_enabled = settings.attributes[QWebEngineSettings::PluginsEnabled];
+    prefs->fullscreen_supported = settings.attributes[QWebEngineSettings::FullScreenSupportEnabled];
     prefs->accelerated_2d_canvas_enabled =
-            testAttribute(QWebEngineSettings::Accelerated2dCanvasEnabled);
-    prefs->force_dark_mode_enabled = testAttribute(QWebEngineSettings::ForceDarkMode);
-    prefs->element_shader_enabled = testAttribute(QWebEngineSettings::ElementShaderEnabled);
+            settings.attributes[QWebEngineSettings::Accelerated2dCanvasEnabled];
+    prefs->force_dark_mode_enabled = settings.attributes[QWebEngineSettings::ForceDarkMode];
+    prefs->element_shader_enabled = settings.attributes[QWebEngineSettings::ElementShaderEnabled];
     ui::NativeTheme::set_element_shader_enabled(prefs->element_shader_enabled);
-    prefs->webgl1_enabled = prefs->webgl2_enabled = testAttribute(QWebEngineSettings::WebGLEnabled);
-    prefs->should_print_backgrounds = testAttribute(QWebEngineSettings::PrintElementBackgrounds);
+    prefs->webgl1_enabled = prefs->webgl2_enabled = settings.attributes[QWebEngineSettings::WebGLEnabled];
+    prefs->should_print_backgrounds = settings.attributes[QWebEngineSettings::PrintElementBackgrounds];
     prefs->allow_running_insecure_content =
-            testAttribute(QWebEngineSettings::AllowRunningInsecureContent);
+            settings.attributes[QWebEngineSettings::AllowRunningInsecureContent];
     prefs->allow_geolocation_on_insecure_origins =
-            testAttribute(QWebEngineSettings::AllowGeolocationOnInsecureOrigins);
-    prefs->hide_scrollbars = !testAttribute(QWebEngineSettings::ShowScrollBars);
-    if (isAttributeExplicitlySet(QWebEngineSettings::PlaybackRequiresUserGesture)) {
-        prefs->autoplay_policy = testAttribute(QWebEngineSettings::PlaybackRequiresUserGesture)
+            settings.attributes[QWebEngineSettings::AllowGeolocationOnInsecureOrigins];
+    prefs->hide_scrollbars = !settings.attributes[QWebEngineSettings::ShowScrollBars];
+    if (settings.explicitAttributes.test(QWebEngineSettings::PlaybackRequiresUserGesture)) {
+        prefs->autoplay_policy = settings.attributes[QWebEngineSettings::PlaybackRequiresUserGesture]
                                ? blink::mojom::AutoplayPolicy::kUserGestureRequired
                                : blink::mojom::AutoplayPolicy::kNoUserGestureRequired;
     }
-    prefs->dom_paste_enabled = testAttribute(QWebEngineSettings::JavascriptCanPaste);
-    prefs->dns_prefetching_enabled = testAttribute(QWebEngineSettings::DnsPrefetchEnabled);
-    prefs->disable_reading_from_canvas = !testAttribute(QWebEngineSettings::ReadingFromCanvasEnabled);
-    prefs->animation_policy = toBlinkImageAnimationPolicy(imageAnimationPolicy());
-    bool touchEventsEnabled = isAttributeExplicitlySet(QWebEngineSettings::TouchEventsApiEnabled)
-            ? testAttribute(QWebEngineSettings::TouchEventsApiEnabled)
+    prefs->dom_paste_enabled = settings.attributes[QWebEngineSettings::JavascriptCanPaste];
+    prefs->dns_prefetching_enabled = settings.attributes[QWebEngineSettings::DnsPrefetchEnabled];
+    prefs->disable_reading_from_canvas = !settings.attributes[QWebEngineSettings::ReadingFromCanvasEnabled];
+    prefs->animation_policy = toBlinkImageAnimationPolicy(settings.imageAnimationPolicy);
+    bool touchEventsEnabled = settings.explicitAttributes.test(QWebEngineSettings::TouchEventsApiEnabled)
+            ? settings.attributes[QWebEngineSettings::TouchEventsApiEnabled]
             : isTouchScreenDetected();
     prefs->touch_event_feature_detection_enabled = touchEventsEnabled;
 
     // Fonts settings.
     prefs->standard_font_family_map[blink::web_pref::kCommonScript] =
-            toString16(fontFamily(QWebEngineSettings::StandardFont));
+            toString16(settings.fontFamilies[QWebEngineSettings::StandardFont]);
     prefs->fixed_font_family_map[blink::web_pref::kCommonScript] =
-            toString16(fontFamily(QWebEngineSettings::FixedFont));
+            toString16(settings.fontFamilies[QWebEngineSettings::FixedFont]);
     prefs->serif_font_family_map[blink::web_pref::kCommonScript] =
-            toString16(fontFamily(QWebEngineSettings::SerifFont));
+            toString16(settings.fontFamilies[QWebEngineSettings::SerifFont]);
     prefs->sans_serif_font_family_map[blink::web_pref::kCommonScript] =
-            toString16(fontFamily(QWebEngineSettings::SansSerifFont));
+            toString16(settings.fontFamilies[QWebEngineSettings::SansSerifFont]);
     prefs->cursive_font_family_map[blink::web_pref::kCommonScript] =
-            toString16(fontFamily(QWebEngineSettings::CursiveFont));
+            toString16(settings.fontFamilies[QWebEngineSettings::CursiveFont]);
     prefs->fantasy_font_family_map[blink::web_pref::kCommonScript] =
-            toString16(fontFamily(QWebEngineSettings::FantasyFont));
-    prefs->default_font_size = fontSize(QWebEngineSettings::DefaultFontSize);
-    prefs->default_fixed_font_size = fontSize(QWebEngineSettings::DefaultFixedFontSize);
-    prefs->minimum_font_size = fontSize(QWebEngineSettings::MinimumFontSize);
-    prefs->minimum_logical_font_size = fontSize(QWebEngineSettings::MinimumLogicalFontSize);
-    prefs->default_encoding = defaultTextEncoding().toStdString();
+            toString16(settings.fontFamilies[QWebEngineSettings::FantasyFont]);
+    prefs->default_font_size = settings.fontSizes[QWebEngineSettings::DefaultFontSize];
+    prefs->default_fixed_font_size = settings.fontSizes[QWebEngineSettings::DefaultFixedFontSize];
+    prefs->minimum_font_size = settings.fontSizes[QWebEngineSettings::MinimumFontSize];
+    prefs->minimum_logical_font_size = settings.fontSizes[QWebEngineSettings::MinimumLogicalFontSize];
+    prefs->default_encoding = settings.defaultEncoding.toStdString();
 
     // Set the theme colors. Based on chrome_content_browser_client.cc:
     const ui::NativeTheme *webTheme = ui::NativeTheme::GetInstanceForWeb();
@@ -492,10 +568,9 @@ bool WebEngineSettings::applySettingsToRendererPreferences(blink::RendererPrefer
 
 void WebEngineSettings::scheduleApplyRecursively()
 {
+    invalidateSnapshot();
+    // Children are applied from doApply(), so one timer covers all pages sharing these settings.
     scheduleApply();
-    for (WebEngineSettings *settings : std::as_const(childSettings)) {
-        settings->scheduleApply();
-    }
 }
 
 bool WebEngineSettings::getJavaScriptCanOpenWindowsAutomatically()
@@ -23,6 +23,8 @@
 #include <QSet>
 #include <QTimer>
 
+#include <memory>
+
 namespace content {
 class WebContents;
 }
@@ -77,8 +79,15 @@ public:
     bool getJavaScriptCanOpenWindowsAutomatically();
 
 private:
+    struct Snapshot;
+
     void initDefaults();
-    void doApply();
+    std::shared_ptr<const Snapshot> snapshot() const;
+    bool hasOverrides() const;
+    void invalidateSnapshot();
+    // The web preferences also depend on state outside of the settings, like the color
+    // scheme, so only applying after a settings change can be skipped if nothing changed.
+    void doApply(bool onSettingsChange = false);
     void applySettingsToWebPreferences(blink::web_pref::WebPreferences *);
     bool applySettingsToRendererPreferences(blink::RendererPreferences *);
     void setWebContentsAdapter(WebContentsAdapter *adapter) { m_adapter = adapter; }
@@ -94,6 +103,11 @@ private:
     WebEngineSettings *parentSettings;
     QSet<WebEngineSettings *> childSettings;
 
+    // Flattened effective settings, shared with the parent while nothing is overridden here.
+    mutable std::shared_ptr<const Snapshot> m_snapshot;
+    // Snapshot the web preferences of m_adapter were last computed from.
+    std::shared_ptr<const Snapshot> m_appliedSnapshot;
+
     static QHash<QWebEngineSettings::WebAttribute, bool> s_defaultAttributes;
     static QHash<QWebEngineSettings::FontFamily, QString> s_defaultFontFamilies;
     static QHash<QWebEngineSettings::FontSize, int> s_defaultFontSizes;
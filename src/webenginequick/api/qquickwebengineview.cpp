@@ -1340,6 +1340,13 @@ void QQuickWebEngineViewPrivate::didPrintPageToPdf(const QString &filePath, bool
     Q_EMIT q->pdfPrintingFinished(filePath, success);
 }
 
+void QQuickWebEngineViewPrivate::didPrintPageToPdfProgress(const QString &filePath,
+                                                           qint64 bytesWritten, qint64 bytesTotal)
+{
+    Q_Q(QQuickWebEngineView);
+    Q_EMIT q->pdfPrintingProgress(filePath, bytesWritten, bytesTotal);
+}
+
 void QQuickWebEngineViewPrivate::updateScrollPosition(const QPointF &position)
 {
     Q_Q(QQuickWebEngineView);
@@ -1617,7 +1624,9 @@ void QQuickWebEngineView::printToPdf(const QJSValue &callback, PrintedPageSizeId
     d->ensureContentsAdapter();
     std::function wrappedCallback = [this, callback](QSharedPointer<QByteArray> result) {
         QJSValueList args;
-        args.append(qmlEngine(this)->toScriptValue(*result));
+        // The result references the shared memory of the print job; detach it before
+        // handing it out.
+        args.append(qmlEngine(this)->toScriptValue(QByteArray(result->constData(), result->size())));
         callback.call(args);
     };
 
@@ -2325,6 +2334,9 @@ void QQuickWebEngineView::componentComplete()
     role.write(QAccessible::Grouping);
 #endif // QT_CONFIG(accessibility)
 
+    if (UIDelegatesManager::isWarmUpEnabled())
+        d->ui()->warmUp();
+
     QTimer::singleShot(0, this, &QQuickWebEngineView::lazyInitialize);
 }
 
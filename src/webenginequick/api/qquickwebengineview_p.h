@@ -573,6 +573,8 @@ Q_SIGNALS:
     Q_REVISION(6,7) void desktopMediaRequested(const QWebEngineDesktopMediaRequest &request);
     Q_REVISION(6, 8) void printRequestedByFrame(QWebEngineFrame frame);
     Q_REVISION(6,8) void permissionRequested(QWebEnginePermission permissionRequest);
+    Q_REVISION(6, 10) void pdfPrintingProgress(const QString &filePath, qint64 bytesWritten,
+                                               qint64 bytesTotal);
 
 protected:
     void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
@@ -57,6 +57,7 @@ public:
 
     QtWebEngineCore::RenderWidgetHostViewQtDelegate* CreateRenderWidgetHostViewQtDelegate(QtWebEngineCore::RenderWidgetHostViewQtDelegateClient *client) override;
     QtWebEngineCore::RenderWidgetHostViewQtDelegate* CreateRenderWidgetHostViewQtDelegateForPopup(QtWebEngineCore::RenderWidgetHostViewQtDelegateClient *client) override;
+    bool usesExternalBeginFrames() const override { return false; }
     void initializationFinished() override;
     void lifecycleStateChanged(LifecycleState state) override;
     void recommendedStateChanged(LifecycleState state) override;
@@ -102,6 +103,8 @@ public:
     void printToPdf(std::function<void(QSharedPointer<QByteArray>)> &&callback,
                     const QPageLayout &layout, const QPageRanges &ranges, quint64 frameId) override;
     void didPrintPageToPdf(const QString &filePath, bool success) override;
+    void didPrintPageToPdfProgress(const QString &filePath, qint64 bytesWritten,
+                                   qint64 bytesTotal) override;
     bool passOnFocus(bool reverse) override;
     void javaScriptConsoleMessage(JavaScriptConsoleMessageLevel level, const QString& message, int lineNumber, const QString& sourceID) override;
     void authenticationRequired(QSharedPointer<QtWebEngineCore::AuthenticationDialogController>) override;
@@ -112,8 +112,22 @@ UIDelegatesManager::~UIDelegatesManager()
 
 #define COMPONENT_MEMBER_CASE_STATEMENT(TYPE, COMPONENT) \
     case TYPE: \
-        component = &COMPONENT##Component; \
-        break;
+        return &COMPONENT##Component;
+
+QQmlComponent **UIDelegatesManager::componentForType(ComponentType type)
+{
+    switch (type) {
+    FOR_EACH_COMPONENT_TYPE(COMPONENT_MEMBER_CASE_STATEMENT, NO_SEPARATOR)
+    default:
+        Q_UNREACHABLE_RETURN(nullptr);
+    }
+}
+
+static bool isPooledComponentType(UIDelegatesManager::ComponentType type)
+{
+    return type == UIDelegatesManager::AlertDialog || type == UIDelegatesManager::ConfirmDialog
+            || type == UIDelegatesManager::PromptDialog;
+}
 
 bool UIDelegatesManager::ensureComponentLoaded(ComponentType type)
 {
@@ -122,19 +136,16 @@ bool UIDelegatesManager::ensureComponentLoaded(ComponentType type)
     if (!engine)
         return false;
 
-    QQmlComponent **component;
-    switch (type) {
-    FOR_EACH_COMPONENT_TYPE(COMPONENT_MEMBER_CASE_STATEMENT, NO_SEPARATOR)
-    default:
-        Q_UNREACHABLE_RETURN(false);
-    }
+    QQmlComponent **component = componentForType(type);
     const QString &name = nameForComponent(type);
 #ifndef UI_DELEGATES_DEBUG
-    if (*component)
+    if (*component && (*component)->isReady())
         return true;
 #else // Unconditionally reload the components each time.
     fprintf(stderr, "%s: %s\n", Q_FUNC_INFO, qPrintable(fileName));
 #endif
+    // A component still being compiled by warmUp() is needed right now, so load it synchronously.
+    // This reuses whatever the type loader already compiled in the background.
     for (const QString &module : m_moduleList) {
         delete *component;
         *component = new QQmlComponent(engine);
@@ -154,6 +165,76 @@ bool UIDelegatesManager::ensureComponentLoaded(ComponentType type)
     return true;
 }
 
+// Set QTWEBENGINE_UI_DELEGATE_WARMUP to compile the delegate components in the background when
+// a WebEngineView is created, instead of synchronously the first time each one is needed, and
+// to reuse JavaScript dialogs once closed.
+bool UIDelegatesManager::isWarmUpEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QTWEBENGINE_UI_DELEGATE_WARMUP") > 0;
+    return enabled;
+}
+
+void UIDelegatesManager::warmUp()
+{
+    for (int type = 0; type < ComponentTypeCount; ++type)
+        warmUpComponent(static_cast<ComponentType>(type), 0);
+}
+
+void UIDelegatesManager::warmUpComponent(ComponentType type, qsizetype moduleIndex)
+{
+    QQmlEngine *engine = qmlEngine(m_view);
+    QQmlComponent **component = componentForType(type);
+    if (!engine || *component || moduleIndex >= m_moduleList.size())
+        return;
+
+    QQmlComponent *loading = new QQmlComponent(engine);
+    *component = loading;
+    QObject::connect(loading, &QQmlComponent::statusChanged, m_view,
+                     [this, type, moduleIndex, loading](QQmlComponent::Status status) {
+                         QQmlComponent **component = componentForType(type);
+                         if (*component != loading)
+                             return; // replaced by ensureComponentLoaded()
+                         if (status == QQmlComponent::Ready) {
+                             preparePooledDelegate(type, loading);
+                         } else if (status == QQmlComponent::Error) {
+                             *component = nullptr;
+                             loading->deleteLater();
+                             warmUpComponent(type, moduleIndex + 1);
+                         }
+                     });
+    loading->loadFromModule(m_moduleList.at(moduleIndex), nameForComponent(type),
+                            QQmlComponent::Asynchronous);
+}
+
+// Instantiates an idle delegate ahead of time, so showing the first one does not need to.
+void UIDelegatesManager::preparePooledDelegate(ComponentType type, QQmlComponent *component)
+{
+    PooledDelegate &pooled = m_pooledDelegates[type];
+    if (!isPooledComponentType(type) || pooled.object)
+        return;
+
+    QObject *delegate = component->beginCreate(qmlContext(m_view));
+    if (!delegate)
+        return;
+    if (QQuickItem *item = qobject_cast<QQuickItem *>(delegate))
+        item->setParentItem(m_view);
+    delegate->setParent(m_view);
+    component->completeCreate();
+    pooled.object = delegate;
+}
+
+// Returns the pooled delegate of the given type if it is not in use, after dropping the
+// connections made for its previous use.
+QObject *UIDelegatesManager::takePooledDelegate(ComponentType type)
+{
+    PooledDelegate &pooled = m_pooledDelegates[type];
+    if (!pooled.object || pooled.object->property("visible").toBool())
+        return nullptr;
+    for (const QMetaObject::Connection &connection : std::exchange(pooled.connections, {}))
+        QObject::disconnect(connection);
+    return pooled.object;
+}
+
 #define CHECK_QML_SIGNAL_PROPERTY(prop, location) \
     if (!prop.isSignalProperty()) \
         qWarning("%s is missing %s signal property.\n", qPrintable(location.toString()), qPrintable(prop.name()));
@@ -222,12 +303,22 @@ void UIDelegatesManager::showDialog(QSharedPointer<JavaScriptDialogController> d
         Q_UNREACHABLE();
     }
 
-    QQmlContext *context = qmlContext(m_view);
-    QObject *dialog = dialogComponent->beginCreate(context);
-    // set visual parent for non-Window-based dialogs
-    if (QQuickItem *item = qobject_cast<QQuickItem*>(dialog))
-        item->setParentItem(m_view);
-    dialog->setParent(m_view);
+    // Reuse the pooled dialog if it is idle, otherwise create a new one.
+    PooledDelegate &pooled = m_pooledDelegates[dialogComponentType];
+    QObject *dialog = takePooledDelegate(dialogComponentType);
+    const bool reused = dialog;
+    if (!dialog) {
+        QQmlContext *context = qmlContext(m_view);
+        dialog = dialogComponent->beginCreate(context);
+        // set visual parent for non-Window-based dialogs
+        if (QQuickItem *item = qobject_cast<QQuickItem*>(dialog))
+            item->setParentItem(m_view);
+        dialog->setParent(m_view);
+    } else {
+        QQmlProperty(dialog, QStringLiteral("handled")).write(false);
+    }
+    QList<QMetaObject::Connection> connections;
+
     QQmlProperty textProp(dialog, QStringLiteral("text"));
     if (dialogController->type() == WebContentsAdapterClient::UnloadDialog)
         textProp.write(tr("Changes that you made may not be saved."));
@@ -243,9 +334,9 @@ void UIDelegatesManager::showDialog(QSharedPointer<JavaScriptDialogController> d
     CHECK_QML_SIGNAL_PROPERTY(rejectSignal, dialogComponent->url());
 
     static int acceptIndex = dialogController->metaObject()->indexOfSlot("accept()");
-    QObject::connect(dialog, acceptSignal.method(), dialogController.data(), dialogController->metaObject()->method(acceptIndex));
+    connections.append(QObject::connect(dialog, acceptSignal.method(), dialogController.data(), dialogController->metaObject()->method(acceptIndex)));
     static int rejectIndex = dialogController->metaObject()->indexOfSlot("reject()");
-    QObject::connect(dialog, rejectSignal.method(), dialogController.data(), dialogController->metaObject()->method(rejectIndex));
+    connections.append(QObject::connect(dialog, rejectSignal.method(), dialogController.data(), dialogController->metaObject()->method(rejectIndex)));
 
     if (dialogComponentType == PromptDialog) {
         QQmlProperty promptProp(dialog, QStringLiteral("prompt"));
@@ -253,12 +344,23 @@ void UIDelegatesManager::showDialog(QSharedPointer<JavaScriptDialogController> d
         QQmlProperty inputSignal(dialog, QStringLiteral("onInput"));
         CHECK_QML_SIGNAL_PROPERTY(inputSignal, dialogComponent->url());
         static int setTextIndex = dialogController->metaObject()->indexOfSlot("textProvided(QString)");
-        QObject::connect(dialog, inputSignal.method(), dialogController.data(), dialogController->metaObject()->method(setTextIndex));
+        connections.append(QObject::connect(dialog, inputSignal.method(), dialogController.data(), dialogController->metaObject()->method(setTextIndex)));
     }
 
-    dialogComponent->completeCreate();
-
-    QObject::connect(dialogController.data(), &JavaScriptDialogController::dialogCloseRequested, dialog, &QObject::deleteLater);
+    if (!reused)
+        dialogComponent->completeCreate();
+
+    // Dialogs are only pooled when warm-up is enabled, otherwise each one is created anew.
+    if (!pooled.object && isWarmUpEnabled())
+        pooled.object = dialog;
+    if (pooled.object == dialog) {
+        // Pooled dialogs are only closed, to be shown again for the next request.
+        connections.append(QObject::connect(dialogController.data(), &JavaScriptDialogController::dialogCloseRequested,
+                                            dialog, [dialog]() { QMetaObject::invokeMethod(dialog, "close"); }));
+        pooled.connections = connections;
+    } else {
+        QObject::connect(dialogController.data(), &JavaScriptDialogController::dialogCloseRequested, dialog, &QObject::deleteLater);
+    }
 
     QMetaObject::invokeMethod(dialog, "open");
 }
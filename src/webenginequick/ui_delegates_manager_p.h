@@ -18,6 +18,7 @@
 #include <QtCore/qcoreapplication.h> // Q_DECLARE_TR_FUNCTIONS
 #include <QtCore/qobject.h>
 #include <QtCore/qpoint.h>
+#include <QtCore/qpointer.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qsharedpointer.h>
 #include <QtCore/qstring.h>
@@ -81,6 +82,9 @@ public:
     UIDelegatesManager(QQuickWebEngineView *);
     virtual ~UIDelegatesManager();
 
+    static bool isWarmUpEnabled();
+    void warmUp();
+
     virtual void addMenuItem(QQuickWebEngineAction *action, QObject *menu,
                              bool checkable = false, bool checked = true);
     void addMenuSeparator(QObject *menu);
@@ -102,13 +106,25 @@ public:
     void hideAutofillPopup();
 
 private:
+    // An idle delegate instance kept around to be reused, see takePooledDelegate().
+    struct PooledDelegate
+    {
+        QPointer<QObject> object;
+        QList<QMetaObject::Connection> connections;
+    };
+
+    QQmlComponent **componentForType(ComponentType);
     bool ensureComponentLoaded(ComponentType);
+    void warmUpComponent(ComponentType, qsizetype moduleIndex);
+    QObject *takePooledDelegate(ComponentType);
+    void preparePooledDelegate(ComponentType, QQmlComponent *);
 
     QQuickWebEngineView *m_view;
     QScopedPointer<QObject> m_toolTip;
     QScopedPointer<QObject> m_touchSelectionMenu;
     QScopedPointer<QObject> m_autofillPopup;
     QStringList m_moduleList;
+    PooledDelegate m_pooledDelegates[ComponentTypeCount];
 
     FOR_EACH_COMPONENT_TYPE(MEMBER_DECLARATION, SEMICOLON_SEPARATOR)
 
@@ -865,6 +865,8 @@ void QWebEngineViewPrivate::didPrintPage(QPrinter *&currentPrinter, QSharedPoint
     printerWorker->m_firstPageFirst = currentPrinter->pageOrder() == QPrinter::FirstPageFirst;
     printerWorker->m_documentCopies = currentPrinter->copyCount();
     printerWorker->m_collateCopies = currentPrinter->collateCopies();
+    if (currentPrinter->outputFormat() == QPrinter::PdfFormat)
+        printerWorker->m_pdfOutputFileName = currentPrinter->outputFileName();
 
     int oldCopyCount = currentPrinter->copyCount();
     currentPrinter->printEngine()->setProperty(QPrintEngine::PPK_CopyCount, 1);
@@ -1494,7 +1496,8 @@ void QWebEngineView::printToPdf(const std::function<void(const QByteArray&)> &re
 
     \note This function rasterizes the result when rendering onto \a printer. Please consider raising
     the default resolution of \a printer to at least 300 DPI, or using printToPdf() to produce
-    PDF file output more effectively.
+    PDF file output more effectively. If \a printer produces a PDF file with a single copy in
+    first-page-first order, the generated PDF document is written to it unchanged instead.
 
     \since 6.2
 */
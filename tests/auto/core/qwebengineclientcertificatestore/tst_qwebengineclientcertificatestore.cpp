@@ -26,6 +26,8 @@ private Q_SLOTS:
     void removeAndClearCertificates();
     void clientAuthentication_data();
     void clientAuthentication();
+    void selectionFollowsStoreChanges();
+    void selectionMatchesReencodedIssuer();
 };
 
 tst_QWebEngineClientCertificateStore::tst_QWebEngineClientCertificateStore()
@@ -169,5 +171,115 @@ void tst_QWebEngineClientCertificateStore::clientAuthentication()
     QVERIFY(server.stop());
 }
 
+void tst_QWebEngineClientCertificateStore::selectionFollowsStoreChanges()
+{
+    if (QTestPrivate::isSecureTransportBlockingTest())
+        QSKIP("SecureTransport will block the test server while accessing the login keychain");
+
+    HttpsServer server(":/resources/server.pem", ":/resources/server.key", ":resources/ca.pem");
+    server.setExpectError(false);
+    QVERIFY(server.start());
+    connect(&server, &HttpsServer::newRequest, [&](HttpReqRep *rr) {
+        rr->setResponseBody(QByteArrayLiteral("<html><body>TEST</body></html>"));
+        rr->sendResponse();
+    });
+
+    QFile certFile(":/resources/client.pem");
+    QVERIFY2(certFile.open(QIODevice::ReadOnly), qPrintable(certFile.errorString()));
+    const QSslCertificate cert(certFile.readAll(), QSsl::Pem);
+    QFile keyFile(":/resources/client.key");
+    QVERIFY2(keyFile.open(QIODevice::ReadOnly), qPrintable(keyFile.errorString()));
+    const QSslKey sslKey(keyFile.readAll(), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey, "");
+
+    // Changes made after the first certificates were added have to be seen by the next handshake.
+    QWebEngineClientCertificateStore *store = QWebEngineProfile::defaultProfile()->clientCertificateStore();
+    addAndListCertificates();
+    const QList<QSslCertificate> unrelated = store->certificates();
+    store->add(cert, sslKey);
+    for (const QSslCertificate &certificate : unrelated)
+        store->remove(certificate);
+    QCOMPARE(store->certificates().size(), 1);
+
+    QWebEnginePage page;
+    connect(&page, &QWebEnginePage::certificateError, [](QWebEngineCertificateError e) {
+        e.acceptCertificate();
+    });
+    QList<QSslCertificate> offered;
+    connect(&page, &QWebEnginePage::selectClientCertificate, &page,
+            [&](QWebEngineClientCertificateSelection selection) {
+                offered = selection.certificates();
+                if (offered.contains(cert))
+                    selection.select(cert);
+            });
+    QSignalSpy loadFinishedSpy(&page, SIGNAL(loadFinished(bool)));
+    page.settings()->setAttribute(QWebEngineSettings::ErrorPageEnabled, false);
+    page.setUrl(server.url());
+    QTRY_COMPARE_WITH_TIMEOUT(loadFinishedSpy.size() > 0, true, 20000);
+    QVERIFY(offered.contains(cert));
+    for (const QSslCertificate &certificate : unrelated)
+        QVERIFY(!offered.contains(certificate));
+    QCOMPARE(loadFinishedSpy.takeFirst().at(0).toBool(), true);
+    QVERIFY(server.stop());
+}
+
+void tst_QWebEngineClientCertificateStore::selectionMatchesReencodedIssuer()
+{
+    if (QTestPrivate::isSecureTransportBlockingTest())
+        QSKIP("SecureTransport will block the test server while accessing the login keychain");
+
+    HttpsServer server(":/resources/server.pem", ":/resources/server.key", ":resources/ca.pem");
+    server.setExpectError(false);
+    QVERIFY(server.start());
+    connect(&server, &HttpsServer::newRequest, [&](HttpReqRep *rr) {
+        rr->setResponseBody(QByteArrayLiteral("<html><body>TEST</body></html>"));
+        rr->sendResponse();
+    });
+
+    QFile certFile(":/resources/client.pem");
+    QVERIFY2(certFile.open(QIODevice::ReadOnly), qPrintable(certFile.errorString()));
+    const QSslCertificate cert(certFile.readAll(), QSsl::Pem);
+    QFile keyFile(":/resources/client.key");
+    QVERIFY2(keyFile.open(QIODevice::ReadOnly), qPrintable(keyFile.errorString()));
+    const QSslKey sslKey(keyFile.readAll(), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey, "");
+
+    // Issued by a CA with the same name as ca.pem, but encoded as PrintableStrings instead of
+    // UTF8Strings, so it only matches the requested authority once the names are normalized.
+    QFile reencodedCertFile(":/resources/client_reencoded.pem");
+    QVERIFY2(reencodedCertFile.open(QIODevice::ReadOnly),
+             qPrintable(reencodedCertFile.errorString()));
+    const QSslCertificate reencodedCert(reencodedCertFile.readAll(), QSsl::Pem);
+    QFile reencodedKeyFile(":/resources/privatekey.key");
+    QVERIFY2(reencodedKeyFile.open(QIODevice::ReadOnly),
+             qPrintable(reencodedKeyFile.errorString()));
+    const QSslKey reencodedKey(reencodedKeyFile.readAll(), QSsl::Rsa, QSsl::Pem,
+                               QSsl::PrivateKey, "");
+    QCOMPARE(reencodedCert.issuerDisplayName(), cert.issuerDisplayName());
+
+    QWebEngineClientCertificateStore *store = QWebEngineProfile::defaultProfile()->clientCertificateStore();
+    store->add(reencodedCert, reencodedKey);
+    store->add(cert, sslKey);
+
+    QWebEnginePage page;
+    connect(&page, &QWebEnginePage::certificateError, [](QWebEngineCertificateError e) {
+        e.acceptCertificate();
+    });
+    QList<QSslCertificate> offered;
+    connect(&page, &QWebEnginePage::selectClientCertificate, &page,
+            [&](QWebEngineClientCertificateSelection selection) {
+                offered = selection.certificates();
+                if (offered.contains(cert))
+                    selection.select(cert);
+            });
+    QSignalSpy loadFinishedSpy(&page, SIGNAL(loadFinished(bool)));
+    page.settings()->setAttribute(QWebEngineSettings::ErrorPageEnabled, false);
+    page.setUrl(server.url());
+    QTRY_COMPARE_WITH_TIMEOUT(loadFinishedSpy.size() > 0, true, 20000);
+    // The exact match of one certificate must not hide the other one.
+    QVERIFY(offered.contains(cert));
+    QVERIFY(offered.contains(reencodedCert));
+    QCOMPARE(loadFinishedSpy.takeFirst().at(0).toBool(), true);
+    QVERIFY(server.stop());
+}
+
 QTEST_MAIN(tst_QWebEngineClientCertificateStore)
 #include "tst_qwebengineclientcertificatestore.moc"
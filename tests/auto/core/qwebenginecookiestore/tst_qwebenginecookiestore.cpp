@@ -37,6 +37,7 @@ private Q_SLOTS:
     void setInvalidCookie();
     void cookieSignals();
     void batchCookieTasks();
+    void bulkCookieTasks();
     void basicFilter();
     void basicFilterOverHTTP();
     void html5featureFilter();
@@ -221,6 +222,77 @@ void tst_QWebEngineCookieStore::batchCookieTasks()
     QWE_TRY_COMPARE(cookieRemovedSpy.size(), 4);
 }
 
+void tst_QWebEngineCookieStore::bulkCookieTasks()
+{
+    QWebEnginePage page(m_profile);
+    QWebEngineCookieStore *client = m_profile->cookieStore();
+    client->setBatchedChangeNotificationsEnabled(true);
+
+    QSignalSpy loadSpy(&page, SIGNAL(loadFinished(bool)));
+    QSignalSpy cookieAddedSpy(client, SIGNAL(cookieAdded(QNetworkCookie)));
+    QSignalSpy cookiesChangedSpy(client, &QWebEngineCookieStore::cookiesChanged);
+
+    QList<QNetworkCookie> cookies;
+    for (int i = 0; i < 100; ++i) {
+        QNetworkCookie cookie(QByteArray("bulk") + QByteArray::number(i), "value");
+        cookie.setDomain(i % 2 ? QStringLiteral(".example.com") : QStringLiteral(".example.org"));
+        cookie.setPath(QStringLiteral("/"));
+        cookie.setExpirationDate(QDateTime::currentDateTime().addDays(i < 10 ? 1 : 30));
+        cookies.append(cookie);
+    }
+
+    // force to init storage as it's done lazily upon first navigation
+    client->loadAllCookies();
+    page.load(QUrl("about:blank"));
+    QWE_TRY_COMPARE(loadSpy.size(), 1);
+
+    client->setCookies(cookies);
+    qsizetype added = 0;
+    QWE_TRY_VERIFY([&]() {
+        for (const QList<QVariant> &args : std::as_const(cookiesChangedSpy))
+            added += args.at(0).value<QList<QNetworkCookie>>().size();
+        cookiesChangedSpy.clear();
+        return added == cookies.size();
+    }());
+    QCOMPARE(cookieAddedSpy.size(), 0);
+
+    QList<QNetworkCookie> result;
+    bool called = false;
+    client->loadCookies({ QStringLiteral("example.com"), QByteArray(), QDateTime() },
+                        [&](const QList<QNetworkCookie> &list) { result = list; called = true; });
+    QWE_TRY_VERIFY(called);
+    QCOMPARE(result.size(), 50);
+
+    called = false;
+    client->loadCookies({ QStringLiteral(".example.com"), QByteArray(), QDateTime() },
+                        [&](const QList<QNetworkCookie> &list) { result = list; called = true; });
+    QWE_TRY_VERIFY(called);
+    QCOMPARE(result.size(), 50);
+
+    called = false;
+    client->loadCookies({ QString(), QByteArray(), QDateTime::currentDateTime().addDays(2) },
+                        [&](const QList<QNetworkCookie> &list) { result = list; called = true; });
+    QWE_TRY_VERIFY(called);
+    QCOMPARE(result.size(), 10);
+
+    called = false;
+    client->loadCookies({ QStringLiteral("example.org"), QByteArrayLiteral("bulk42"), QDateTime() },
+                        [&](const QList<QNetworkCookie> &list) { result = list; called = true; });
+    QWE_TRY_VERIFY(called);
+    QCOMPARE(result.size(), 1);
+
+    client->deleteCookies(cookies.mid(0, 10));
+    qsizetype removed = 0;
+    QWE_TRY_VERIFY([&]() {
+        for (const QList<QVariant> &args : std::as_const(cookiesChangedSpy))
+            removed += args.at(1).value<QList<QNetworkCookie>>().size();
+        cookiesChangedSpy.clear();
+        return removed == 10;
+    }());
+
+    client->setBatchedChangeNotificationsEnabled(false);
+}
+
 void tst_QWebEngineCookieStore::basicFilter()
 {
     QWebEnginePage page(m_profile);
@@ -40,6 +40,7 @@ private Q_SLOTS:
     void size();
     void isMainFrame();
     void runJavaScript();
+    void runJavaScriptInFrames();
 #if QT_CONFIG(webengine_printing_and_pdf)
     void printRequestedByFrame();
     void printToPdfFile();
@@ -210,6 +211,51 @@ void tst_QWebEngineFrame::runJavaScript()
     QCOMPARE(result, QString("test-subframe0"));
 }
 
+void tst_QWebEngineFrame::runJavaScriptInFrames()
+{
+    QWebEnginePage page;
+    QSignalSpy loadSpy{ &page, SIGNAL(loadFinished(bool)) };
+    page.load(QUrl("qrc:/resources/iframes.html"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    using FrameResults = QList<QPair<QWebEngineFrame, QVariant>>;
+    CallbackSpy<FrameResults> spy;
+    page.runJavaScriptInFrames("window.name", 0, std::chrono::seconds(10), {}, spy.ref());
+    auto results = spy.waitForResult();
+    QCOMPARE(results.size(), 3);
+    QVERIFY(results[0].first.isMainFrame());
+    QCOMPARE(results[0].second, QString("test-main-frame"));
+    QCOMPARE(results[1].second, QString("test-subframe0"));
+    QCOMPARE(results[2].second, QString("test-subframe1"));
+
+    CallbackSpy<FrameResults> filteredSpy;
+    page.runJavaScriptInFrames(
+            "window.name", 0, std::chrono::seconds(10),
+            [](const QWebEngineFrame &frame) { return !frame.isMainFrame(); }, filteredSpy.ref());
+    results = filteredSpy.waitForResult();
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results[0].first, page.mainFrame().children()[0]);
+    QCOMPARE(results[1].second, QString("test-subframe1"));
+
+    // A frame that does not answer in time is reported with an invalid result.
+    CallbackSpy<FrameResults> timeoutSpy;
+    page.runJavaScriptInFrames("const end = Date.now() + 2000; while (Date.now() < end) {}", 0,
+                               std::chrono::milliseconds(100), {}, timeoutSpy.ref());
+    results = timeoutSpy.waitForResult();
+    QVERIFY(timeoutSpy.wasCalled());
+    QCOMPARE(results.size(), 3);
+    QVERIFY(!results[0].second.isValid());
+
+    // Without a timeout, frames that go away before answering still complete the batch.
+    CallbackSpy<FrameResults> navigationSpy;
+    page.runJavaScriptInFrames("window.name", 0, std::chrono::milliseconds::zero(), {},
+                               navigationSpy.ref());
+    page.setHtml("<p>replaced</p>");
+    results = navigationSpy.waitForResult();
+    QVERIFY(navigationSpy.wasCalled());
+    QCOMPARE(results.size(), 3);
+}
+
 #if QT_CONFIG(webengine_printing_and_pdf)
 void tst_QWebEngineFrame::printRequestedByFrame()
 {
@@ -0,0 +1,130 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtCore/qsharedmemory.h>
+#include <QtGui/qimage.h>
+#include <QtWebEngineCore/qwebengineheadlessrenderer.h>
+#include <QtWebEngineCore/qwebenginepage.h>
+
+class tst_QWebEngineHeadlessRenderer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void frames();
+    void requestFrame();
+#if QT_CONFIG(sharedmemory)
+    void sharedMemoryRing();
+#endif
+};
+
+static const char kRedPage[] = "<html><body style='margin:0; background: rgb(255, 0, 0)'>"
+                               "<div id='box' style='width: 10px; height: 10px'></div>"
+                               "</body></html>";
+
+// Frames are only delivered with software compositing.
+#define WAIT_FOR_FIRST_FRAME(renderer)                                                          \
+    if (!QTest::qWaitFor([&]() { return renderer.frameCount() > 0; }, 10000))                 \
+        QSKIP("No frames delivered, software compositing is not in use.");
+
+void tst_QWebEngineHeadlessRenderer::frames()
+{
+    QWebEnginePage page;
+    QWebEngineHeadlessRenderer renderer(&page);
+    QCOMPARE(renderer.page(), &page);
+    renderer.setSize(QSize(200, 100));
+    QCOMPARE(renderer.size(), QSize(200, 100));
+
+    QImage lastFrame;
+    QRect lastDamage;
+    renderer.setFrameCallback([&](const QImage &frame, const QRect &damageRect) {
+        lastFrame = frame;
+        lastDamage = damageRect;
+    });
+
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(kRedPage);
+    QTRY_COMPARE(loadSpy.size(), 1);
+    WAIT_FOR_FIRST_FRAME(renderer);
+
+    QTRY_VERIFY(!lastFrame.isNull() && lastFrame.pixelColor(5, 5) == QColor(255, 0, 0));
+    QCOMPARE(lastFrame.width(), lastFrame.height() * 2);
+
+    // Changing a small part of the page only reports that part as damaged.
+    lastDamage = QRect();
+    page.runJavaScript("document.getElementById('box').style.background = 'blue'");
+    QTRY_COMPARE(lastFrame.pixelColor(5, 5), QColor(0, 0, 255));
+    QVERIFY(lastDamage.isValid());
+    QVERIFY(lastDamage.width() < lastFrame.width());
+}
+
+void tst_QWebEngineHeadlessRenderer::requestFrame()
+{
+    QWebEnginePage page;
+    QWebEngineHeadlessRenderer renderer(&page);
+    renderer.setSize(QSize(100, 100));
+
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(kRedPage);
+    QTRY_COMPARE(loadSpy.size(), 1);
+    WAIT_FOR_FIRST_FRAME(renderer);
+
+    QSignalSpy frameRateSpy(&renderer, &QWebEngineHeadlessRenderer::frameRateChanged);
+    renderer.setFrameRate(0);
+    QCOMPARE(frameRateSpy.size(), 1);
+    QTest::qWait(200);
+
+    // Without a frame rate, changes are only rendered when asked for.
+    const quint64 frameCount = renderer.frameCount();
+    page.runJavaScript("document.getElementById('box').style.background = 'blue'");
+    QTest::qWait(500);
+    QCOMPARE(renderer.frameCount(), frameCount);
+
+    QVERIFY(QTest::qWaitFor([&]() {
+        renderer.requestFrame();
+        return renderer.frameCount() > frameCount;
+    }));
+}
+
+#if QT_CONFIG(sharedmemory)
+void tst_QWebEngineHeadlessRenderer::sharedMemoryRing()
+{
+    QWebEnginePage page;
+    QWebEngineHeadlessRenderer renderer(&page);
+    renderer.setSize(QSize(64, 64));
+
+    const QString key = QStringLiteral("tst_qwebengineheadlessrenderer_%1")
+                                .arg(QCoreApplication::applicationPid());
+    if (!renderer.setSharedMemoryRing(key, 3, QSize(256, 256)))
+        QSKIP("Shared memory is not available.");
+
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(kRedPage);
+    QTRY_COMPARE(loadSpy.size(), 1);
+    WAIT_FOR_FIRST_FRAME(renderer);
+
+    QSharedMemory reader(QSharedMemory::platformSafeKey(key));
+    QVERIFY(reader.attach(QSharedMemory::ReadOnly));
+    QVERIFY(reader.lock());
+    const auto *data = static_cast<const uchar *>(reader.constData());
+    const auto *header =
+            reinterpret_cast<const QWebEngineHeadlessRenderer::SharedMemoryHeader *>(data);
+    QCOMPARE(header->magic, 0x51574852u);
+    QCOMPARE(header->slotCount, 3u);
+    QVERIFY(header->frameCount > 0);
+    const uchar *slot = data + sizeof(*header)
+            + ((header->frameCount - 1) % header->slotCount) * header->slotSize;
+    const auto *frame =
+            reinterpret_cast<const QWebEngineHeadlessRenderer::SharedMemoryFrame *>(slot);
+    QCOMPARE(frame->frameNumber, header->frameCount);
+    QVERIFY(frame->width >= 64 && frame->height >= 64);
+    const QImage image(slot + sizeof(*frame), frame->width, frame->height, frame->bytesPerLine,
+                       QImage::Format(frame->format));
+    QCOMPARE(image.pixelColor(20, 20).red(), 255);
+    reader.unlock();
+}
+#endif
+
+QTEST_MAIN(tst_QWebEngineHeadlessRenderer)
+#include "tst_qwebengineheadlessrenderer.moc"
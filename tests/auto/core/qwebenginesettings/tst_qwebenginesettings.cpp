@@ -35,6 +35,7 @@ class tst_QWebEngineSettings: public QObject {
 
 private Q_SLOTS:
     void resetAttributes();
+    void inheritFromProfile();
     void defaultFontFamily_data();
     void defaultFontFamily();
     void javascriptClipboard_data();
@@ -77,6 +78,46 @@ void tst_QWebEngineSettings::resetAttributes()
     QCOMPARE(defaultSize, settings->fontSize(QWebEngineSettings::MinimumFontSize));
 }
 
+void tst_QWebEngineSettings::inheritFromProfile()
+{
+    QWebEngineProfile profile;
+    QWebEnginePage page1(&profile);
+    QWebEnginePage page2(&profile);
+    QWebEngineSettings *profileSettings = profile.settings();
+
+    QSignalSpy loadFinishedSpy1(&page1, &QWebEnginePage::loadFinished);
+    QSignalSpy loadFinishedSpy2(&page2, &QWebEnginePage::loadFinished);
+    page1.setHtml("<html><body>Hello</body></html>");
+    page2.setHtml("<html><body>Hello</body></html>");
+    QTRY_COMPARE(loadFinishedSpy1.size(), 1);
+    QTRY_COMPARE(loadFinishedSpy2.size(), 1);
+
+    const QString fontSize("getComputedStyle(document.body).fontSize");
+    QCOMPARE(evaluateJavaScriptSync(&page1, fontSize).toString(), QStringLiteral("16px"));
+    QCOMPARE(evaluateJavaScriptSync(&page2, fontSize).toString(), QStringLiteral("16px"));
+
+    // A page overriding a setting keeps its value when the profile changes it.
+    page2.settings()->setFontSize(QWebEngineSettings::DefaultFontSize, 20);
+    profileSettings->setFontSize(QWebEngineSettings::DefaultFontSize, 24);
+    QCOMPARE(page1.settings()->fontSize(QWebEngineSettings::DefaultFontSize), 24);
+    QCOMPARE(page2.settings()->fontSize(QWebEngineSettings::DefaultFontSize), 20);
+    QTRY_COMPARE(evaluateJavaScriptSync(&page1, fontSize).toString(), QStringLiteral("24px"));
+    QTRY_COMPARE(evaluateJavaScriptSync(&page2, fontSize).toString(), QStringLiteral("20px"));
+
+    // Other values are still inherited.
+    profileSettings->setAttribute(QWebEngineSettings::JavascriptCanAccessClipboard, true);
+    QVERIFY(page1.settings()->testAttribute(QWebEngineSettings::JavascriptCanAccessClipboard));
+    QVERIFY(page2.settings()->testAttribute(QWebEngineSettings::JavascriptCanAccessClipboard));
+
+    page2.settings()->resetFontSize(QWebEngineSettings::DefaultFontSize);
+    QCOMPARE(page2.settings()->fontSize(QWebEngineSettings::DefaultFontSize), 24);
+    QTRY_COMPARE(evaluateJavaScriptSync(&page2, fontSize).toString(), QStringLiteral("24px"));
+
+    profileSettings->resetFontSize(QWebEngineSettings::DefaultFontSize);
+    QTRY_COMPARE(evaluateJavaScriptSync(&page1, fontSize).toString(), QStringLiteral("16px"));
+    QTRY_COMPARE(evaluateJavaScriptSync(&page2, fontSize).toString(), QStringLiteral("16px"));
+}
+
 void tst_QWebEngineSettings::defaultFontFamily_data()
 {
     QTest::addColumn<int>("fontFamily");
@@ -868,6 +868,7 @@ static const QStringList expectedAPI = QStringList()
     << "QQuickWebEngineView.NewViewInWindow --> NewViewDestination"
     << "QQuickWebEngineView.permissionRequested(QWebEnginePermission) --> void"
     << "QQuickWebEngineView.pdfPrintingFinished(QString,bool) --> void"
+    << "QQuickWebEngineView.pdfPrintingProgress(QString,qlonglong,qlonglong) --> void"
     << "QQuickWebEngineView.printRequested() --> void"
     << "QQuickWebEngineView.printRequestedByFrame(QWebEngineFrame) --> void"
     << "QQuickWebEngineView.printToPdf(QJSValue) --> void"
@@ -5,6 +5,7 @@
 #include "quickutil.h"
 #include "visualutil.h"
 
+#include <QPointer>
 #include <QScopedPointer>
 #include <QtQml/QQmlEngine>
 #include <QtTest/QtTest>
@@ -27,6 +28,7 @@ private Q_SLOTS:
     void cleanup();
     void javaScriptDialog();
     void javaScriptDialog_data();
+    void pooledJavaScriptDialog();
     void fileDialog();
     void contextMenu();
     void tooltip();
@@ -44,6 +46,8 @@ private:
 
 void tst_UIDelegates::initMain()
 {
+    // Dialogs are only pooled with warm-up, which is read once when the first view is created.
+    qputenv("QTWEBENGINE_UI_DELEGATE_WARMUP", "1");
     QtWebEngineQuick::initialize();
 }
 
@@ -127,6 +131,36 @@ void tst_UIDelegates::javaScriptDialog()
     QTRY_VERIFY(view->findChild<QObject *>(expectedObjectName));
 }
 
+void tst_UIDelegates::pooledJavaScriptDialog()
+{
+    SKIP_IF_NO_WINDOW_ACTIVATION();
+
+    m_window->show();
+    m_window->requestActivate();
+    QVERIFY(QTest::qWaitForWindowActive(m_window.get()));
+    QQuickWebEngineView *view = webEngineView();
+
+    view->loadHtml("<html><body>"
+                   "</body></html>");
+    QVERIFY(waitForLoadSucceeded(view));
+
+    runJavaScript("alert('first');");
+    QPointer<QObject> dialog;
+    QTRY_VERIFY((dialog = view->findChild<QObject *>("alertDialog")));
+    QTRY_VERIFY(dialog->property("visible").toBool());
+    QMetaObject::invokeMethod(dialog, "accept");
+    QTRY_VERIFY(!dialog->property("visible").toBool());
+
+    // The closed dialog is shown again for the next alert.
+    runJavaScript("alert('second');");
+    QTRY_VERIFY(dialog && dialog->property("visible").toBool());
+    QCOMPARE(view->findChild<QObject *>("alertDialog"), dialog.get());
+    QCOMPARE(dialog->property("text").toString(), QString("second"));
+    QCOMPARE(view->findChildren<QObject *>("alertDialog").size(), 1);
+    QMetaObject::invokeMethod(dialog, "accept");
+    QTRY_VERIFY(!dialog->property("visible").toBool());
+}
+
 void tst_UIDelegates::fileDialog()
 {
     SKIP_IF_NO_WINDOW_ACTIVATION();
@@ -23,6 +23,10 @@
 
 #include <QHBoxLayout>
 #include <QMainWindow>
+#include <QScopeGuard>
+
+#include <algorithm>
+#include <utility>
 
 #include <qaccessible.h>
 #include <qwebengineview.h>
@@ -53,6 +57,7 @@ private Q_SLOTS:
     void crossTreeParent();
     void tableCellInterface();
     void tableInterface();
+    void textEventsCoalesced();
 };
 
 // This will be called before the first test function is executed.
@@ -799,6 +804,64 @@ void tst_Accessibility::tableInterface()
     QCOMPARE(tableInterface->cellAt(1, 1)->child(0)->text(QAccessible::Name), QLatin1String("Cell"));
 }
 
+static QAccessible::UpdateHandler s_previousUpdateHandler = nullptr;
+static QList<std::pair<QAccessible::Event, QString>> s_recordedEvents;
+
+static void recordingUpdateHandler(QAccessibleEvent *event)
+{
+    QAccessibleInterface *iface = event->accessibleInterface();
+    s_recordedEvents.append({ event->type(), iface ? iface->text(QAccessible::Name) : QString() });
+    if (s_previousUpdateHandler)
+        s_previousUpdateHandler(event);
+}
+
+void tst_Accessibility::textEventsCoalesced()
+{
+    QWebEngineView webView;
+    webView.resize(400, 400);
+    webView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&webView));
+
+    QSignalSpy spyFinished(&webView, &QWebEngineView::loadFinished);
+    webView.setHtml(QLatin1String(
+            "<html><body>"
+            "<input id='field' type='text' aria-label='field'>"
+            "<input id='sentinel' type='range' aria-label='sentinel'>"
+            "</body></html>"));
+    QTRY_COMPARE(spyFinished.size(), 1);
+
+    QAccessibleInterface *view = QAccessible::queryAccessibleInterface(&webView);
+    QTRY_COMPARE(view->child(0)->childCount(), 1);
+
+    s_recordedEvents.clear();
+    s_previousUpdateHandler = QAccessible::installUpdateHandler(recordingUpdateHandler);
+    auto restoreHandler = qScopeGuard([] {
+        QAccessible::installUpdateHandler(s_previousUpdateHandler);
+        s_previousUpdateHandler = nullptr;
+    });
+
+    // All the changes are part of the same tree update. Replacing the value of a text
+    // field is reported by Blink as a text change and by the event generator as a value
+    // change in a text field, each of which is a text update for Qt.
+    webView.page()->runJavaScript(QStringLiteral(
+            "var field = document.getElementById('field');"
+            "field.value = 'first';"
+            "field.value = 'second';"
+            "field.setSelectionRange(1, 3);"
+            "field.value = 'third';"));
+    const auto textUpdates = [] {
+        return std::count(s_recordedEvents.cbegin(), s_recordedEvents.cend(),
+                          std::make_pair(QAccessible::TextUpdated, QStringLiteral("field")));
+    };
+    QTRY_VERIFY(textUpdates() > 0);
+
+    // The update of the sentinel comes after any left-over event of the first update.
+    webView.page()->runJavaScript(QStringLiteral("document.getElementById('sentinel').value = 20;"));
+    QTRY_VERIFY(s_recordedEvents.contains(
+            std::make_pair(QAccessible::ValueChanged, QStringLiteral("sentinel"))));
+    QCOMPARE(textUpdates(), 1);
+}
+
 static QByteArrayList params = QByteArrayList()
     << "--force-renderer-accessibility"
     << "--enable-features=AccessibilityExposeARIAAnnotations"
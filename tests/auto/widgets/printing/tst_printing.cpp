@@ -4,6 +4,8 @@
 #include <QtWebEngineCore/qtwebenginecore-config.h>
 #include <QWebEngineSettings>
 #include <QWebEngineView>
+#include <QPrinter>
+#include <QFileInfo>
 #include <QTemporaryDir>
 #include <QTest>
 #include <QSignalSpy>
@@ -20,6 +22,7 @@ class tst_Printing : public QObject
     Q_OBJECT
 private slots:
     void printToPdfBasic();
+    void printToPdfPrinter();
     void printRequest();
     void pdfContent();
     void printFromPdfViewer();
@@ -38,10 +41,14 @@ void tst_Printing::printToPdfBasic()
     QTRY_VERIFY(spy.size() == 1);
 
     QSignalSpy savePdfSpy(view.page(), &QWebEnginePage::pdfPrintingFinished);
+    QSignalSpy progressSpy(view.page(), &QWebEnginePage::pdfPrintingProgress);
     QPageLayout layout(QPageSize(QPageSize::A4), QPageLayout::Portrait, QMarginsF(0.0, 0.0, 0.0, 0.0));
     QString path = tempDir.path() + "/print_1_success.pdf";
     view.page()->printToPdf(path, layout);
     QTRY_VERIFY2(savePdfSpy.size() == 1, "Printing to PDF file failed without signal");
+    QVERIFY(progressSpy.size() > 0);
+    QCOMPARE(progressSpy.last().at(1).toLongLong(), progressSpy.last().at(2).toLongLong());
+    QCOMPARE(progressSpy.last().at(2).toLongLong(), QFileInfo(path).size());
 
     QList<QVariant> successArguments = savePdfSpy.takeFirst();
     QVERIFY2(successArguments.at(0).toString() == path, "File path for first saved PDF does not match arguments");
@@ -68,6 +75,41 @@ void tst_Printing::printToPdfBasic()
     QCOMPARE(failedInvalidLayoutSpy.waitForResult().size(), 0);
 }
 
+void tst_Printing::printToPdfPrinter()
+{
+    QTemporaryDir tempDir(QDir::tempPath() + "/tst_qwebengineview-XXXXXX");
+    QVERIFY(tempDir.isValid());
+    QWebEngineView view;
+    QSignalSpy spy(&view, &QWebEngineView::loadFinished);
+    view.load(QUrl("qrc:///resources/basic_printing_page.html"));
+    QTRY_VERIFY(spy.size() == 1);
+
+    QPrinter printer(QPrinter::HighResolution);
+    printer.setOutputFormat(QPrinter::PdfFormat);
+    const QString path = tempDir.path() + "/printer_output.pdf";
+    printer.setOutputFileName(path);
+
+    QSignalSpy printFinishedSpy(&view, &QWebEngineView::printFinished);
+    view.print(&printer);
+    QTRY_COMPARE(printFinishedSpy.size(), 1);
+    QVERIFY(printFinishedSpy.takeFirst().at(0).toBool());
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+    QVERIFY(data.startsWith("%PDF"));
+
+#if defined(QTPDF_SUPPORT)
+    // The text is only searchable if the document was not rasterized.
+    QPdfDocument document;
+    QCOMPARE(document.load(path), QPdfDocument::Error::None);
+    QPdfSearchModel searchModel;
+    searchModel.setDocument(&document);
+    searchModel.setSearchString("Hello Paper World");
+    QTRY_COMPARE(searchModel.count(), 1);
+#endif
+}
+
 void tst_Printing::printRequest()
 {
      QWebEngineView view;
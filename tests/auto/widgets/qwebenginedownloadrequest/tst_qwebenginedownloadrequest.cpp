@@ -94,6 +94,7 @@ private Q_SLOTS:
     void downloadDataUrls_data();
     void downloadDataUrls();
     void pauseDownload();
+    void downloadProgressInterval();
 
 private:
     void saveLink(QPoint linkPos);
@@ -1441,5 +1442,47 @@ void tst_QWebEngineDownloadRequest::pauseDownload()
     QTRY_COMPARE(m_finishedDownloads.values()[0]->receivedBytes(), fileSize);
 }
 
+void tst_QWebEngineDownloadRequest::downloadProgressInterval()
+{
+    const int fileSize = 1024 * 1024 * 64;
+
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestMethod() == "GET" && rr->requestPath() == "/") {
+            rr->setResponseHeader(QByteArrayLiteral("content-type"),
+                                  QByteArrayLiteral("application/octet-stream"));
+            static const QByteArray bigfile(fileSize, '0');
+            rr->setResponseBody(bigfile);
+            rr->sendResponse();
+        }
+    });
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    QCOMPARE(m_profile->downloadProgressInterval(), std::chrono::milliseconds(0));
+    // Progress is held back for longer than the download takes, while the final state is not.
+    m_profile->setDownloadProgressInterval(std::chrono::minutes(1));
+    QCOMPARE(m_profile->downloadProgressInterval(), std::chrono::minutes(1));
+
+    int receivedBytesChanges = 0;
+    ScopedConnection sc2 = connect(
+            m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+                connect(item, &QWebEngineDownloadRequest::receivedBytesChanged,
+                        [&receivedBytesChanges] { receivedBytesChanges++; });
+                item->accept();
+            });
+
+    QSignalSpy loadSpy(m_page, &QWebEnginePage::loadFinished);
+    m_view->load(m_server->url());
+    QTRY_COMPARE_WITH_TIMEOUT(loadSpy.size(), 1, 10000);
+    QTRY_COMPARE_WITH_TIMEOUT(m_finishedDownloads.size(), 1, 10000);
+    QCOMPARE(m_finishedDownloads.values()[0]->state(), QWebEngineDownloadRequest::DownloadCompleted);
+    QCOMPARE(m_finishedDownloads.values()[0]->receivedBytes(), fileSize);
+    QVERIFY(receivedBytesChanges <= 2);
+
+    m_profile->setDownloadProgressInterval(std::chrono::milliseconds(0));
+}
+
 QTEST_MAIN(tst_QWebEngineDownloadRequest)
 #include "tst_qwebenginedownloadrequest.moc"
@@ -24,6 +24,7 @@
 #include "qwebenginepage.h"
 #include "qwebengineview.h"
 #include "qwebenginehistory.h"
+#include "qwebengineprofile.h"
 #include "qdebug.h"
 
 class tst_QWebEngineHistory : public QObject
@@ -68,6 +69,9 @@ private Q_SLOTS:
     void saveAndRestore_crash_3();
     void saveAndRestore_crash_4();
     void saveAndRestore_InternalPage();
+    void saveAndRestoreSession();
+    void saveAndRestore_legacyVersion();
+    void restoreCorruptStream();
 
     void popPushState_data();
     void popPushState();
@@ -452,6 +456,100 @@ void tst_QWebEngineHistory::saveAndRestore_InternalPage()
     stream2 >> *view.history();
 }
 
+void tst_QWebEngineHistory::saveAndRestoreSession()
+{
+    QWebEngineProfile profile;
+    QWebEnginePage page1(&profile);
+    QWebEnginePage page2(&profile);
+    QSignalSpy loadFinishedSpy1(&page1, &QWebEnginePage::loadFinished);
+    QSignalSpy loadFinishedSpy2(&page2, &QWebEnginePage::loadFinished);
+    page1.load(QUrl("qrc:/resources/page1.html"));
+    QTRY_COMPARE(loadFinishedSpy1.size(), 1);
+    page1.load(QUrl("qrc:/resources/page2.html"));
+    QTRY_COMPARE(loadFinishedSpy1.size(), 2);
+    page2.load(QUrl("qrc:/resources/page3.html"));
+    QTRY_COMPARE(loadFinishedSpy2.size(), 1);
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath("session");
+    QVERIFY(profile.saveSession(fileName));
+
+    const QList<QWebEnginePage *> pages = profile.restoreSession(fileName, this);
+    QCOMPARE(pages.size(), 2);
+
+    // Restored pages are not loaded before they are used, but know their current entry.
+    QSignalSpy restoredLoadSpy(pages[0], &QWebEnginePage::loadFinished);
+    QCOMPARE(pages[0]->url(), QUrl("qrc:/resources/page2.html"));
+    QCOMPARE(pages[0]->title(), QString("page2"));
+    QCOMPARE(pages[1]->url(), QUrl("qrc:/resources/page3.html"));
+
+    // Saving again does not need to load them either.
+    QVERIFY(profile.saveSession(fileName));
+    QCOMPARE(restoredLoadSpy.size(), 0);
+
+    // Reading the history does not load the page either.
+    QCOMPARE(pages[0]->history()->count(), 2);
+    QCOMPARE(pages[0]->history()->currentItemIndex(), 1);
+    QCOMPARE(pages[0]->history()->itemAt(0).url(), QUrl("qrc:/resources/page1.html"));
+    QCOMPARE(pages[0]->history()->currentItem().title(), QString("page2"));
+    QVERIFY(pages[0]->history()->canGoBack());
+    QTest::qWait(100);
+    QCOMPARE(restoredLoadSpy.size(), 0);
+
+    pages[0]->history()->back();
+    QTRY_COMPARE(pages[0]->url(), QUrl("qrc:/resources/page1.html"));
+
+    qDeleteAll(pages);
+}
+
+void tst_QWebEngineHistory::saveAndRestore_legacyVersion()
+{
+    QByteArray buffer;
+    QDataStream save(&buffer, QIODevice::WriteOnly);
+    save.setVersion(QDataStream::Qt_6_9);
+    save << *hist;
+    QVERIFY(save.status() == QDataStream::Ok);
+
+    // Earlier Qt versions only know version 4 of the format.
+    QDataStream load(buffer);
+    load.setVersion(QDataStream::Qt_6_9);
+    int version;
+    load >> version;
+    QCOMPARE(version, 4);
+
+    QWebEnginePage restored;
+    QSignalSpy loadSpy(&restored, &QWebEnginePage::loadFinished);
+    QDataStream restore(buffer);
+    restore.setVersion(QDataStream::Qt_6_9);
+    restore >> *restored.history();
+    QVERIFY(restore.status() == QDataStream::Ok);
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QCOMPARE(restored.history()->count(), histsize);
+    QCOMPARE(restored.history()->currentItem().url(), hist->currentItem().url());
+}
+
+void tst_QWebEngineHistory::restoreCorruptStream()
+{
+    QByteArray buffer;
+    QDataStream save(&buffer, QIODevice::WriteOnly);
+    save << *hist;
+    // Damage the compressed entries at the end of the stream.
+    buffer.chop(16);
+    buffer.append(QByteArray(16, 'x'));
+
+    QWebEnginePage restored;
+    restored.load(QUrl("qrc:/resources/page1.html"));
+    QSignalSpy loadSpy(&restored, &QWebEnginePage::loadFinished);
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    QDataStream load(buffer);
+    load >> *restored.history();
+    QCOMPARE(load.status(), QDataStream::ReadCorruptData);
+    QCOMPARE(restored.url(), QUrl("qrc:/resources/page1.html"));
+    QCOMPARE(restored.history()->count(), 1);
+}
+
 void tst_QWebEngineHistory::popPushState_data()
 {
     QTest::addColumn<QString>("script");
@@ -162,6 +162,8 @@ private Q_SLOTS:
     void findTextSuccessiveShouldCallAllCallbacks();
     void findTextCalledOnMatch();
     void findTextActiveMatchOrdinal();
+    void findTextRefinement();
+    void findTextMatchRects();
     void deleteQWebEngineViewTwice();
 #if defined(QT_STATEMACHINE_LIB)
     void loadSignalsOrder_data();
@@ -212,6 +214,7 @@ private Q_SLOTS:
     void loadInSignalHandlers_data();
     void loadInSignalHandlers();
     void loadFromQrc();
+    void qrcValidatorsAndRanges();
 #if QT_CONFIG(webengine_webchannel)
     void restoreHistory();
 #endif
@@ -1381,6 +1384,96 @@ void tst_QWebEnginePage::findTextActiveMatchOrdinal()
     QCOMPARE(result.activeMatch(), 0);
 }
 
+void tst_QWebEnginePage::findTextRefinement()
+{
+    QSignalSpy loadSpy(m_view->page(), &QWebEnginePage::loadFinished);
+    QSignalSpy findTextSpy(m_view->page(), &QWebEnginePage::findTextFinished);
+
+    // findText will abort in blink if the view has an empty size.
+    m_view->resize(800, 600);
+    m_view->show();
+    m_view->setHtml(QString("<html><head></head><body><div>foo bar foo</div></body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    CallbackSpy<QWebEngineFindTextResult> missSpy;
+    m_view->page()->findText("baz", {}, missSpy.ref());
+    QCOMPARE(missSpy.waitForResult().numberOfMatches(), 0);
+    QTRY_COMPARE(findTextSpy.size(), 1);
+    findTextSpy.clear();
+
+    // Extending a search without matches is answered right away.
+    bool called = false;
+    m_view->page()->findText("BAZZ", {}, [&called](const QWebEngineFindTextResult &result) {
+        QCOMPARE(result.numberOfMatches(), 0);
+        called = true;
+    });
+    QVERIFY(called);
+    QCOMPARE(findTextSpy.size(), 1);
+    findTextSpy.clear();
+
+    // Other searches still reach the page.
+    CallbackSpy<QWebEngineFindTextResult> hitSpy;
+    m_view->page()->findText("foo", {}, hitSpy.ref());
+    QCOMPARE(hitSpy.waitForResult().numberOfMatches(), 2);
+    QTRY_COMPARE(findTextSpy.size(), 1);
+    findTextSpy.clear();
+
+    // Repeating a search without matches sees changes of the document.
+    CallbackSpy<QWebEngineFindTextResult> missSpy2;
+    m_view->page()->findText("baz", {}, missSpy2.ref());
+    QCOMPARE(missSpy2.waitForResult().numberOfMatches(), 0);
+    evaluateJavaScriptSync(m_view->page(),
+                           "document.querySelector('div').textContent += ' bazz';");
+    CallbackSpy<QWebEngineFindTextResult> repeatSpy;
+    m_view->page()->findText("baz", {}, repeatSpy.ref());
+    QCOMPARE(repeatSpy.waitForResult().numberOfMatches(), 1);
+    CallbackSpy<QWebEngineFindTextResult> refineSpy;
+    m_view->page()->findText("bazz", {}, refineSpy.ref());
+    QCOMPARE(refineSpy.waitForResult().numberOfMatches(), 1);
+}
+
+void tst_QWebEnginePage::findTextMatchRects()
+{
+    QSignalSpy loadSpy(m_view->page(), &QWebEnginePage::loadFinished);
+
+    m_view->resize(800, 600);
+    m_view->show();
+    m_view->setHtml(QString("<html><body style='margin:0'>"
+                            "<div>foo bar</div><div style='margin-top:2000px'>Foo</div>"
+                            "<iframe srcdoc='<p>foobar</p>'></iframe></body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QTRY_COMPARE(m_view->page()->mainFrame().children().size(), 1);
+
+    QList<QPair<QWebEngineFrame, QList<QRectF>>> results;
+    bool called = false;
+    auto callback = [&](const QList<QPair<QWebEngineFrame, QList<QRectF>>> &frameRects) {
+        results = frameRects;
+        called = true;
+    };
+
+    m_view->page()->findTextMatchRects("fo", {}, callback);
+    QTRY_VERIFY(called);
+    QCOMPARE(results.size(), 2);
+    QVERIFY(results[0].first.isMainFrame());
+    QCOMPARE(results[0].second.size(), 2);
+    QVERIFY(results[0].second[1].top() > 2000);
+    QCOMPARE(results[1].second.size(), 1);
+
+    // Refining the search only keeps the remaining matches.
+    called = false;
+    m_view->page()->findTextMatchRects("foo", QWebEnginePage::FindCaseSensitively, callback);
+    QTRY_VERIFY(called);
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results[0].second.size(), 1);
+    QVERIFY(results[0].second[0].top() < 100);
+
+    called = false;
+    m_view->page()->findTextMatchRects("foob", QWebEnginePage::FindCaseSensitively, callback);
+    QTRY_VERIFY(called);
+    QCOMPARE(results[0].second.size(), 0);
+    QCOMPARE(results[1].second.size(), 1);
+}
+
 static QWindow *findNewTopLevelWindow(const QWindowList &oldTopLevelWindows)
 {
     const auto tlws = QGuiApplication::topLevelWindows();
@@ -3093,6 +3186,28 @@ void tst_QWebEnginePage::loadFromQrc()
     QCOMPARE(spy.takeFirst().value(0).toBool(), false);
 }
 
+void tst_QWebEnginePage::qrcValidatorsAndRanges()
+{
+    QWebEnginePage page;
+    QSignalSpy spy(&page, &QWebEnginePage::loadFinished);
+    page.load(QStringLiteral("qrc:///resources/index.html"));
+    QTRY_COMPARE(spy.size(), 1);
+    QCOMPARE(spy.takeFirst().value(0).toBool(), true);
+
+    evaluateJavaScriptSync(&page, QStringLiteral(
+            "(async () => {"
+            "  const full = await fetch('foo.txt');"
+            "  const etag = full.headers.get('ETag');"
+            "  const again = await fetch('foo.txt', { headers: { 'If-None-Match': etag } });"
+            "  const range = await fetch('bar.txt', { headers: { 'Range': 'bytes=1-2' } });"
+            "  const outOfRange = await fetch('bar.txt', { headers: { 'Range': 'bytes=100-' } });"
+            "  window.qrcResult = [ full.status, await full.text(), !!etag, again.status,"
+            "                       range.status, await range.text(), outOfRange.status ].join('|');"
+            "})()"));
+    QTRY_COMPARE(evaluateJavaScriptSync(&page, QStringLiteral("window.qrcResult")).toString(),
+                 QStringLiteral("200|foo\n|true|304|206|ar|416"));
+}
+
 #if QT_CONFIG(webengine_webchannel)
 void tst_QWebEnginePage::restoreHistory()
 {
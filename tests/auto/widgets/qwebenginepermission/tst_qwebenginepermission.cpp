@@ -5,6 +5,7 @@
 
 #include <QtTest/QtTest>
 #include <QDir>
+#include <QJsonObject>
 #include <QStringLiteral>
 #include <QWebEngineDesktopMediaRequest>
 #include <QWebEngineFrame>
@@ -45,6 +46,7 @@ private Q_SLOTS:
     void queryPermission_data();
     void queryPermission();
     void listPermissions();
+    void exportImportPermissions();
 
     void clipboardReadWritePermissionInitialState_data();
     void clipboardReadWritePermissionInitialState();
@@ -564,6 +566,42 @@ void tst_QWebEnginePermission::listPermissions()
     QVERIFY(findInList(permissionsListAll, QUrl(QStringLiteral("https://www.google.com")), commonType, QWebEnginePermission::State::Granted));
 }
 
+void tst_QWebEnginePermission::exportImportPermissions()
+{
+    m_profile.reset(new QWebEngineProfile());
+    QVERIFY(m_profile->persistentPermissionsPolicy() == QWebEngineProfile::PersistentPermissionsPolicy::StoreInMemory);
+
+    const QUrl bing = QUrl(QStringLiteral("https://www.bing.com/maps"));
+    const QUrl google = QUrl(QStringLiteral("https://www.google.com/translate"));
+    m_profile->queryPermission(bing, QWebEnginePermission::PermissionType::Geolocation).deny();
+    m_profile->queryPermission(bing, QWebEnginePermission::PermissionType::Notifications).grant();
+    m_profile->queryPermission(google, QWebEnginePermission::PermissionType::Notifications).grant();
+
+    const QJsonObject exported = m_profile->exportPermissions();
+    QCOMPARE(exported.size(), 2);
+    QCOMPARE(exported.value("Notifications").toObject().size(), 2);
+    QCOMPARE(exported.value("Geolocation").toObject().size(), 1);
+
+    QWebEngineProfile otherProfile;
+    QJsonObject imported = exported;
+    // Invalid entries are skipped
+    imported.insert("Unsupported", QJsonObject{ { "https://www.qt.io/", true } });
+    imported.insert("MouseLock", QJsonObject{ { "https://www.qt.io/", true } });
+    imported.insert("LocalFontsAccess", QJsonObject{ { "https://www.qt.io/", 1 } });
+    QCOMPARE(otherProfile.importPermissions(imported), 3);
+
+    QCOMPARE(otherProfile.listAllPermissions().size(), 3);
+    QCOMPARE(otherProfile.queryPermission(bing, QWebEnginePermission::PermissionType::Geolocation).state(),
+             QWebEnginePermission::State::Denied);
+    QCOMPARE(otherProfile.queryPermission(google, QWebEnginePermission::PermissionType::Notifications).state(),
+             QWebEnginePermission::State::Granted);
+    QCOMPARE(otherProfile.exportPermissions(), exported);
+
+    otherProfile.setPersistentPermissionsPolicy(QWebEngineProfile::PersistentPermissionsPolicy::AskEveryTime);
+    QVERIFY(otherProfile.exportPermissions().isEmpty());
+    QCOMPARE(otherProfile.importPermissions(exported), 0);
+}
+
 static QString clipboardPermissionQuery(QString variableName, QString permissionName)
 {
     return QString("var %1; navigator.permissions.query({ name:'%2' }).then((p) => { %1 = p.state; "
@@ -14,6 +14,8 @@
 #include <QtWebEngineCore/qwebengineprofile.h>
 #include <QtWebEngineCore/qwebenginepage.h>
 #include <QtWebEngineCore/qwebenginedownloadrequest.h>
+#include <QtWebEngineCore/qwebenginefindtextresult.h>
+#include <QtWebEngineCore/qwebenginehistory.h>
 #include <QtWebEngineWidgets/qwebengineview.h>
 
 #if QT_CONFIG(webengine_webchannel)
@@ -24,6 +26,7 @@
 #include <httpreqrep.h>
 
 #include <map>
+#include <memory>
 #include <mutex>
 
 using namespace Qt::StringLiterals;
@@ -39,6 +42,10 @@ private Q_SLOTS:
     void userDefinedProfile();
     void clearDataFromCache();
     void disableCache();
+    void httpCacheEntries();
+    void importHttpCache();
+    void sharedHttpCache();
+    void importVisitedLinks();
     void urlSchemeHandlers();
     void urlSchemeHandlerFailRequest();
     void urlSchemeHandlerFailOnRead();
@@ -58,6 +65,9 @@ private Q_SLOTS:
     void changePersistentCookiesPolicy();
     void initiator();
     void badDeleteOrder();
+    void pagePool();
+    void findTextInPages();
+    void networkWarmup();
     void qtbug_71895(); // this should be the last test
 };
 
@@ -163,6 +173,10 @@ private:
         const QDir resourceDir(QDir(QT_TESTCASE_SOURCEDIR).canonicalPath() + "/resources");
         QString path = rr->requestPath();
         path.remove(0, 1);
+        // Resources can be loaded from other URLs, with a cross-origin resource policy.
+        const bool corp = path.startsWith("corp/");
+        if (corp || path.startsWith("copy/"))
+            path.remove(0, 5);
 
         if (rr->requestMethod() != "GET" || !resourceDir.exists(path)) {
             rr->sendResponse(404);
@@ -179,6 +193,9 @@ private:
         if (!mime.inherits("text/html"))
             rr->setResponseHeader(QByteArrayLiteral("cache-control"),
                                   QByteArrayLiteral("public, max-age=31536000"));
+        if (corp)
+            rr->setResponseHeader(QByteArrayLiteral("cross-origin-resource-policy"),
+                                  QByteArrayLiteral("same-site"));
         rr->sendResponse();
     }
 };
@@ -247,6 +264,205 @@ void tst_QWebEngineProfile::disableCache()
     (void)server.stop();
 }
 
+void tst_QWebEngineProfile::httpCacheEntries()
+{
+    TestServer server;
+    QSignalSpy serverSpy(&server, &HttpServer::newRequest);
+    QVERIFY(server.start());
+
+    AutoDir cacheDir("./tst_QWebEngineProfile_httpCacheEntries");
+    const QUrl imageUrl = server.url("/hedgehog.png");
+
+    auto hasEntry = [&](QWebEngineProfile &profile, const QUrl &url) {
+        bool found = false;
+        bool listed = false;
+        profile.requestHttpCacheEntries([&](const QList<QWebEngineProfile::HttpCacheEntry> &result) {
+            for (const QWebEngineProfile::HttpCacheEntry &entry : result) {
+                if (entry.url == url) {
+                    found = entry.size > 0 && entry.lastModified.isValid();
+                    break;
+                }
+            }
+            listed = true;
+        });
+        return QTest::qWaitFor([&] { return listed; }) && found;
+    };
+
+    {
+        QWebEngineProfile profile(QStringLiteral("httpCacheEntries"));
+        profile.setCachePath(cacheDir.path());
+        profile.setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+
+        QWebEnginePage page(&profile);
+        QVERIFY(loadSync(&page, server.url("/hedgehog.html")));
+        // Wait for GET /favicon.ico
+        QTRY_COMPARE(serverSpy.size(), 3);
+
+        // The entry is written once the image has been used.
+        QTRY_VERIFY_WITH_TIMEOUT(hasEntry(profile, imageUrl), 10000);
+
+        // The cache is open, so removing by URL is left to the next time it is opened.
+        qsizetype removed = 0;
+        profile.removeHttpCacheEntriesWithPrefix(imageUrl.toString(),
+                                                 [&](qsizetype count) { removed = count; });
+        QTRY_COMPARE(removed, -1);
+        QVERIFY(hasEntry(profile, imageUrl));
+
+        // Removing by origin goes through the cache, and the image is loaded and cached again.
+        bool originRemoved = false;
+        profile.removeHttpCacheEntries({ server.url() }, QDateTime(), [&] { originRemoved = true; });
+        QTRY_VERIFY(originRemoved);
+        QVERIFY(!hasEntry(profile, imageUrl));
+        const qsizetype requestCount = serverSpy.size();
+        page.triggerAction(QWebEnginePage::Reload);
+        QTRY_VERIFY(serverSpy.size() > requestCount + 1);
+        QTRY_VERIFY_WITH_TIMEOUT(hasEntry(profile, imageUrl), 10000);
+    }
+
+    QWebEngineProfile profile(QStringLiteral("httpCacheEntriesReopened"));
+    profile.setCachePath(cacheDir.path());
+    profile.setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+    QVERIFY(hasEntry(profile, imageUrl));
+
+    // Before the cache is opened, entries are removed right away when it is.
+    qsizetype removed = -2;
+    profile.removeHttpCacheEntriesWithPrefix(server.url("/nothing").toString(),
+                                             [&](qsizetype count) { removed = count; });
+    QWebEnginePage page(&profile);
+    QVERIFY(loadSync(&page, QUrl("about:blank")));
+    QTRY_COMPARE(removed, 0);
+    // The removal recorded while the cache was open has been carried out as well.
+    QVERIFY(!hasEntry(profile, imageUrl));
+
+    (void)server.stop();
+}
+
+void tst_QWebEngineProfile::importHttpCache()
+{
+    TestServer server;
+    QVERIFY(server.start());
+    const QUrl imageUrl = server.url("/hedgehog.png");
+
+    AutoDir snapshotDir("./tst_QWebEngineProfile_importHttpCache_snapshot");
+    AutoDir cacheDir("./tst_QWebEngineProfile_importHttpCache");
+
+    auto hasEntry = [&](QWebEngineProfile &profile, const QUrl &url) {
+        bool found = false;
+        bool listed = false;
+        profile.requestHttpCacheEntries([&](const QList<QWebEngineProfile::HttpCacheEntry> &result) {
+            for (const QWebEngineProfile::HttpCacheEntry &entry : result)
+                found |= entry.url == url;
+            listed = true;
+        });
+        return QTest::qWaitFor([&] { return listed; }) && found;
+    };
+
+    {
+        QWebEngineProfile profile(QStringLiteral("importHttpCacheSnapshot"));
+        profile.setCachePath(snapshotDir.path());
+        profile.setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+        QWebEnginePage page(&profile);
+        QVERIFY(loadSync(&page, server.url("/hedgehog.html")));
+        QTRY_VERIFY_WITH_TIMEOUT(hasEntry(profile, imageUrl), 10000);
+    }
+
+    QWebEngineProfile profile(QStringLiteral("importHttpCache"));
+    profile.setCachePath(cacheDir.path());
+    profile.setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+    QVERIFY(!hasEntry(profile, imageUrl));
+
+    int imported = -1;
+    profile.importHttpCache(cacheDir.filePath("missing"), [&](bool ok) { imported = ok; });
+    QTRY_COMPARE(imported, 0);
+    profile.importHttpCache(snapshotDir.path(), [&](bool ok) { imported = ok; });
+    QTRY_COMPARE(imported, 1);
+
+    // The cache is replaced when the first page opens it.
+    QWebEnginePage page(&profile);
+    QVERIFY(loadSync(&page, QUrl("about:blank")));
+    QTRY_VERIFY(hasEntry(profile, imageUrl));
+
+    (void)server.stop();
+}
+
+void tst_QWebEngineProfile::sharedHttpCache()
+{
+    TestServer server;
+    int imageRequests = 0;
+    QHash<QByteArray, int> requests;
+    connect(&server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/hedgehog.png")
+            ++imageRequests;
+        ++requests[rr->requestPath()];
+    });
+    QVERIFY(server.start());
+
+    AutoDir sharedDir("./tst_QWebEngineProfile_sharedHttpCache");
+
+    QWebEngineProfile first(QStringLiteral("sharedHttpCacheFirst"));
+    QWebEngineProfile second(QStringLiteral("sharedHttpCacheSecond"));
+    for (QWebEngineProfile *profile : { &first, &second }) {
+        profile->setHttpCacheType(QWebEngineProfile::MemoryHttpCache);
+        QVERIFY(profile->sharedHttpCachePath().isEmpty());
+        profile->setSharedHttpCachePath(sharedDir.path());
+    }
+    QCOMPARE(first.sharedHttpCachePath(), second.sharedHttpCachePath());
+
+    QWebEnginePage firstPage(&first);
+    QVERIFY(loadSync(&firstPage, server.url("/hedgehog.html")));
+    QTRY_VERIFY(imageRequests > 0);
+    // The image is stored as the page loads it, without loading it again.
+    QTRY_VERIFY(!QDir(sharedDir.filePath("index")).isEmpty());
+    QCOMPARE(imageRequests, 1);
+    const int requestsBefore = imageRequests;
+
+    // The second profile has an empty cache of its own, but gets the image from the shared one.
+    QWebEnginePage secondPage(&second);
+    QVERIFY(loadSync(&secondPage, server.url("/hedgehog.html")));
+    QTRY_COMPARE_GT(evaluateJavaScriptSync(&secondPage, "document.images[0].naturalWidth").toInt(), 0);
+    QCOMPARE(imageRequests, requestsBefore);
+
+    // A reload that bypasses caches goes to the network.
+    secondPage.triggerAction(QWebEnginePage::ReloadAndBypassCache);
+    QTRY_COMPARE(imageRequests, requestsBefore + 1);
+
+    // Responses with a cross-origin resource policy are not stored, the network service has to
+    // check it against the page loading them.
+    QSignalSpy loadSpy(&firstPage, &QWebEnginePage::loadFinished);
+    firstPage.setHtml(QStringLiteral("<img src='/corp/hedgehog.png'><img src='/copy/hedgehog.png'>"),
+                      server.url("/"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QTRY_COMPARE(QDir(sharedDir.filePath("index")).entryList(QDir::Files).size(), 2);
+    QCOMPARE(requests.value("/copy/hedgehog.png"), 1);
+    QCOMPARE(requests.value("/corp/hedgehog.png"), 1);
+
+    second.setSharedHttpCachePath(QString());
+    QVERIFY(second.sharedHttpCachePath().isEmpty());
+    (void)server.stop();
+}
+
+void tst_QWebEngineProfile::importVisitedLinks()
+{
+    QWebEngineProfile profile;
+    QList<QUrl> urls;
+    for (int i = 0; i < 250000; ++i)
+        urls.append(QUrl(QStringLiteral("https://www.example.com/page/") + QString::number(i)));
+    const QUrl notVisited(QStringLiteral("https://www.example.org/"));
+
+    bool imported = false;
+    profile.importVisitedLinks(urls, [&imported]() { imported = true; });
+    QTRY_VERIFY(imported);
+
+    QVERIFY(profile.visitedLinksContainsUrl(urls.first()));
+    QVERIFY(profile.visitedLinksContainsUrl(urls.last()));
+    QCOMPARE(profile.visitedLinksContainUrls({ urls.at(1000), notVisited, urls.at(200000) }),
+             QList<bool>({ true, false, true }));
+
+    profile.clearVisitedLinks({ urls.at(1000) });
+    QCOMPARE(profile.visitedLinksContainUrls({ urls.at(1000), urls.at(1001) }),
+             QList<bool>({ false, true }));
+}
+
 class RedirectingUrlSchemeHandler : public QWebEngineUrlSchemeHandler
 {
 public:
@@ -1029,6 +1245,169 @@ void tst_QWebEngineProfile::badDeleteOrder()
     delete view;
 }
 
+void tst_QWebEngineProfile::pagePool()
+{
+    TestServer server;
+    QVERIFY(server.start());
+    const QUrl url = server.url("/hedgehog.html");
+
+    QWebEngineProfile profile;
+    QCOMPARE(profile.pagePoolCapacity(), 0);
+    profile.setPagePoolCapacity(2);
+    QCOMPARE(profile.pagePoolCapacity(), 2);
+
+    auto page = std::make_unique<QWebEnginePage>(&profile);
+    QSignalSpy loadFinishedSpy(page.get(), &QWebEnginePage::loadFinished);
+    page->setHtml(QStringLiteral("<html><head><title>first</title></head></html>"));
+    QTRY_COMPARE(loadFinishedSpy.size(), 1);
+    page->setHtml(QStringLiteral("<html><head><title>second</title></head></html>"));
+    QTRY_COMPARE(loadFinishedSpy.size(), 2);
+    page->load(url);
+    QTRY_COMPARE(loadFinishedSpy.size(), 3);
+    QCOMPARE(page->history()->count(), 3);
+    QCOMPARE(evaluateJavaScriptSync(page.get(), "sessionStorage.setItem('key', 'value'); "
+                                                "sessionStorage.getItem('key')"),
+             QVariant(QStringLiteral("value")));
+    page->setZoomFactor(2.0);
+    QTRY_COMPARE(page->zoomFactor(), 2.0);
+    page.reset();
+
+    QWebEngineProfile::PagePoolStatistics statistics = profile.pagePoolStatistics();
+    QCOMPARE(statistics.createdPages, 1u);
+    QCOMPARE(statistics.reusedPages, 0u);
+    QCOMPARE(statistics.recycledPages, 1u);
+    QCOMPARE(statistics.discardedPages, 0u);
+
+    // The pooled page can be taken over once it has unloaded its document
+    QTRY_COMPARE(profile.pagePoolStatistics().availablePages, 1u);
+
+    page = std::make_unique<QWebEnginePage>(&profile);
+    QSignalSpy loadFinishedSpy2(page.get(), &QWebEnginePage::loadFinished);
+    page->load(url);
+    QTRY_COMPARE(loadFinishedSpy2.size(), 1);
+
+    statistics = profile.pagePoolStatistics();
+    QCOMPARE(statistics.createdPages, 1u);
+    QCOMPARE(statistics.reusedPages, 1u);
+    QCOMPARE(statistics.availablePages, 0u);
+    // Nothing of the previous page is visible in the new one
+    for (const QWebEngineHistoryItem &item : page->history()->items())
+        QVERIFY(item.title() != QStringLiteral("first") && item.title() != QStringLiteral("second"));
+    QCOMPARE(evaluateJavaScriptSync(page.get(), "sessionStorage.getItem('key')"), QVariant());
+    QCOMPARE(evaluateJavaScriptSync(page.get(), "sessionStorage.length").toInt(), 0);
+    QCOMPARE(page->zoomFactor(), 1.0);
+    page.reset();
+
+    profile.setPagePoolCapacity(0);
+    QCOMPARE(profile.pagePoolCapacity(), 0);
+    QCOMPARE(profile.pagePoolStatistics().recycledPages, 0u);
+}
+
+void tst_QWebEngineProfile::findTextInPages()
+{
+    QWebEngineProfile profile;
+    const QStringList contents = { QStringLiteral("foo bar"), QStringLiteral("bar"),
+                                   QStringLiteral("foo foo foo") };
+    std::vector<std::unique_ptr<QWebEngineView>> views;
+    for (const QString &content : contents) {
+        auto view = std::make_unique<QWebEngineView>(&profile);
+        QSignalSpy loadFinishedSpy(view.get(), &QWebEngineView::loadFinished);
+        // findText will abort in blink if the view has an empty size.
+        view->resize(400, 300);
+        view->show();
+        view->setHtml(QStringLiteral("<html><body>%1</body></html>").arg(content));
+        QTRY_COMPARE(loadFinishedSpy.size(), 1);
+        views.push_back(std::move(view));
+    }
+
+    QMap<QWebEnginePage *, int> matches;
+    QCOMPARE(profile.findTextInPages(QStringLiteral("FOO"), Qt::CaseInsensitive,
+                                     [&matches](QWebEnginePage *page,
+                                                const QWebEngineFindTextResult &result) {
+                                         matches.insert(page, result.numberOfMatches());
+                                     }),
+             3);
+    QTRY_COMPARE(matches.size(), 3);
+    QCOMPARE(matches.value(views[0]->page()), 1);
+    QCOMPARE(matches.value(views[1]->page()), 0);
+    QCOMPARE(matches.value(views[2]->page()), 3);
+
+    matches.clear();
+    QCOMPARE(profile.findTextInPages(QStringLiteral("FOO"), Qt::CaseSensitive,
+                                     [&matches](QWebEnginePage *page,
+                                                const QWebEngineFindTextResult &result) {
+                                         matches.insert(page, result.numberOfMatches());
+                                     }),
+             3);
+    QTRY_COMPARE(matches.size(), 3);
+    for (int count : std::as_const(matches))
+        QCOMPARE(count, 0);
+}
+
+class BlockingInterceptor : public QWebEngineUrlRequestInterceptor
+{
+public:
+    void interceptRequest(QWebEngineUrlRequestInfo &info) override
+    {
+        if (info.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePrefetch)
+            prefetchUrls.append(info.requestUrl());
+        if (info.requestUrl().host() == QStringLiteral("blocked.invalid"))
+            info.block(true);
+    }
+    QList<QUrl> prefetchUrls;
+};
+
+void tst_QWebEngineProfile::networkWarmup()
+{
+    HttpServer server;
+    QAtomicInt requests;
+    connect(&server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() != "/cached.html") {
+            rr->sendResponse(404);
+            return;
+        }
+        ++requests;
+        rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("text/html"));
+        rr->setResponseHeader(QByteArrayLiteral("cache-control"), QByteArrayLiteral("max-age=3600"));
+        rr->setResponseBody(QByteArrayLiteral("<html><head><title>cached</title></head></html>"));
+        rr->sendResponse();
+    });
+    QVERIFY(server.start());
+
+    QWebEngineProfile profile;
+    BlockingInterceptor interceptor;
+    profile.setUrlRequestInterceptor(&interceptor);
+    QCOMPARE(profile.networkWarmupStatistics().prefetches, 0u);
+
+    profile.preconnect(QUrl(QStringLiteral("https://blocked.invalid/some/path")));
+    profile.prefetchDns({ QStringLiteral("blocked.invalid") });
+    QWebEngineProfile::NetworkWarmupStatistics statistics = profile.networkWarmupStatistics();
+    QCOMPARE(statistics.blockedWarmups, 2u);
+    QCOMPARE(statistics.preconnects, 0u);
+    QCOMPARE(statistics.dnsPrefetches, 0u);
+
+    const QUrl url = server.url(QStringLiteral("/cached.html"));
+    profile.prefetch({ url });
+    QTRY_COMPARE(requests.loadRelaxed(), 1);
+    QVERIFY(interceptor.prefetchUrls.contains(url));
+    QCOMPARE(profile.networkWarmupStatistics().prefetches, 1u);
+    // Give the prefetch time to finish writing the response to the cache
+    QTest::qWait(500);
+    QCOMPARE(profile.networkWarmupStatistics().prefetchFailures, 0u);
+
+    // The navigation is served from the cache filled by the prefetch.
+    QWebEnginePage page(&profile);
+    QVERIFY(loadSync(&page, url));
+    QCOMPARE(page.title(), QStringLiteral("cached"));
+    QCOMPARE(requests.loadRelaxed(), 1);
+    statistics = profile.networkWarmupStatistics();
+    QCOMPARE(statistics.prefetchHits, 1u);
+    QVERIFY(statistics.prefetchTimeSaved.count() > 0);
+
+    profile.setUrlRequestInterceptor(nullptr);
+    QVERIFY(server.stop());
+}
+
 void tst_QWebEngineProfile::qtbug_71895()
 {
     QWebEngineView view;
@@ -9,6 +9,7 @@
 #include <QtWebEngineCore/qwebengineprofilebuilder.h>
 #include <QtWebEngineCore/qwebenginecertificateerror.h>
 #include <QtWebEngineCore/qwebengineclientcertificatestore.h>
+#include <QtWebEngineCore/qwebenginepage.h>
 #include <QtWebEngineCore/qwebenginesettings.h>
 
 class tst_QWebEngineProfileBuilder : public QObject
@@ -29,6 +30,7 @@ private Q_SLOTS:
     void persistentPermissionsPolicy();
     void additionalTrustedCertificates();
     void useSameDataPathForProfiles();
+    void createProfileAsync();
 };
 
 static QString StandardCacheLocation()
@@ -391,5 +393,71 @@ void tst_QWebEngineProfileBuilder::useSameDataPathForProfiles()
     QVERIFY(secondProfile.isNull());
 }
 
+void tst_QWebEngineProfileBuilder::createProfileAsync()
+{
+    QTemporaryDir tempDir(QDir::tempPath() + "/tst_QWebEngineProfileBuilder-XXXXXX");
+
+    std::vector<std::unique_ptr<QWebEngineProfile>> profiles;
+    std::vector<std::unique_ptr<QSignalSpy>> readySpies;
+    for (int i = 0; i < 3; ++i) {
+        QWebEngineProfileBuilder profileBuilder;
+        profileBuilder.setPersistentStoragePath(tempDir.path() + u'/' + QString::number(i));
+        profiles.emplace_back(profileBuilder.createProfileAsync(QStringLiteral("Test") + QString::number(i)));
+        QVERIFY(profiles.back());
+        readySpies.emplace_back(new QSignalSpy(profiles.back().get(), &QWebEngineProfile::ready));
+        QVERIFY(!profiles.back()->isReady());
+    }
+
+    // Settings made while loading are not replaced by the stored ones.
+    const QStringList languages{ QStringLiteral("en-US"), QStringLiteral("de-DE") };
+    profiles[0]->setSpellCheckLanguages(languages);
+    QCOMPARE(profiles[0]->spellCheckLanguages(), languages);
+
+    for (int i = 0; i < 3; ++i) {
+        QTRY_COMPARE(readySpies[i]->size(), 1);
+        QVERIFY(profiles[i]->isReady());
+    }
+    QCOMPARE(profiles[0]->spellCheckLanguages(), languages);
+    QVERIFY(profiles[1]->spellCheckLanguages().isEmpty());
+
+    for (auto &profile : profiles) {
+        QWebEnginePage page(profile.get());
+        QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+        page.setHtml(QStringLiteral("<p>ready</p>"));
+        QTRY_COMPARE(loadSpy.size(), 1);
+        QCOMPARE(toPlainTextSync(&page), QStringLiteral("ready"));
+    }
+
+    for (const auto &spy : readySpies)
+        QCOMPARE(spy->size(), 1);
+
+    // A page used before its profile is ready makes its last load once the profile is.
+    QWebEngineProfileBuilder earlyBuilder;
+    earlyBuilder.setPersistentStoragePath(tempDir.path() + QStringLiteral("/early"));
+    std::unique_ptr<QWebEngineProfile> early(earlyBuilder.createProfileAsync(QStringLiteral("Early")));
+    QSignalSpy earlyReadySpy(early.get(), &QWebEngineProfile::ready);
+    QVERIFY(!early->isReady());
+    QVERIFY(!early->extensionManager());
+    {
+        QWebEnginePage page(early.get());
+        QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+        page.setHtml(QStringLiteral("<p>replaced</p>"));
+        page.setHtml(QStringLiteral("<p>early</p>"));
+        QVERIFY(!early->isReady());
+        QCOMPARE(loadSpy.size(), 0);
+        QTRY_COMPARE(earlyReadySpy.size(), 1);
+        QTRY_COMPARE(loadSpy.size(), 1);
+        QVERIFY(loadSpy.at(0).at(0).toBool());
+        QCOMPARE(toPlainTextSync(&page), QStringLiteral("early"));
+    }
+    QCOMPARE(earlyReadySpy.size(), 1);
+
+    // Off-the-record profiles have nothing to load.
+    QWebEngineProfileBuilder profileBuilder;
+    QScopedPointer<QWebEngineProfile> offTheRecord(profileBuilder.createProfileAsync(QString()));
+    QVERIFY(offTheRecord->isOffTheRecord());
+    QVERIFY(offTheRecord->isReady());
+}
+
 QTEST_MAIN(tst_QWebEngineProfileBuilder)
 #include "tst_qwebengineprofilebuilder.moc"
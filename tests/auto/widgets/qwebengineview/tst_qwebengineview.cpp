@@ -190,6 +190,9 @@ private Q_SLOTS:
     void pageWithPaintListeners();
     void deferredDelete();
     void setCursorOnEmbeddedView();
+    void smoothScrollMetrics();
+    void inputLatencyStatistics();
+    void inputResampling();
 };
 
 // This will be called before the first test function is executed.
@@ -4118,5 +4121,132 @@ void tst_QWebEngineView::setCursorOnEmbeddedView()
     QTRY_COMPARE(view.cursor().shape(), Qt::PointingHandCursor);
 }
 
+void tst_QWebEngineView::smoothScrollMetrics()
+{
+    QWebEngineView view;
+    view.resize(300, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy loadSpy(view.page(), &QWebEnginePage::loadFinished);
+    view.setHtml(QStringLiteral("<html><body style='height:5000px'></body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    view.page()->smoothScrollBy(0, 600, 0.3);
+    QTRY_VERIFY(view.page()->smoothScrollMetrics().value(QStringLiteral("scrolling")).toBool() == false
+                && view.page()->smoothScrollMetrics().value(QStringLiteral("frames")).toInt() > 0);
+    QTRY_VERIFY(view.page()->scrollPosition().y() > 0);
+
+    // The scroll is animated over several frames, at most one step per frame.
+    const QVariantMap metrics = view.page()->smoothScrollMetrics();
+    const int frames = metrics.value(QStringLiteral("frames")).toInt();
+    QVERIFY(frames > 1);
+    QVERIFY(metrics.value(QStringLiteral("zeroDeltaFrames")).toInt() < frames);
+    QVERIFY(metrics.value(QStringLiteral("multiStepFrames")).toInt() < frames);
+}
+
+void tst_QWebEngineView::inputLatencyStatistics()
+{
+    QWebEngineView view;
+    view.resize(300, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy loadSpy(view.page(), &QWebEnginePage::loadFinished);
+    view.setHtml(QStringLiteral("<html><body><input id='input' autofocus></body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QTRY_COMPARE(evaluateJavaScriptSync(view.page(), "document.activeElement.id").toString(),
+                 QStringLiteral("input"));
+
+    auto keyboardStage = [&view](const char *stage) {
+        return view.page()->inputLatencyStatistics()
+                .value(QStringLiteral("keyboard")).toMap()
+                .value(QLatin1StringView(stage)).toMap();
+    };
+
+    // Typing changes the page, so the keys are followed by a new frame.
+    QTest::keyClicks(view.focusProxy(), QStringLiteral("abc"));
+    QTRY_COMPARE(evaluateJavaScriptSync(view.page(), "input.value").toString(), QStringLiteral("abc"));
+    QTRY_VERIFY(keyboardStage("presentation").value(QStringLiteral("count")).toInt() > 0);
+
+    const QVariantMap dispatch = keyboardStage("dispatch");
+    const QVariantMap ack = keyboardStage("rendererAck");
+    QVERIFY(ack.value(QStringLiteral("count")).toInt() > 0);
+    QVERIFY(ack.value(QStringLiteral("meanMs")).toDouble() >= dispatch.value(QStringLiteral("meanMs")).toDouble());
+    const QVariantList buckets = ack.value(QStringLiteral("buckets")).toList();
+    QCOMPARE(buckets.size(),
+             view.page()->inputLatencyStatistics().value(QStringLiteral("bucketLimitsMs")).toList().size() + 1);
+
+    view.page()->resetInputLatencyStatistics();
+    QCOMPARE(keyboardStage("rendererAck").value(QStringLiteral("count")).toInt(), 0);
+
+    // Touch events carry the time of the Qt event rather than the time they were converted,
+    // each of them still has to be matched up with its own acknowledgement.
+    evaluateJavaScriptSync(view.page(),
+                           "for (const type of ['touchstart', 'touchmove', 'touchend'])"
+                           "    document.addEventListener(type, () => {}, { passive: false });");
+    QScopedPointer<QPointingDevice> touchDevice(QTest::createTouchDevice());
+    QWidget *target = view.focusProxy();
+    const QPoint start(100, 100), end(150, 150);
+    QTest::touchEvent(target, touchDevice.get()).press(1, start, target);
+    QTest::touchEvent(target, touchDevice.get()).move(1, end, target);
+    QTest::touchEvent(target, touchDevice.get()).release(1, end, target);
+    QTRY_COMPARE(view.page()->inputLatencyStatistics()
+                         .value(QStringLiteral("touch")).toMap()
+                         .value(QStringLiteral("rendererAck")).toMap()
+                         .value(QStringLiteral("count")).toInt(),
+                 3);
+}
+
+void tst_QWebEngineView::inputResampling()
+{
+    QWebEngineView view;
+    view.page()->settings()->setAttribute(QWebEngineSettings::InputResamplingEnabled, true);
+    view.resize(300, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy loadSpy(view.page(), &QWebEnginePage::loadFinished);
+    view.setHtml(QStringLiteral("<html><body style='margin:0'><script>"
+                                "var moves = 0; var lastX = 0;"
+                                "document.onmousemove = (e) => { ++moves; lastX = e.clientX; };"
+                                "</script></body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    QWidget *target = view.focusProxy();
+    for (int x = 10; x <= 100; x += 10)
+        QTest::mouseMove(target, QPoint(x, 50));
+
+    auto mouseCounter = [&view](const char *counter) {
+        return view.page()->inputResamplingStatistics()
+                .value(QStringLiteral("mouse")).toMap()
+                .value(QLatin1StringView(counter)).toULongLong();
+    };
+    QTRY_VERIFY(mouseCounter("received") >= 10);
+    QTRY_COMPARE(mouseCounter("delivered") + mouseCounter("coalesced"), mouseCounter("received"));
+    QTRY_VERIFY(evaluateJavaScriptSync(view.page(), "moves").toInt() > 0);
+    // The page may see extrapolated positions while the mouse moves, but once it rests, the
+    // real position is delivered.
+    QTRY_COMPARE(evaluateJavaScriptSync(view.page(), "lastX").toInt(), 100);
+    QVERIFY(mouseCounter("corrected") <= mouseCounter("predicted"));
+
+    // Clicks are never held back.
+    QTest::mouseClick(target, Qt::LeftButton, {}, QPoint(100, 50));
+
+    // Other input delivers the pending move first.
+    evaluateJavaScriptSync(view.page(),
+                           "var keyX = []; document.onkeydown = () => keyX.push(lastX);");
+    QTest::mouseMove(target, QPoint(200, 50));
+    QTest::keyClick(target, Qt::Key_A);
+    QTRY_COMPARE(evaluateJavaScriptSync(view.page(), "keyX.length").toInt(), 1);
+    QCOMPARE(evaluateJavaScriptSync(view.page(), "keyX[0]").toInt(), 200);
+
+    view.page()->settings()->setAttribute(QWebEngineSettings::InputResamplingEnabled, false);
+    const quint64 received = mouseCounter("received");
+    QTest::mouseMove(target, QPoint(120, 50));
+    QTRY_COMPARE(evaluateJavaScriptSync(view.page(), "lastX").toInt(), 120);
+    QCOMPARE(mouseCounter("received"), received);
+}
+
 QTEST_MAIN(tst_QWebEngineView)
 #include "tst_qwebengineview.moc"
@@ -3,6 +3,8 @@
 
 #include <util.h>
 #include <QtTest/QtTest>
+#include <QtCore/qprocess.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtWebEngineCore/qwebenginecontextmenurequest.h>
 #include <QtWebEngineCore/qwebenginepage.h>
 #include <QtWebEngineCore/qwebengineprofile.h>
@@ -46,6 +48,7 @@ private Q_SLOTS:
     void settings();
     void spellcheck();
     void spellcheck_data();
+    void convertDictTool();
 
 private:
     void load();
@@ -214,5 +217,55 @@ void tst_Spellchecking::spellcheck_data()
     QTest::newRow("en-US,de-DE") << QStringList({"en-US", "de-DE"}) << QStringList({"löwe", "low", "love"});
 }
 
+static bool runConvertDict(const QStringList &arguments, QString *output = nullptr)
+{
+    QProcess process;
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.start(QStringLiteral(CONVERT_DICT_TOOL), arguments);
+    if (!process.waitForFinished(60000))
+        return false;
+    if (output)
+        *output = QString::fromLocal8Bit(process.readAll());
+    return process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0;
+}
+
+void tst_Spellchecking::convertDictTool()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QDir dictDir(QStringLiteral(DICT_DIR));
+    const QString enUS = dictDir.filePath("en-US.dic");
+    const QString deDE = dictDir.filePath("de-DE.dic");
+
+    // Two files are converted one to the other, even with the batch options
+    const QString single = tempDir.filePath("single.bdic");
+    QString output;
+    QVERIFY(runConvertDict({ "--incremental", "--jobs", "2", enUS, single }, &output));
+    QVERIFY2(QFileInfo(single).isFile(), qPrintable(output));
+    QVERIFY(runConvertDict({ "--incremental", enUS, single }, &output));
+    QVERIFY2(output.contains("is up to date"), qPrintable(output));
+    QVERIFY(runConvertDict({ enUS, single }, &output));
+    QVERIFY2(!output.contains("is up to date"), qPrintable(output));
+
+    // An existing directory as the last argument converts into it
+    const QDir outDir(tempDir.filePath("existing"));
+    QVERIFY(QDir().mkpath(outDir.path()));
+    QVERIFY(runConvertDict({ enUS, outDir.path() }, &output));
+    QVERIFY2(QFileInfo(outDir.filePath("en-US.bdic")).isFile(), qPrintable(output));
+
+    // More than two files convert into a new directory, one dictionary per job
+    const QDir batchDir(tempDir.filePath("batch"));
+    QVERIFY(runConvertDict({ "--jobs", "2", enUS, deDE, batchDir.path() }, &output));
+    QVERIFY2(QFileInfo(batchDir.filePath("en-US.bdic")).isFile(), qPrintable(output));
+    QVERIFY2(QFileInfo(batchDir.filePath("de-DE.bdic")).isFile(), qPrintable(output));
+    QCOMPARE(QFile(batchDir.filePath("en-US.bdic")).size(), QFile(single).size());
+
+    QVERIFY(runConvertDict({ "--incremental", enUS, deDE, batchDir.path() }, &output));
+    QCOMPARE(output.count("is up to date"), 2);
+
+    QVERIFY(!runConvertDict({ "--jobs", "0", enUS, single }));
+    QVERIFY(!runConvertDict({ tempDir.filePath("missing.dic"), single }));
+}
+
 QTEST_MAIN(tst_Spellchecking)
 #include "tst_spellchecking.moc"
@@ -0,0 +1,96 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <qtest.h>
+#include <widgetutil.h>
+
+#include <QEventLoop>
+#include <QScopeGuard>
+
+#include <qaccessible.h>
+#include <qwebengineview.h>
+#include <qwebenginepage.h>
+
+class tst_Bench_Accessibility : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tableValueChanges();
+};
+
+static QAccessible::UpdateHandler s_previousUpdateHandler = nullptr;
+static int s_valueChangeEvents = 0;
+static QEventLoop *s_sentinelLoop = nullptr;
+
+static void countingUpdateHandler(QAccessibleEvent *event)
+{
+    if (event->type() == QAccessible::ValueChanged) {
+        ++s_valueChangeEvents;
+        QAccessibleInterface *iface = event->accessibleInterface();
+        if (s_sentinelLoop && iface && iface->text(QAccessible::Name) == QLatin1String("sentinel"))
+            s_sentinelLoop->quit();
+    }
+    if (s_previousUpdateHandler)
+        s_previousUpdateHandler(event);
+}
+
+// Measures how long the value changes of all the sliders of a large table take to be delivered.
+// Only the visible rows have interfaces, events for the off-screen ones must not create theirs.
+void tst_Bench_Accessibility::tableValueChanges()
+{
+    const int rowCount = 10000;
+    QWebEngineView webView;
+    webView.resize(400, 400);
+    webView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&webView));
+
+    QSignalSpy spyFinished(&webView, &QWebEngineView::loadFinished);
+    webView.setHtml(QLatin1String(
+            "<html><body><input id='sentinel' type='range' aria-label='sentinel'>"
+            "<table id='table'></table><script>"
+            "  var table = document.getElementById('table');"
+            "  for (var i = 0; i < %1; ++i) {"
+            "    var row = table.insertRow();"
+            "    row.insertCell().textContent = 'Row ' + i;"
+            "    var slider = document.createElement('input');"
+            "    slider.type = 'range';"
+            "    row.insertCell().appendChild(slider);"
+            "  }"
+            "  function updateAll(value) {"
+            "    var sliders = document.getElementsByTagName('input');"
+            "    for (var i = 1; i < sliders.length; ++i)"
+            "      sliders[i].value = value;"
+            "    sliders[0].value = value;"
+            "  }"
+            "</script></body></html>").arg(rowCount));
+    QTRY_COMPARE_WITH_TIMEOUT(spyFinished.size(), 1, 20000);
+
+    QAccessibleInterface *view = QAccessible::queryAccessibleInterface(&webView);
+    QTRY_VERIFY_WITH_TIMEOUT(view->child(0)->childCount() > 0, 20000);
+
+    s_valueChangeEvents = 0;
+    s_previousUpdateHandler = QAccessible::installUpdateHandler(countingUpdateHandler);
+    auto restoreHandler = qScopeGuard([] {
+        QAccessible::installUpdateHandler(s_previousUpdateHandler);
+        s_previousUpdateHandler = nullptr;
+    });
+
+    int value = 0;
+    QBENCHMARK {
+        value = (value + 10) % 100;
+        // The sentinel is updated last, in the same tree update as the rows.
+        QEventLoop loop;
+        s_sentinelLoop = &loop;
+        webView.page()->runJavaScript(QStringLiteral("updateAll(%1)").arg(value));
+        loop.exec();
+        s_sentinelLoop = nullptr;
+    }
+    qInfo("%d value change events delivered", s_valueChangeEvents);
+}
+
+static QByteArrayList params = QByteArrayList()
+    << "--force-renderer-accessibility";
+
+W_QTEST_MAIN(tst_Bench_Accessibility, params)
+#include "tst_bench_accessibility.moc"